@@ -0,0 +1,229 @@
+#include "AllocTracker.h"
+#include "Draw.h"
+#include "Log.h"
+#include <cinttypes>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <new>
+
+namespace {
+
+// Tag 0 collects everything allocated outside an ALLOC_SCOPE
+thread_local int currentTag = 0;
+thread_local bool onGameThread = false;
+
+const SDL_Color TAG_COLORS[] = {
+    {150, 150, 150, 255}, {255, 150, 50, 255}, {50, 200, 255, 255},
+    {255, 80, 120, 255},  {120, 255, 120, 255}, {200, 120, 255, 255},
+    {255, 230, 80, 255},  {80, 160, 255, 255},
+};
+
+} // namespace
+
+AllocTracker &AllocTracker::get() {
+  // Built in place on the first allocation; the constructor must not allocate
+  static AllocTracker instance;
+  return instance;
+}
+
+AllocTracker::AllocTracker()
+    : tagCount(2), gameThreadMarked(false), totalFrees(0), intervalFrames(0),
+      logging(true), overlayVisible(true) {
+  tagNames.fill(nullptr);
+  tagNames[0] = "untagged";
+  tagNames[OTHER_THREADS_TAG] = "otherThreads";
+  for (int i = 0; i < MAX_TAGS; i++) {
+    totalAllocs[i].store(0, std::memory_order_relaxed);
+    totalBytes[i].store(0, std::memory_order_relaxed);
+  }
+}
+
+int AllocTracker::registerTag(const char *name) {
+  std::lock_guard<std::mutex> lock(registryMutex);
+
+  int count = tagCount.load(std::memory_order_relaxed);
+  for (int i = 0; i < count; i++) {
+    if (std::strcmp(tagNames[i], name) == 0)
+      return i;
+  }
+
+  // Out of slots: fold into "untagged" rather than fail
+  if (count == MAX_TAGS)
+    return 0;
+
+  tagNames[count] = name;
+  tagCount.store(count + 1, std::memory_order_release);
+  return count;
+}
+
+int AllocTracker::exchangeTag(int tag) {
+  int previous = currentTag;
+  currentTag = tag;
+  return previous;
+}
+
+void AllocTracker::markGameThread() {
+  onGameThread = true;
+  gameThreadMarked.store(true, std::memory_order_release);
+}
+
+void AllocTracker::recordAlloc(size_t bytes) {
+  int tag = currentTag;
+  if (!onGameThread && gameThreadMarked.load(std::memory_order_acquire))
+    tag = OTHER_THREADS_TAG;
+  totalAllocs[tag].fetch_add(1, std::memory_order_relaxed);
+  totalBytes[tag].fetch_add(bytes, std::memory_order_relaxed);
+}
+
+void AllocTracker::recordFree() {
+  totalFrees.fetch_add(1, std::memory_order_relaxed);
+}
+
+void AllocTracker::endFrame() {
+  int count = getTagCount();
+  frameTotal = Counts();
+
+  for (int i = 0; i < count; i++) {
+    Counts now;
+    now.allocs = totalAllocs[i].load(std::memory_order_relaxed);
+    now.bytes = totalBytes[i].load(std::memory_order_relaxed);
+
+    frameCounts[i].allocs = now.allocs - lastTotals[i].allocs;
+    frameCounts[i].bytes = now.bytes - lastTotals[i].bytes;
+    lastTotals[i] = now;
+
+    if (i != OTHER_THREADS_TAG) {
+      frameTotal.allocs += frameCounts[i].allocs;
+      frameTotal.bytes += frameCounts[i].bytes;
+    }
+    intervalCounts[i].allocs += frameCounts[i].allocs;
+    intervalCounts[i].bytes += frameCounts[i].bytes;
+  }
+
+  if (++intervalFrames < LOG_INTERVAL)
+    return;
+
+  uint64_t intervalAllocs = 0;
+  for (int i = 0; i < count; i++) {
+    if (i != OTHER_THREADS_TAG)
+      intervalAllocs += intervalCounts[i].allocs;
+  }
+
+  // Other threads alone never trigger a line
+  if (logging && intervalAllocs > 0) {
+    LOG_INFO("alloc", "last %d frames: %" PRIu64 " allocs", intervalFrames,
+             intervalAllocs);
+    for (int i = 0; i < count; i++) {
+      if (intervalCounts[i].allocs == 0)
+        continue;
+      LOG_INFO("alloc", "  %s: %" PRIu64 " allocs, %" PRIu64 " bytes",
+               tagNames[i], intervalCounts[i].allocs, intervalCounts[i].bytes);
+    }
+  }
+
+  intervalCounts.fill(Counts());
+  intervalFrames = 0;
+}
+
+void AllocTracker::report(std::ostream &out) const {
+  int count = getTagCount();
+  out << "Allocations by tag (count, bytes):" << std::endl;
+  for (int i = 0; i < count; i++) {
+    uint64_t allocs = totalAllocs[i].load(std::memory_order_relaxed);
+    if (allocs == 0)
+      continue;
+    char line[128];
+    std::snprintf(line, sizeof(line), "  %-20s %12llu %14llu", tagNames[i],
+                  static_cast<unsigned long long>(allocs),
+                  static_cast<unsigned long long>(
+                      totalBytes[i].load(std::memory_order_relaxed)));
+    out << line << std::endl;
+  }
+  out << "  frees " << totalFrees.load(std::memory_order_relaxed)
+      << std::endl;
+}
+
+void AllocTracker::renderOverlay(SDL_Renderer *renderer, int x, int y) {
+  if (!overlayVisible)
+    return;
+
+  // One stacked bar of this frame's allocations, 4 px each, colored by tag
+  const int width = 240;
+  const int height = 10;
+  const int pixelsPerAlloc = 4;
+
+  Draw::setColor(renderer, 0, 0, 0, 160);
+  SDL_Rect bg = {x, y, width, height};
+  Draw::fillRect(renderer, &bg);
+
+  int cursor = 0;
+  int count = getTagCount();
+  const int colorCount = sizeof(TAG_COLORS) / sizeof(TAG_COLORS[0]);
+  for (int i = 0; i < count && cursor < width; i++) {
+    if (i == OTHER_THREADS_TAG)
+      continue;
+    int w = static_cast<int>(frameCounts[i].allocs) * pixelsPerAlloc;
+    if (w == 0)
+      continue;
+    if (cursor + w > width)
+      w = width - cursor;
+
+    const SDL_Color &c = TAG_COLORS[i % colorCount];
+    Draw::setColor(renderer, c.r, c.g, c.b, c.a);
+    SDL_Rect bar = {x + cursor, y, w, height};
+    Draw::fillRect(renderer, &bar);
+    cursor += w;
+  }
+
+  // Zero-allocation frames show a thin green line
+  if (frameTotal.allocs == 0) {
+    Draw::setColor(renderer, 50, 200, 100, 255);
+    Draw::drawLine(renderer, x, y + height / 2, x + width, y + height / 2);
+  }
+}
+
+#ifdef STELLAR_ALLOC_TRACK
+
+// Replacement global allocation functions. The aligned overloads are left
+// to the library; they pair with their own delete, so nothing mismatches.
+
+void *operator new(size_t size) {
+  void *p = std::malloc(size ? size : 1);
+  if (!p)
+    throw std::bad_alloc();
+  AllocTracker::get().recordAlloc(size);
+  return p;
+}
+
+void *operator new[](size_t size) { return operator new(size); }
+
+void *operator new(size_t size, const std::nothrow_t &) noexcept {
+  void *p = std::malloc(size ? size : 1);
+  if (p)
+    AllocTracker::get().recordAlloc(size);
+  return p;
+}
+
+void *operator new[](size_t size, const std::nothrow_t &tag) noexcept {
+  return operator new(size, tag);
+}
+
+void operator delete(void *p) noexcept {
+  if (!p)
+    return;
+  AllocTracker::get().recordFree();
+  std::free(p);
+}
+
+void operator delete[](void *p) noexcept { operator delete(p); }
+void operator delete(void *p, size_t) noexcept { operator delete(p); }
+void operator delete[](void *p, size_t) noexcept { operator delete(p); }
+void operator delete(void *p, const std::nothrow_t &) noexcept {
+  operator delete(p);
+}
+void operator delete[](void *p, const std::nothrow_t &) noexcept {
+  operator delete(p);
+}
+
+#endif
@@ -0,0 +1,127 @@
+#ifndef ALLOC_TRACKER_H
+#define ALLOC_TRACKER_H
+
+#include <SDL2/SDL.h>
+#include <array>
+#include <atomic>
+#include <cstdint>
+#include <mutex>
+#include <ostream>
+
+// Heap allocation tracker. Global operator new/delete are replaced only with
+// -DSTELLAR_ALLOC_TRACK (make ALLOC_TRACK=1); otherwise ALLOC_SCOPE and
+// ALLOC_FRAME expand to nothing and the default allocator is untouched.
+//
+//   ALLOC_SCOPE("particles");   // allocations until end of block count here
+//   ALLOC_FRAME();              // once per frame, closes the frame's counts
+//
+// Tags nest (the innermost wins) and are keyed by name, so several call
+// sites can share one. Names must be string literals.
+//
+// Once a thread calls markGameThread(), allocations on any other thread
+// (recorder workers, the score writer, the log writer) count under the
+// "otherThreads" tag, which is reported but left out of the frame total.
+
+class AllocTracker {
+public:
+  static constexpr int MAX_TAGS = 32;
+  static constexpr int LOG_INTERVAL = 60; // Frames between log lines
+  static constexpr int OTHER_THREADS_TAG = 1;
+
+  struct Counts {
+    uint64_t allocs = 0;
+    uint64_t bytes = 0;
+  };
+
+  static AllocTracker &get();
+
+  // True when built with STELLAR_ALLOC_TRACK
+  static constexpr bool isEnabled() {
+#ifdef STELLAR_ALLOC_TRACK
+    return true;
+#else
+    return false;
+#endif
+  }
+
+  // Returns the id for a tag name, registering it on first use
+  int registerTag(const char *name);
+
+  // Sets the calling thread's current tag, returning the previous one
+  static int exchangeTag(int tag);
+
+  // Makes the calling thread the one whose allocations the frame counts
+  void markGameThread();
+
+  // Called from the global operator new/delete
+  void recordAlloc(size_t bytes);
+  void recordFree();
+
+  // Closes the current frame; prints a log line every LOG_INTERVAL frames
+  // that allocated
+  void endFrame();
+
+  int getTagCount() const { return tagCount.load(std::memory_order_acquire); }
+  const char *getTagName(int tag) const { return tagNames[tag]; }
+  const Counts &getFrameCounts(int tag) const { return frameCounts[tag]; }
+  Counts getFrameTotal() const { return frameTotal; }
+
+  void setLogging(bool enabled) { logging = enabled; }
+
+  // Totals since start, one tag per line
+  void report(std::ostream &out) const;
+
+  void toggleOverlay() { overlayVisible = !overlayVisible; }
+  void renderOverlay(SDL_Renderer *renderer, int x, int y);
+
+private:
+  AllocTracker();
+
+  std::mutex registryMutex; // Taken once per call site, never per allocation
+  std::array<const char *, MAX_TAGS> tagNames;
+  std::atomic<int> tagCount;
+  std::atomic<bool> gameThreadMarked;
+
+  // Running totals, written by every thread
+  std::array<std::atomic<uint64_t>, MAX_TAGS> totalAllocs;
+  std::array<std::atomic<uint64_t>, MAX_TAGS> totalBytes;
+  std::atomic<uint64_t> totalFrees;
+
+  // Game-thread snapshots taken in endFrame()
+  std::array<Counts, MAX_TAGS> lastTotals;
+  std::array<Counts, MAX_TAGS> frameCounts;
+  std::array<Counts, MAX_TAGS> intervalCounts;
+  Counts frameTotal; // Game thread only
+  int intervalFrames;
+
+  bool logging;
+  bool overlayVisible;
+};
+
+class AllocScope {
+public:
+  explicit AllocScope(int tag) : previous(AllocTracker::exchangeTag(tag)) {}
+  ~AllocScope() { AllocTracker::exchangeTag(previous); }
+
+  AllocScope(const AllocScope &) = delete;
+  AllocScope &operator=(const AllocScope &) = delete;
+
+private:
+  int previous;
+};
+
+#ifdef STELLAR_ALLOC_TRACK
+#define ALLOC_CONCAT_INNER(a, b) a##b
+#define ALLOC_CONCAT(a, b) ALLOC_CONCAT_INNER(a, b)
+#define ALLOC_SCOPE(name)                                                      \
+  static const int ALLOC_CONCAT(allocTag, __LINE__) =                          \
+      AllocTracker::get().registerTag(name);                                   \
+  AllocScope ALLOC_CONCAT(allocScope, __LINE__)(                               \
+      ALLOC_CONCAT(allocTag, __LINE__))
+#define ALLOC_FRAME() AllocTracker::get().endFrame()
+#else
+#define ALLOC_SCOPE(name) ((void)0)
+#define ALLOC_FRAME() ((void)0)
+#endif
+
+#endif // ALLOC_TRACKER_H
@@ -0,0 +1,505 @@
+#include "AudioMixer.h"
+#include "Log.h"
+#include "Percentile.h"
+#include <algorithm>
+#include <cmath>
+#include <cstdio>
+
+#if defined(__SSE2__) || defined(_M_X64)
+#include <emmintrin.h>
+#define AUDIO_HAS_SSE2 1
+#endif
+
+#if defined(AUDIO_HAS_SSE2) && (defined(__GNUC__) || defined(__clang__))
+#include <immintrin.h>
+#define AUDIO_HAS_AVX2 1
+#endif
+
+namespace {
+
+struct SoundDefinition {
+  float duration; // Seconds
+  float gain;
+  int voiceLimit; // Same-sound voices before the oldest is restarted
+  int priority;   // Higher steals lower
+};
+
+// Per-sound limits sum past MAX_VOICES on purpose: under heavy load the
+// priorities decide what is heard
+constexpr SoundDefinition soundDefinitions[SOUND_COUNT] = {
+    {0.08f, 0.25f, 4, 1},  // PlayerShot
+    {0.10f, 0.15f, 8, 0},  // EnemyShot
+    {0.12f, 0.35f, 6, 2},  // Hit
+    {0.60f, 0.50f, 12, 3}, // Explosion
+    {0.30f, 0.70f, 2, 4},  // PlayerHit
+};
+
+constexpr float PI = 3.14159265f;
+
+// Deterministic noise so every run sounds the same
+struct Noise {
+  uint32_t state = 0x9E3779B9u;
+
+  float next() {
+    state ^= state << 13;
+    state ^= state >> 17;
+    state ^= state << 5;
+    return static_cast<float>(state) / 2147483648.0f - 1.0f;
+  }
+};
+
+// Square wave sweeping from startHz to endHz with a linear decay
+void synthSweep(std::vector<float> &out, int frequency, float startHz,
+                float endHz) {
+  float phase = 0.0f;
+  size_t count = out.size();
+  for (size_t i = 0; i < count; i++) {
+    float t = static_cast<float>(i) / count;
+    phase += (startHz + (endHz - startHz) * t) / frequency;
+    phase -= std::floor(phase);
+    out[i] = (phase < 0.5f ? 1.0f : -1.0f) * (1.0f - t);
+  }
+}
+
+std::vector<float> synthesize(Sound sound, int frequency) {
+  const SoundDefinition &definition = soundDefinitions[static_cast<int>(sound)];
+  std::vector<float> out(
+      static_cast<size_t>(definition.duration * frequency), 0.0f);
+  Noise noise;
+
+  switch (sound) {
+  case Sound::PlayerShot:
+    synthSweep(out, frequency, 1400.0f, 500.0f);
+    break;
+  case Sound::EnemyShot:
+    synthSweep(out, frequency, 520.0f, 260.0f);
+    break;
+  case Sound::Hit:
+    for (size_t i = 0; i < out.size(); i++) {
+      float t = static_cast<float>(i) / frequency;
+      out[i] = noise.next() * std::exp(-t * 30.0f);
+    }
+    break;
+  case Sound::Explosion: {
+    // Low-passed noise that darkens as it fades, over a low rumble
+    float filtered = 0.0f;
+    for (size_t i = 0; i < out.size(); i++) {
+      float t = static_cast<float>(i) / frequency;
+      float cutoff = 0.25f * std::exp(-t * 4.0f) + 0.02f;
+      filtered += (noise.next() - filtered) * cutoff;
+      float rumble = std::sin(2.0f * PI * 55.0f * t);
+      out[i] = (filtered * 2.5f + rumble * 0.4f) * std::exp(-t * 5.0f);
+    }
+    break;
+  }
+  case Sound::PlayerHit: {
+    float phase = 0.0f;
+    for (size_t i = 0; i < out.size(); i++) {
+      float t = static_cast<float>(i) / frequency;
+      phase += (180.0f + 40.0f * std::sin(2.0f * PI * 30.0f * t)) / frequency;
+      phase -= std::floor(phase);
+      float tone = phase < 0.5f ? 1.0f : -1.0f;
+      out[i] = (tone * 0.7f + noise.next() * 0.3f) * std::exp(-t * 8.0f);
+    }
+    break;
+  }
+  }
+
+  for (float &sample : out) {
+    sample = std::min(1.0f, std::max(-1.0f, sample));
+  }
+  return out;
+}
+
+// Each mixer adds frames of mono samples into interleaved stereo output
+
+void mixScalar(float *out, const float *samples, int frames, float gainLeft,
+               float gainRight) {
+  for (int i = 0; i < frames; i++) {
+    out[2 * i] += samples[i] * gainLeft;
+    out[2 * i + 1] += samples[i] * gainRight;
+  }
+}
+
+#ifdef AUDIO_HAS_SSE2
+void mixSSE2(float *out, const float *samples, int frames, float gainLeft,
+             float gainRight) {
+  const __m128 gain = _mm_setr_ps(gainLeft, gainRight, gainLeft, gainRight);
+  int i = 0;
+  for (; i + 4 <= frames; i += 4) {
+    __m128 mono = _mm_loadu_ps(samples + i);
+    __m128 low = _mm_unpacklo_ps(mono, mono);  // s0 s0 s1 s1
+    __m128 high = _mm_unpackhi_ps(mono, mono); // s2 s2 s3 s3
+    float *o = out + 2 * i;
+    _mm_storeu_ps(o, _mm_add_ps(_mm_loadu_ps(o), _mm_mul_ps(low, gain)));
+    _mm_storeu_ps(o + 4,
+                  _mm_add_ps(_mm_loadu_ps(o + 4), _mm_mul_ps(high, gain)));
+  }
+  mixScalar(out + 2 * i, samples + i, frames - i, gainLeft, gainRight);
+}
+#endif
+
+#ifdef AUDIO_HAS_AVX2
+__attribute__((target("avx2"))) void mixAVX2(float *out, const float *samples,
+                                             int frames, float gainLeft,
+                                             float gainRight) {
+  const __m256 gain = _mm256_setr_ps(gainLeft, gainRight, gainLeft, gainRight,
+                                     gainLeft, gainRight, gainLeft, gainRight);
+  const __m256i lowIndex = _mm256_setr_epi32(0, 0, 1, 1, 2, 2, 3, 3);
+  const __m256i highIndex = _mm256_setr_epi32(4, 4, 5, 5, 6, 6, 7, 7);
+  int i = 0;
+  for (; i + 8 <= frames; i += 8) {
+    __m256 mono = _mm256_loadu_ps(samples + i);
+    __m256 first = _mm256_permutevar8x32_ps(mono, lowIndex);   // s0 s0 .. s3
+    __m256 second = _mm256_permutevar8x32_ps(mono, highIndex); // s4 s4 .. s7
+    float *o = out + 2 * i;
+    _mm256_storeu_ps(
+        o, _mm256_add_ps(_mm256_loadu_ps(o), _mm256_mul_ps(first, gain)));
+    _mm256_storeu_ps(o + 8, _mm256_add_ps(_mm256_loadu_ps(o + 8),
+                                          _mm256_mul_ps(second, gain)));
+  }
+  // Leaving dirty upper halves slows every later SSE instruction, and the
+  // compiler skips vzeroupper when the tail below becomes a jump
+  _mm256_zeroupper();
+  mixScalar(out + 2 * i, samples + i, frames - i, gainLeft, gainRight);
+}
+#endif
+
+} // namespace
+
+AudioMixer::AudioMixer()
+    : device(0), ready(false), frequency(0), path(Path::Scalar),
+      mixVoice(mixScalar), voices(), queue(), queueHead(0), queueTail(0),
+      dropped(0), callbacks(0), lastNs(0), peakNs(0), budgetNs(0),
+      activeVoices(0), stolen(0), rejected(0) {
+  for (auto &duration : history) {
+    duration.store(0, std::memory_order_relaxed);
+  }
+  setPath(Path::AVX2);
+}
+
+AudioMixer::~AudioMixer() { close(); }
+
+bool AudioMixer::open(int wantFrequency, int bufferFrames) {
+  close();
+
+  SDL_AudioSpec want{};
+  want.freq = wantFrequency;
+  want.format = AUDIO_F32SYS;
+  want.channels = CHANNELS;
+  want.samples = static_cast<Uint16>(bufferFrames);
+  want.callback = callback;
+  want.userdata = this;
+
+  // SDL converts format and channels for us; only the rate may differ,
+  // and the sounds are synthesized at whatever rate we get
+  SDL_AudioSpec have{};
+  device = SDL_OpenAudioDevice(nullptr, 0, &want, &have,
+                               SDL_AUDIO_ALLOW_FREQUENCY_CHANGE);
+  if (device == 0) {
+    LOG_WARN("audio", "Could not open audio device: %s", SDL_GetError());
+    return false;
+  }
+
+  prepare(have.freq);
+  LOG_INFO("audio", "%s driver, %d Hz, %d-frame buffer, %s mixing",
+           SDL_GetCurrentAudioDriver(), have.freq, have.samples,
+           pathName(path));
+
+  // Devices open paused; the callback starts after the bank is built
+  SDL_PauseAudioDevice(device, 0);
+  return true;
+}
+
+void AudioMixer::close() {
+  if (device == 0)
+    return;
+
+  SDL_CloseAudioDevice(device);
+  device = 0;
+  ready = false;
+
+  // The callback has stopped, so both ends of the queue are ours
+  queueHead.store(queueTail.load(std::memory_order_relaxed),
+                  std::memory_order_relaxed);
+}
+
+void AudioMixer::prepare(int rate) {
+  frequency = rate;
+  for (int i = 0; i < SOUND_COUNT; i++) {
+    bank[i] = synthesize(static_cast<Sound>(i), frequency);
+  }
+  for (Voice &voice : voices) {
+    voice.samples = nullptr;
+  }
+  ready = true;
+}
+
+bool AudioMixer::play(Sound sound, float gain, float pan, int priority) {
+  if (!ready)
+    return false;
+
+  const SoundDefinition &definition =
+      soundDefinitions[static_cast<int>(sound)];
+
+  // Constant-power pan
+  pan = std::min(1.0f, std::max(-1.0f, pan));
+  float angle = (pan + 1.0f) * PI / 4.0f;
+  gain *= definition.gain;
+
+  Command command;
+  command.type = CommandType::Play;
+  command.sound = static_cast<uint8_t>(sound);
+  command.priority =
+      static_cast<uint8_t>(priority < 0 ? definition.priority : priority);
+  command.gainLeft = gain * std::cos(angle);
+  command.gainRight = gain * std::sin(angle);
+  return push(command);
+}
+
+bool AudioMixer::stopAll() {
+  if (!ready)
+    return false;
+
+  Command command{};
+  command.type = CommandType::StopAll;
+  return push(command);
+}
+
+bool AudioMixer::push(const Command &command) {
+  uint32_t tail = queueTail.load(std::memory_order_relaxed);
+  if (tail - queueHead.load(std::memory_order_acquire) == QUEUE_SIZE) {
+    dropped.fetch_add(1, std::memory_order_relaxed);
+    return false;
+  }
+
+  queue[tail & (QUEUE_SIZE - 1)] = command;
+  queueTail.store(tail + 1, std::memory_order_release);
+  return true;
+}
+
+void AudioMixer::drainCommands() {
+  uint32_t head = queueHead.load(std::memory_order_relaxed);
+  uint32_t tail = queueTail.load(std::memory_order_acquire);
+
+  for (; head != tail; head++) {
+    const Command &command = queue[head & (QUEUE_SIZE - 1)];
+    if (command.type == CommandType::StopAll) {
+      for (Voice &voice : voices) {
+        voice.samples = nullptr;
+      }
+    } else {
+      startVoice(command);
+    }
+  }
+
+  queueHead.store(head, std::memory_order_release);
+}
+
+void AudioMixer::startVoice(const Command &command) {
+  const SoundDefinition &definition = soundDefinitions[command.sound];
+  const std::vector<float> &pcm = bank[command.sound];
+  if (pcm.empty())
+    return;
+
+  Voice *freeVoice = nullptr;
+  Voice *oldestSame = nullptr;
+  Voice *victim = nullptr;
+  int sameCount = 0;
+
+  for (Voice &voice : voices) {
+    if (!voice.samples) {
+      if (!freeVoice)
+        freeVoice = &voice;
+      continue;
+    }
+
+    if (voice.sound == command.sound) {
+      sameCount++;
+      if (!oldestSame || voice.position > oldestSame->position)
+        oldestSame = &voice;
+    }
+
+    // Steal candidate: lowest priority, then the most played-out
+    // (position / length, compared without dividing)
+    if (!victim || voice.priority < victim->priority ||
+        (voice.priority == victim->priority &&
+         uint64_t(voice.position) * victim->length >
+             uint64_t(victim->position) * voice.length)) {
+      victim = &voice;
+    }
+  }
+
+  Voice *target;
+  if (sameCount >= definition.voiceLimit) {
+    target = oldestSame; // Over the sound's own limit: restart its oldest
+  } else if (freeVoice) {
+    target = freeVoice;
+  } else if (victim->priority <= command.priority) {
+    target = victim;
+    stolen.fetch_add(1, std::memory_order_relaxed);
+  } else {
+    rejected.fetch_add(1, std::memory_order_relaxed);
+    return;
+  }
+
+  target->samples = pcm.data();
+  target->length = static_cast<uint32_t>(pcm.size());
+  target->position = 0;
+  target->gainLeft = command.gainLeft;
+  target->gainRight = command.gainRight;
+  target->sound = command.sound;
+  target->priority = command.priority;
+}
+
+void AudioMixer::callback(void *userdata, Uint8 *stream, int length) {
+  auto *mixer = static_cast<AudioMixer *>(userdata);
+  mixer->mix(reinterpret_cast<float *>(stream),
+             length / static_cast<int>(CHANNELS * sizeof(float)));
+}
+
+void AudioMixer::mix(float *out, int frames) {
+  Uint64 start = SDL_GetPerformanceCounter();
+
+  std::fill(out, out + frames * CHANNELS, 0.0f);
+  drainCommands();
+
+  int playing = 0;
+  for (Voice &voice : voices) {
+    if (!voice.samples)
+      continue;
+
+    int count = static_cast<int>(std::min<uint32_t>(
+        static_cast<uint32_t>(frames), voice.length - voice.position));
+    mixVoice(out, voice.samples + voice.position, count, voice.gainLeft,
+             voice.gainRight);
+
+    voice.position += count;
+    if (voice.position >= voice.length) {
+      voice.samples = nullptr;
+    } else {
+      playing++;
+    }
+  }
+
+  // Hard limit; the sound gains leave headroom for typical loads
+  for (int i = 0; i < frames * CHANNELS; i++) {
+    out[i] = std::min(1.0f, std::max(-1.0f, out[i]));
+  }
+
+  Uint64 elapsed = SDL_GetPerformanceCounter() - start;
+  uint64_t ns = static_cast<uint64_t>(
+      elapsed * 1000000000.0 / SDL_GetPerformanceFrequency());
+
+  uint64_t index = callbacks.load(std::memory_order_relaxed);
+  history[index % HISTORY].store(static_cast<uint32_t>(ns),
+                                 std::memory_order_relaxed);
+  lastNs.store(ns, std::memory_order_relaxed);
+  if (ns > peakNs.load(std::memory_order_relaxed))
+    peakNs.store(ns, std::memory_order_relaxed);
+  if (frequency > 0) {
+    budgetNs.store(uint64_t(frames) * 1000000000ull / frequency,
+                   std::memory_order_relaxed);
+  }
+  activeVoices.store(playing, std::memory_order_relaxed);
+  callbacks.store(index + 1, std::memory_order_release);
+}
+
+AudioMixer::Path AudioMixer::setPath(Path wanted) {
+  // Best supported path at or below the one asked for
+  path = Path::Scalar;
+  mixVoice = mixScalar;
+#ifdef AUDIO_HAS_SSE2
+  if (wanted != Path::Scalar) {
+    path = Path::SSE2;
+    mixVoice = mixSSE2;
+  }
+#endif
+#ifdef AUDIO_HAS_AVX2
+  if (wanted == Path::AVX2 && isSupported(Path::AVX2)) {
+    path = Path::AVX2;
+    mixVoice = mixAVX2;
+  }
+#endif
+  return path;
+}
+
+bool AudioMixer::isSupported(Path path) {
+  switch (path) {
+  case Path::Scalar:
+    return true;
+  case Path::SSE2:
+#ifdef AUDIO_HAS_SSE2
+    return true;
+#else
+    return false;
+#endif
+  case Path::AVX2:
+#ifdef AUDIO_HAS_AVX2
+    return __builtin_cpu_supports("avx2");
+#else
+    return false;
+#endif
+  }
+  return false;
+}
+
+const char *AudioMixer::pathName(Path path) {
+  switch (path) {
+  case Path::Scalar:
+    return "scalar";
+  case Path::SSE2:
+    return "SSE2";
+  case Path::AVX2:
+    return "AVX2";
+  }
+  return "unknown";
+}
+
+AudioMixer::Stats AudioMixer::getStats() const {
+  Stats stats;
+  stats.callbacks = callbacks.load(std::memory_order_acquire);
+  stats.lastNs = lastNs.load(std::memory_order_relaxed);
+  stats.peakNs = peakNs.load(std::memory_order_relaxed);
+  stats.budgetNs = budgetNs.load(std::memory_order_relaxed);
+  stats.voices = activeVoices.load(std::memory_order_relaxed);
+  stats.stolen = stolen.load(std::memory_order_relaxed);
+  stats.rejected = rejected.load(std::memory_order_relaxed);
+  stats.dropped = dropped.load(std::memory_order_relaxed);
+  return stats;
+}
+
+void AudioMixer::resetPeak() { peakNs.store(0, std::memory_order_relaxed); }
+
+void AudioMixer::report(std::ostream &out) const {
+  Stats stats = getStats();
+  size_t count = static_cast<size_t>(
+      std::min<uint64_t>(stats.callbacks, static_cast<uint64_t>(HISTORY)));
+
+  std::vector<uint32_t> durations(count);
+  for (size_t i = 0; i < count; i++) {
+    durations[i] = history[i].load(std::memory_order_relaxed);
+  }
+  std::sort(durations.begin(), durations.end());
+
+  char line[128];
+  std::snprintf(line, sizeof(line),
+                "Audio callback times over the last %zu of %llu callbacks "
+                "(us, %s, budget %.0f):",
+                count, static_cast<unsigned long long>(stats.callbacks),
+                pathName(path), stats.budgetNs / 1000.0);
+  out << line << std::endl;
+  out << "             p50       p95       p99       max" << std::endl;
+  std::snprintf(line, sizeof(line), "  %-8s %9.3f %9.3f %9.3f %9.3f",
+                "callback", percentile(durations, 0.50) / 1000.0,
+                percentile(durations, 0.95) / 1000.0,
+                percentile(durations, 0.99) / 1000.0,
+                durations.empty() ? 0.0 : durations.back() / 1000.0);
+  out << line << std::endl;
+  std::snprintf(line, sizeof(line),
+                "  voices stolen %llu, rejected %llu, commands dropped %llu",
+                static_cast<unsigned long long>(stats.stolen),
+                static_cast<unsigned long long>(stats.rejected),
+                static_cast<unsigned long long>(stats.dropped));
+  out << line << std::endl;
+}
@@ -0,0 +1,142 @@
+#ifndef AUDIO_MIXER_H
+#define AUDIO_MIXER_H
+
+#include <SDL2/SDL.h>
+#include <atomic>
+#include <cstdint>
+#include <ostream>
+#include <vector>
+
+enum class Sound { PlayerShot, EnemyShot, Hit, Explosion, PlayerHit };
+constexpr int SOUND_COUNT = 5;
+
+// Real-time sound effect mixer on an SDL audio device.
+//
+// Sounds are synthesized into mono float PCM once, before the device
+// starts. The game thread sends play/stop commands through a wait-free
+// single-producer/single-consumer ring; the audio callback drains it,
+// starts voices and mixes every active voice into the stereo output with
+// SSE2 or AVX2 (picked at startup). The callback never allocates, locks
+// or blocks.
+//
+// Each sound has a voice limit (a new shot replaces the oldest shot) and
+// a priority: when all MAX_VOICES are busy a new sound steals the lowest
+// priority, most played-out voice, or is rejected if every voice matters
+// more. Explosion bursts therefore cannot starve player feedback.
+//
+// Runs on any SDL audio driver, including SDL_AUDIODRIVER=dummy and
+// SDL_AUDIODRIVER=disk (which writes the mixed output to a file).
+class AudioMixer {
+public:
+  static constexpr int MAX_VOICES = 24;
+  static constexpr int QUEUE_SIZE = 256; // Commands; power of two
+  static constexpr int CHANNELS = 2;
+  static constexpr int HISTORY = 1024; // Callback durations kept
+
+  enum class Path { Scalar, SSE2, AVX2 };
+
+  struct Stats {
+    uint64_t callbacks;
+    uint64_t lastNs;   // Duration of the latest callback
+    uint64_t peakNs;   // Longest callback since the last resetPeak()
+    uint64_t budgetNs; // Audio time one callback produces
+    int voices;        // Playing after the latest callback
+    uint64_t stolen;   // Voices cut off for a higher-priority sound
+    uint64_t rejected; // Sounds dropped because every voice mattered more
+    uint64_t dropped;  // Commands lost to a full queue
+  };
+
+  AudioMixer();
+  ~AudioMixer();
+
+  AudioMixer(const AudioMixer &) = delete;
+  AudioMixer &operator=(const AudioMixer &) = delete;
+
+  // Opens the default device (SDL_INIT_AUDIO must be initialized), builds
+  // the sound bank at the device rate and starts playback
+  bool open(int frequency = 48000, int bufferFrames = 512);
+  void close();
+
+  // Builds the sound bank without a device, for driving mix() directly
+  void prepare(int frequency);
+  bool isReady() const { return ready; }
+
+  // Game thread only. pan is -1 (left) to 1 (right); priority < 0 uses
+  // the sound's default. Returns false if the command was dropped.
+  bool play(Sound sound, float gain = 1.0f, float pan = 0.0f,
+            int priority = -1);
+  bool stopAll();
+
+  // Mixes frames of interleaved stereo into out, overwriting it. This is
+  // the audio callback body; call it directly only without a device.
+  void mix(float *out, int frames);
+
+  // Falls back to the best supported path and returns the one in use.
+  // Not while a device is playing.
+  Path setPath(Path path);
+  Path getPath() const { return path; }
+  static bool isSupported(Path path);
+  static const char *pathName(Path path);
+
+  Stats getStats() const;
+  void resetPeak();
+  // Callback duration percentiles over the recent history
+  void report(std::ostream &out) const;
+
+private:
+  enum class CommandType : uint8_t { Play, StopAll };
+
+  struct Command {
+    CommandType type;
+    uint8_t sound;
+    uint8_t priority;
+    float gainLeft;
+    float gainRight;
+  };
+
+  struct Voice {
+    const float *samples; // nullptr when free
+    uint32_t length;
+    uint32_t position;
+    float gainLeft;
+    float gainRight;
+    uint8_t sound;
+    uint8_t priority;
+  };
+
+  using MixFunction = void (*)(float *out, const float *samples, int frames,
+                               float gainLeft, float gainRight);
+
+  static void callback(void *userdata, Uint8 *stream, int length);
+
+  bool push(const Command &command);
+  void drainCommands();
+  void startVoice(const Command &command);
+
+  SDL_AudioDeviceID device;
+  bool ready;
+  int frequency;
+  Path path;
+  MixFunction mixVoice;
+
+  std::vector<float> bank[SOUND_COUNT];
+  Voice voices[MAX_VOICES];
+
+  // Wait-free SPSC ring: the game thread owns tail, the callback head
+  Command queue[QUEUE_SIZE];
+  alignas(64) std::atomic<uint32_t> queueHead;
+  alignas(64) std::atomic<uint32_t> queueTail;
+  std::atomic<uint64_t> dropped;
+
+  // Written by the callback, read by the game thread
+  alignas(64) std::atomic<uint64_t> callbacks;
+  std::atomic<uint64_t> lastNs;
+  std::atomic<uint64_t> peakNs;
+  std::atomic<uint64_t> budgetNs;
+  std::atomic<int> activeVoices;
+  std::atomic<uint64_t> stolen;
+  std::atomic<uint64_t> rejected;
+  std::atomic<uint32_t> history[HISTORY];
+};
+
+#endif // AUDIO_MIXER_H
@@ -0,0 +1,242 @@
+#include "BitmapFont.h"
+#include "Draw.h"
+#include "Log.h"
+#include <cstring>
+
+namespace {
+
+// Atlas cells: printable ASCII in a 16 x 6 grid, each glyph in the top-left
+// of a 6 x 8 cell so neighbours never bleed into each other
+constexpr int FIRST_CHAR = 32;
+constexpr int CHAR_COUNT = 96;
+constexpr int COLUMNS = 16;
+constexpr int CELL_WIDTH = 6;
+constexpr int CELL_HEIGHT = 8;
+
+// One row per byte, bit 4 the leftmost pixel
+struct GlyphBits {
+  char c;
+  uint8_t rows[BitmapFont::GLYPH_HEIGHT];
+};
+
+constexpr GlyphBits GLYPHS[] = {
+    {'0', {0x0E, 0x11, 0x13, 0x15, 0x19, 0x11, 0x0E}},
+    {'1', {0x04, 0x0C, 0x04, 0x04, 0x04, 0x04, 0x0E}},
+    {'2', {0x0E, 0x11, 0x01, 0x02, 0x04, 0x08, 0x1F}},
+    {'3', {0x1F, 0x02, 0x04, 0x02, 0x01, 0x11, 0x0E}},
+    {'4', {0x02, 0x06, 0x0A, 0x12, 0x1F, 0x02, 0x02}},
+    {'5', {0x1F, 0x10, 0x1E, 0x01, 0x01, 0x11, 0x0E}},
+    {'6', {0x06, 0x08, 0x10, 0x1E, 0x11, 0x11, 0x0E}},
+    {'7', {0x1F, 0x01, 0x02, 0x04, 0x08, 0x08, 0x08}},
+    {'8', {0x0E, 0x11, 0x11, 0x0E, 0x11, 0x11, 0x0E}},
+    {'9', {0x0E, 0x11, 0x11, 0x0F, 0x01, 0x02, 0x0C}},
+    {'A', {0x0E, 0x11, 0x11, 0x11, 0x1F, 0x11, 0x11}},
+    {'B', {0x1E, 0x11, 0x11, 0x1E, 0x11, 0x11, 0x1E}},
+    {'C', {0x0E, 0x11, 0x10, 0x10, 0x10, 0x11, 0x0E}},
+    {'D', {0x1C, 0x12, 0x11, 0x11, 0x11, 0x12, 0x1C}},
+    {'E', {0x1F, 0x10, 0x10, 0x1E, 0x10, 0x10, 0x1F}},
+    {'F', {0x1F, 0x10, 0x10, 0x1E, 0x10, 0x10, 0x10}},
+    {'G', {0x0E, 0x11, 0x10, 0x17, 0x11, 0x11, 0x0F}},
+    {'H', {0x11, 0x11, 0x11, 0x1F, 0x11, 0x11, 0x11}},
+    {'I', {0x0E, 0x04, 0x04, 0x04, 0x04, 0x04, 0x0E}},
+    {'J', {0x07, 0x02, 0x02, 0x02, 0x02, 0x12, 0x0C}},
+    {'K', {0x11, 0x12, 0x14, 0x18, 0x14, 0x12, 0x11}},
+    {'L', {0x10, 0x10, 0x10, 0x10, 0x10, 0x10, 0x1F}},
+    {'M', {0x11, 0x1B, 0x15, 0x15, 0x11, 0x11, 0x11}},
+    {'N', {0x11, 0x11, 0x19, 0x15, 0x13, 0x11, 0x11}},
+    {'O', {0x0E, 0x11, 0x11, 0x11, 0x11, 0x11, 0x0E}},
+    {'P', {0x1E, 0x11, 0x11, 0x1E, 0x10, 0x10, 0x10}},
+    {'Q', {0x0E, 0x11, 0x11, 0x11, 0x15, 0x12, 0x0D}},
+    {'R', {0x1E, 0x11, 0x11, 0x1E, 0x14, 0x12, 0x11}},
+    {'S', {0x0F, 0x10, 0x10, 0x0E, 0x01, 0x01, 0x1E}},
+    {'T', {0x1F, 0x04, 0x04, 0x04, 0x04, 0x04, 0x04}},
+    {'U', {0x11, 0x11, 0x11, 0x11, 0x11, 0x11, 0x0E}},
+    {'V', {0x11, 0x11, 0x11, 0x11, 0x11, 0x0A, 0x04}},
+    {'W', {0x11, 0x11, 0x11, 0x15, 0x15, 0x15, 0x0A}},
+    {'X', {0x11, 0x11, 0x0A, 0x04, 0x0A, 0x11, 0x11}},
+    {'Y', {0x11, 0x11, 0x11, 0x0A, 0x04, 0x04, 0x04}},
+    {'Z', {0x1F, 0x01, 0x02, 0x04, 0x08, 0x10, 0x1F}},
+    {'x', {0x00, 0x00, 0x11, 0x0A, 0x04, 0x0A, 0x11}},
+    {'!', {0x04, 0x04, 0x04, 0x04, 0x04, 0x00, 0x04}},
+    {'?', {0x0E, 0x11, 0x01, 0x02, 0x04, 0x00, 0x04}},
+    {'.', {0x00, 0x00, 0x00, 0x00, 0x00, 0x0C, 0x0C}},
+    {',', {0x00, 0x00, 0x00, 0x00, 0x0C, 0x04, 0x08}},
+    {':', {0x00, 0x0C, 0x0C, 0x00, 0x0C, 0x0C, 0x00}},
+    {'\'', {0x0C, 0x04, 0x08, 0x00, 0x00, 0x00, 0x00}},
+    {'-', {0x00, 0x00, 0x00, 0x1F, 0x00, 0x00, 0x00}},
+    {'+', {0x00, 0x04, 0x04, 0x1F, 0x04, 0x04, 0x00}},
+    {'=', {0x00, 0x00, 0x1F, 0x00, 0x1F, 0x00, 0x00}},
+    {'*', {0x00, 0x04, 0x15, 0x0E, 0x15, 0x04, 0x00}},
+    {'/', {0x00, 0x01, 0x02, 0x04, 0x08, 0x10, 0x00}},
+    {'%', {0x18, 0x19, 0x02, 0x04, 0x08, 0x13, 0x03}},
+    {'#', {0x0A, 0x0A, 0x1F, 0x0A, 0x1F, 0x0A, 0x0A}},
+    {'(', {0x02, 0x04, 0x08, 0x08, 0x08, 0x04, 0x02}},
+    {')', {0x08, 0x04, 0x02, 0x02, 0x02, 0x04, 0x08}},
+};
+
+// Atlas character for c: lowercase folds to uppercase (the x multiplier
+// sign has its own glyph), anything unknown becomes a space
+unsigned char atlasChar(char c) {
+  unsigned char u = static_cast<unsigned char>(c);
+  if (u >= 'a' && u <= 'z' && u != 'x') {
+    u = static_cast<unsigned char>(u - 'a' + 'A');
+  }
+  if (u < FIRST_CHAR || u >= FIRST_CHAR + CHAR_COUNT)
+    return ' ';
+  return u;
+}
+
+int alignedX(int x, int width, TextAlign align) {
+  switch (align) {
+  case TextAlign::Center:
+    return x - width / 2;
+  case TextAlign::Right:
+    return x - width;
+  default:
+    return x;
+  }
+}
+
+} // namespace
+
+BitmapFont::BitmapFont()
+    : texture(nullptr), atlasWidth(COLUMNS * CELL_WIDTH),
+      atlasHeight((CHAR_COUNT / COLUMNS) * CELL_HEIGHT) {}
+
+BitmapFont::~BitmapFont() { release(); }
+
+bool BitmapFont::load(SDL_Renderer *renderer) {
+  release();
+
+  // White glyphs on transparent white; vertex colors tint them
+  std::vector<Uint32> pixels(size_t(atlasWidth) * atlasHeight, 0xffffff00);
+  for (const GlyphBits &glyph : GLYPHS) {
+    int index = static_cast<unsigned char>(glyph.c) - FIRST_CHAR;
+    int cellX = (index % COLUMNS) * CELL_WIDTH;
+    int cellY = (index / COLUMNS) * CELL_HEIGHT;
+    for (int row = 0; row < GLYPH_HEIGHT; row++) {
+      for (int col = 0; col < GLYPH_WIDTH; col++) {
+        if (glyph.rows[row] & (0x10 >> col)) {
+          pixels[size_t(cellY + row) * atlasWidth + cellX + col] = 0xffffffff;
+        }
+      }
+    }
+  }
+
+  texture = SDL_CreateTexture(renderer, SDL_PIXELFORMAT_RGBA8888,
+                              SDL_TEXTUREACCESS_STATIC, atlasWidth,
+                              atlasHeight);
+  if (!texture) {
+    LOG_WARN("render", "Font atlas failed, text disabled: %s", SDL_GetError());
+    return false;
+  }
+  SDL_UpdateTexture(texture, nullptr, pixels.data(),
+                    atlasWidth * static_cast<int>(sizeof(Uint32)));
+  SDL_SetTextureBlendMode(texture, SDL_BLENDMODE_BLEND);
+  return true;
+}
+
+void BitmapFont::release() {
+  if (texture) {
+    SDL_DestroyTexture(texture);
+    texture = nullptr;
+  }
+}
+
+int BitmapFont::measure(const char *text, int scale) const {
+  int length = static_cast<int>(std::strlen(text));
+  if (length == 0)
+    return 0;
+  return (length * ADVANCE - (ADVANCE - GLYPH_WIDTH)) * scale;
+}
+
+TextId BitmapFont::cache(const char *text) {
+  CachedText entry;
+  entry.first = static_cast<uint32_t>(layouts.size());
+  for (int i = 0; text[i]; i++) {
+    glyphQuad(layouts, atlasChar(text[i]), static_cast<float>(i * ADVANCE),
+              0.0f, 1.0f, SDL_Color{255, 255, 255, 255});
+  }
+  entry.count = static_cast<uint32_t>(layouts.size()) - entry.first;
+  entry.width = measure(text, 1);
+  cached.push_back(entry);
+  return static_cast<TextId>(cached.size() - 1);
+}
+
+void BitmapFont::glyphQuad(std::vector<SDL_Vertex> &out, unsigned char c,
+                           float x, float y, float scale,
+                           SDL_Color color) const {
+  if (c == ' ')
+    return;
+
+  int index = c - FIRST_CHAR;
+  float u0 = static_cast<float>((index % COLUMNS) * CELL_WIDTH) / atlasWidth;
+  float v0 = static_cast<float>((index / COLUMNS) * CELL_HEIGHT) / atlasHeight;
+  float u1 = u0 + static_cast<float>(GLYPH_WIDTH) / atlasWidth;
+  float v1 = v0 + static_cast<float>(GLYPH_HEIGHT) / atlasHeight;
+  float x1 = x + GLYPH_WIDTH * scale;
+  float y1 = y + GLYPH_HEIGHT * scale;
+
+  SDL_Vertex topLeft = {{x, y}, color, {u0, v0}};
+  SDL_Vertex topRight = {{x1, y}, color, {u1, v0}};
+  SDL_Vertex bottomLeft = {{x, y1}, color, {u0, v1}};
+  SDL_Vertex bottomRight = {{x1, y1}, color, {u1, v1}};
+  out.push_back(topLeft);
+  out.push_back(topRight);
+  out.push_back(bottomLeft);
+  out.push_back(topRight);
+  out.push_back(bottomRight);
+  out.push_back(bottomLeft);
+}
+
+TextBatch::TextBatch() { vertices.reserve(64 * 6); }
+
+void TextBatch::add(const BitmapFont &font, const char *text, int x, int y,
+                    int scale, SDL_Color color, TextAlign align) {
+  int left = alignedX(x, font.measure(text, scale), align);
+  for (int i = 0; text[i]; i++) {
+    font.glyphQuad(vertices, atlasChar(text[i]),
+                   static_cast<float>(left + i * BitmapFont::ADVANCE * scale),
+                   static_cast<float>(y), static_cast<float>(scale), color);
+  }
+}
+
+void TextBatch::addNumber(const BitmapFont &font, int64_t value, int x, int y,
+                          int scale, SDL_Color color, TextAlign align) {
+  // Digits right to left into a stack buffer
+  char buffer[24];
+  char *p = buffer + sizeof(buffer) - 1;
+  *p = '\0';
+  uint64_t magnitude = value < 0 ? 0 - static_cast<uint64_t>(value)
+                                 : static_cast<uint64_t>(value);
+  do {
+    *--p = static_cast<char>('0' + magnitude % 10);
+    magnitude /= 10;
+  } while (magnitude > 0);
+  if (value < 0) {
+    *--p = '-';
+  }
+  add(font, p, x, y, scale, color, align);
+}
+
+void TextBatch::addCached(const BitmapFont &font, TextId id, int x, int y,
+                          int scale, SDL_Color color, TextAlign align) {
+  const BitmapFont::CachedText &text = font.cached[id];
+  float left = static_cast<float>(alignedX(x, text.width * scale, align));
+  float top = static_cast<float>(y);
+  for (uint32_t i = 0; i < text.count; i++) {
+    SDL_Vertex v = font.layouts[text.first + i];
+    v.position.x = left + v.position.x * scale;
+    v.position.y = top + v.position.y * scale;
+    v.color = color;
+    vertices.push_back(v);
+  }
+}
+
+void TextBatch::render(SDL_Renderer *renderer, const BitmapFont &font) {
+  if (!vertices.empty() && font.getTexture()) {
+    Draw::geometry(renderer, font.getTexture(), vertices.data(),
+                   static_cast<int>(vertices.size()));
+  }
+  vertices.clear();
+}
@@ -0,0 +1,85 @@
+#ifndef BITMAP_FONT_H
+#define BITMAP_FONT_H
+
+#include <SDL2/SDL.h>
+#include <cstdint>
+#include <vector>
+
+enum class TextAlign { Left, Center, Right };
+
+// Handle to a string laid out once by BitmapFont::cache()
+using TextId = int;
+
+// Embedded 5x7 pixel font baked into a single atlas texture at startup.
+//
+// Covers printable ASCII; lowercase letters other than 'x' draw as
+// uppercase, anything else missing draws as a space. Text is drawn at
+// whole-pixel scales so glyphs stay crisp with nearest filtering.
+class BitmapFont {
+public:
+  static constexpr int GLYPH_WIDTH = 5;
+  static constexpr int GLYPH_HEIGHT = 7;
+  static constexpr int ADVANCE = 6; // One pixel between glyphs
+
+  BitmapFont();
+  ~BitmapFont();
+
+  BitmapFont(const BitmapFont &) = delete;
+  BitmapFont &operator=(const BitmapFont &) = delete;
+
+  // Bakes the atlas; false (and text is skipped) if the texture fails
+  bool load(SDL_Renderer *renderer);
+  void release();
+  SDL_Texture *getTexture() const { return texture; }
+
+  // Width in pixels of text at scale
+  int measure(const char *text, int scale) const;
+
+  // Lays out a static string once; draw it with TextBatch::addCached()
+  TextId cache(const char *text);
+
+private:
+  friend class TextBatch;
+
+  struct CachedText {
+    uint32_t first; // Into layouts, six vertices per glyph
+    uint32_t count;
+    int width;      // Unit-scale pixels
+  };
+
+  // Appends the two triangles of a glyph with its top-left at (x, y)
+  void glyphQuad(std::vector<SDL_Vertex> &out, unsigned char c, float x,
+                 float y, float scale, SDL_Color color) const;
+
+  SDL_Texture *texture;
+  int atlasWidth;
+  int atlasHeight;
+
+  std::vector<SDL_Vertex> layouts; // Unit scale, origin at 0, 0
+  std::vector<CachedText> cached;
+};
+
+// Glyph quads collected over a frame and submitted in one geometry call.
+//
+// The vertex buffer is reused, so once it has grown to the frame's text
+// nothing allocates; numbers are formatted on the stack.
+class TextBatch {
+public:
+  TextBatch();
+
+  void add(const BitmapFont &font, const char *text, int x, int y, int scale,
+           SDL_Color color, TextAlign align = TextAlign::Left);
+  void addNumber(const BitmapFont &font, int64_t value, int x, int y,
+                 int scale, SDL_Color color, TextAlign align = TextAlign::Left);
+  void addCached(const BitmapFont &font, TextId id, int x, int y, int scale,
+                 SDL_Color color, TextAlign align = TextAlign::Left);
+
+  // Draws everything added since the last render and clears the batch
+  void render(SDL_Renderer *renderer, const BitmapFont &font);
+  void clear() { vertices.clear(); }
+
+private:
+  std::vector<SDL_Vertex> vertices;
+};
+
+#endif // BITMAP_FONT_H
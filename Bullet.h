@@ -2,6 +2,7 @@
 #define BULLET_H
 
 #include "Entity.h"
+#include "TimingWheel.h"
 
 class Bullet : public Entity {
 public:
@@ -12,10 +13,14 @@ public:
 
   bool isPlayerBullet() const { return playerBullet; }
 
+  // Expiry is driven by a timer scheduled when the bullet enters the game
+  float getLifetime() const { return lifetime; }
+  TimerHandle &getExpiryTimer() { return expiryTimer; }
+
 private:
   bool playerBullet;
   float lifetime;
-  float trailTimer;
+  TimerHandle expiryTimer;
 };
 
 #endif // BULLET_H
@@ -0,0 +1,30 @@
+#include "Camera.h"
+#include <algorithm>
+#include <cmath>
+
+Camera::Camera(float viewWidth, float viewHeight) {
+  view.w = viewWidth;
+  view.h = viewHeight;
+  setWorldSize(viewWidth, viewHeight);
+}
+
+void Camera::setWorldSize(float width, float height) {
+  // A world smaller than the screen would leave the view nowhere to go
+  world.w = std::max(width, view.w);
+  world.h = std::max(height, view.h);
+  view.x = std::min(view.x, world.w - view.w);
+  view.y = std::min(view.y, world.h - view.h);
+}
+
+Vector2 Camera::follow(const Vector2 &target) {
+  // Snapped to whole pixels so the world doesn't shimmer as it scrolls
+  float x = std::floor(target.x - view.w * 0.5f);
+  float y = std::floor(target.y - view.h * TARGET_ANCHOR);
+  x = std::clamp(x, 0.0f, world.w - view.w);
+  y = std::clamp(y, 0.0f, world.h - view.h);
+
+  Vector2 moved(x - view.x, y - view.y);
+  view.x = x;
+  view.y = y;
+  return moved;
+}
@@ -0,0 +1,70 @@
+#ifndef CAMERA_H
+#define CAMERA_H
+
+#include "Vector2.h"
+#include <SDL2/SDL.h>
+
+// Axis-aligned rectangle in world coordinates
+struct WorldRect {
+  float x = 0, y = 0, w = 0, h = 0;
+
+  float right() const { return x + w; }
+  float bottom() const { return y + h; }
+
+  bool contains(const Vector2 &p) const {
+    return p.x >= x && p.x < x + w && p.y >= y && p.y < y + h;
+  }
+  bool overlaps(const SDL_Rect &box) const {
+    return box.x + box.w > x && box.x < x + w && box.y + box.h > y &&
+           box.y < y + h;
+  }
+  WorldRect expanded(float margin) const {
+    return {x - margin, y - margin, w + 2 * margin, h + 2 * margin};
+  }
+};
+
+// Viewport onto a world larger than the screen.
+//
+// The view follows a target (the player), held a little below the centre
+// so there is more room to see what comes down, and is clamped to the
+// world. Around it sit two larger regions used to stream the world:
+// enemies inside the active region are simulated, and an active enemy is
+// only put back to sleep once it leaves the sleep region, so anything
+// near the boundary doesn't wake and sleep on alternate frames.
+class Camera {
+public:
+  static constexpr float ACTIVE_MARGIN = 400.0f;
+  static constexpr float SLEEP_MARGIN = ACTIVE_MARGIN + 256.0f;
+  static constexpr float CULL_MARGIN = 16.0f; // Overhang of health bars etc.
+  static constexpr float TARGET_ANCHOR = 0.7f; // Target height in the view
+
+  Camera(float viewWidth, float viewHeight);
+
+  void setWorldSize(float width, float height);
+  // Returns how far the view moved
+  Vector2 follow(const Vector2 &target);
+
+  const WorldRect &getView() const { return view; }
+  const WorldRect &getWorld() const { return world; }
+  WorldRect getActiveRegion() const { return view.expanded(ACTIVE_MARGIN); }
+  WorldRect getSleepRegion() const { return view.expanded(SLEEP_MARGIN); }
+  WorldRect getCullRect() const { return view.expanded(CULL_MARGIN); }
+
+  // Whole-pixel view origin; everything drawn in world space is shifted
+  // by it (see Draw::setOffset)
+  int getOffsetX() const { return static_cast<int>(view.x); }
+  int getOffsetY() const { return static_cast<int>(view.y); }
+
+  bool isVisible(const SDL_Rect &box) const {
+    return getCullRect().overlaps(box);
+  }
+  Vector2 worldToScreen(const Vector2 &p) const {
+    return Vector2(p.x - getOffsetX(), p.y - getOffsetY());
+  }
+
+private:
+  WorldRect view;
+  WorldRect world;
+};
+
+#endif // CAMERA_H
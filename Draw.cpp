@@ -0,0 +1,184 @@
+#include "Draw.h"
+#include "DrawCapture.h"
+#include "Log.h"
+#include <memory>
+#include <vector>
+
+namespace Draw {
+
+namespace {
+Stats stats;
+int offsetX = 0;
+int offsetY = 0;
+std::vector<SDL_Rect> shifted; // Reused for offset batches
+std::vector<SDL_Vertex> shiftedVertices;
+std::unique_ptr<DrawCaptureWriter> capture;
+
+SDL_Rect shift(const SDL_Rect &rect) {
+  return {rect.x - offsetX, rect.y - offsetY, rect.w, rect.h};
+}
+
+// The replay substitutes a texture of the same size and state
+CaptureTexture captureTexture(SDL_Texture *texture) {
+  CaptureTexture t = {0, 0, SDL_BLENDMODE_NONE, {255, 255, 255, 255}};
+  SDL_QueryTexture(texture, nullptr, nullptr, &t.width, &t.height);
+  SDL_GetTextureBlendMode(texture, &t.blendMode);
+  SDL_GetTextureColorMod(texture, &t.mod.r, &t.mod.g, &t.mod.b);
+  SDL_GetTextureAlphaMod(texture, &t.mod.a);
+  return t;
+}
+} // namespace
+
+void setOffset(int x, int y) {
+  offsetX = x;
+  offsetY = y;
+}
+
+void setColor(SDL_Renderer *renderer, Uint8 r, Uint8 g, Uint8 b, Uint8 a) {
+  if (capture)
+    capture->setColor(r, g, b, a);
+  SDL_SetRenderDrawColor(renderer, r, g, b, a);
+}
+
+void setBlendMode(SDL_Renderer *renderer, SDL_BlendMode mode) {
+  if (capture)
+    capture->setBlendMode(mode);
+  SDL_SetRenderDrawBlendMode(renderer, mode);
+}
+
+void clear(SDL_Renderer *renderer) {
+  stats.drawCalls++;
+  if (capture)
+    capture->clear();
+  SDL_RenderClear(renderer);
+}
+
+void fillRect(SDL_Renderer *renderer, const SDL_Rect *rect) {
+  stats.drawCalls++;
+  stats.primitives++;
+  if (rect && (offsetX | offsetY)) {
+    SDL_Rect moved = shift(*rect);
+    if (capture)
+      capture->fillRect(&moved);
+    SDL_RenderFillRect(renderer, &moved);
+    return;
+  }
+  if (capture)
+    capture->fillRect(rect);
+  SDL_RenderFillRect(renderer, rect);
+}
+
+void fillRects(SDL_Renderer *renderer, const SDL_Rect *rects, int count) {
+  if (count <= 0)
+    return;
+  stats.drawCalls++;
+  stats.primitives += count;
+  if (offsetX | offsetY) {
+    shifted.resize(count);
+    for (int i = 0; i < count; i++) {
+      shifted[i] = shift(rects[i]);
+    }
+    rects = shifted.data();
+  }
+  if (capture)
+    capture->fillRects(rects, count);
+  SDL_RenderFillRects(renderer, rects, count);
+}
+
+void drawRect(SDL_Renderer *renderer, const SDL_Rect *rect) {
+  stats.drawCalls++;
+  stats.primitives++;
+  if (rect && (offsetX | offsetY)) {
+    SDL_Rect moved = shift(*rect);
+    if (capture)
+      capture->drawRect(&moved);
+    SDL_RenderDrawRect(renderer, &moved);
+    return;
+  }
+  if (capture)
+    capture->drawRect(rect);
+  SDL_RenderDrawRect(renderer, rect);
+}
+
+void drawLine(SDL_Renderer *renderer, int x1, int y1, int x2, int y2) {
+  stats.drawCalls++;
+  stats.primitives++;
+  x1 -= offsetX;
+  y1 -= offsetY;
+  x2 -= offsetX;
+  y2 -= offsetY;
+  if (capture)
+    capture->drawLine(x1, y1, x2, y2);
+  SDL_RenderDrawLine(renderer, x1, y1, x2, y2);
+}
+
+void drawPoint(SDL_Renderer *renderer, int x, int y) {
+  stats.drawCalls++;
+  stats.primitives++;
+  x -= offsetX;
+  y -= offsetY;
+  if (capture)
+    capture->drawPoint(x, y);
+  SDL_RenderDrawPoint(renderer, x, y);
+}
+
+void copy(SDL_Renderer *renderer, SDL_Texture *texture, const SDL_Rect *source,
+          const SDL_Rect *destination) {
+  stats.drawCalls++;
+  stats.primitives++;
+  SDL_Rect moved;
+  if (destination && (offsetX | offsetY)) {
+    moved = shift(*destination);
+    destination = &moved;
+  }
+  if (capture)
+    capture->copy(captureTexture(texture), source, destination);
+  SDL_RenderCopy(renderer, texture, source, destination);
+}
+
+void geometry(SDL_Renderer *renderer, SDL_Texture *texture,
+              const SDL_Vertex *vertices, int count) {
+  if (count <= 0)
+    return;
+  stats.drawCalls++;
+  stats.primitives += count / 3;
+  if (offsetX | offsetY) {
+    shiftedVertices.assign(vertices, vertices + count);
+    for (SDL_Vertex &v : shiftedVertices) {
+      v.position.x -= offsetX;
+      v.position.y -= offsetY;
+    }
+    vertices = shiftedVertices.data();
+  }
+  if (capture)
+    capture->geometry(captureTexture(texture), vertices, count);
+  SDL_RenderGeometry(renderer, texture, vertices, count, nullptr, 0);
+}
+
+void flush(SDL_Renderer *renderer) { SDL_RenderFlush(renderer); }
+
+void present(SDL_Renderer *renderer) {
+  if (capture && !capture->present()) {
+    LOG_ERROR("render", "Draw capture write failed, capture stopped");
+    stopCapture();
+  }
+  SDL_RenderPresent(renderer);
+}
+
+bool startCapture(const char *path, int width, int height) {
+  auto writer = std::make_unique<DrawCaptureWriter>();
+  if (!writer->open(path, width, height))
+    return false;
+  capture = std::move(writer);
+  return true;
+}
+
+void stopCapture() { capture.reset(); }
+
+const DrawCaptureWriter *getCapture() { return capture.get(); }
+
+const Stats &getStats() { return stats; }
+
+void resetStats() { stats = Stats(); }
+
+} // namespace Draw
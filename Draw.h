@@ -0,0 +1,54 @@
+#ifndef DRAW_H
+#define DRAW_H
+
+#include <SDL2/SDL.h>
+#include <cstdint>
+
+class DrawCaptureWriter;
+
+// Thin layer over the SDL_Render* calls used by the game. Everything that
+// draws goes through here, so per-frame draw statistics (and anything else
+// that must see every draw) live in one place.
+namespace Draw {
+
+struct Stats {
+  uint64_t drawCalls = 0; // Fill/line/point/rect/texture submissions
+  uint64_t primitives = 0; // Shapes, counting each rect of a batch
+};
+
+// World-to-screen shift subtracted from every shape and copy destination
+// drawn until it is reset to 0, 0 (clear() is unaffected)
+void setOffset(int x, int y);
+
+void setColor(SDL_Renderer *renderer, Uint8 r, Uint8 g, Uint8 b, Uint8 a);
+void setBlendMode(SDL_Renderer *renderer, SDL_BlendMode mode);
+
+void clear(SDL_Renderer *renderer);
+void fillRect(SDL_Renderer *renderer, const SDL_Rect *rect);
+void fillRects(SDL_Renderer *renderer, const SDL_Rect *rects, int count);
+void drawRect(SDL_Renderer *renderer, const SDL_Rect *rect);
+void drawLine(SDL_Renderer *renderer, int x1, int y1, int x2, int y2);
+void drawPoint(SDL_Renderer *renderer, int x, int y);
+void copy(SDL_Renderer *renderer, SDL_Texture *texture, const SDL_Rect *source,
+          const SDL_Rect *destination);
+// Textured triangle list, three vertices per triangle
+void geometry(SDL_Renderer *renderer, SDL_Texture *texture,
+              const SDL_Vertex *vertices, int count);
+// Runs queued draws now rather than inside present()
+void flush(SDL_Renderer *renderer);
+void present(SDL_Renderer *renderer);
+
+// Records every draw from here on, in window coordinates after the offset,
+// into a file for tools/draw_replay (see DrawCapture.h). Frames are written
+// at each present.
+bool startCapture(const char *path, int width, int height);
+void stopCapture();
+const DrawCaptureWriter *getCapture(); // nullptr when not capturing
+
+// Counts since the last resetStats()
+const Stats &getStats();
+void resetStats();
+
+} // namespace Draw
+
+#endif // DRAW_H
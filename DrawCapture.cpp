@@ -0,0 +1,443 @@
+#include "DrawCapture.h"
+#include <cstring>
+
+namespace {
+
+const char MAGIC[4] = {'S', 'F', 'D', 'C'};
+
+void putU32(uint8_t *out, uint32_t value) {
+  for (int i = 0; i < 4; i++) {
+    out[i] = static_cast<uint8_t>(value >> (8 * i));
+  }
+}
+
+uint32_t getU32(const uint8_t *in) {
+  return in[0] | (in[1] << 8) | (in[2] << 16) | (uint32_t(in[3]) << 24);
+}
+
+// Geometry vertices in SDL_Vertex order: x, y as little endian floats,
+// r, g, b, a bytes, then u, v
+constexpr size_t VERTEX_BYTES = 20;
+
+void putF32(uint8_t *out, float value) {
+  uint32_t bits;
+  std::memcpy(&bits, &value, sizeof(bits));
+  putU32(out, bits);
+}
+
+float getF32(const uint8_t *in) {
+  uint32_t bits = getU32(in);
+  float value;
+  std::memcpy(&value, &bits, sizeof(value));
+  return value;
+}
+
+// Bounds-checked reader over the loaded file
+struct Cursor {
+  const uint8_t *data;
+  size_t size;
+  size_t pos;
+  bool failed;
+
+  uint8_t byte() {
+    if (pos >= size) {
+      failed = true;
+      return 0;
+    }
+    return data[pos++];
+  }
+
+  uint32_t varint() {
+    uint32_t value = 0;
+    for (int shift = 0; shift < 35; shift += 7) {
+      uint8_t b = byte();
+      value |= uint32_t(b & 0x7f) << shift;
+      if (!(b & 0x80))
+        return value;
+    }
+    failed = true;
+    return 0;
+  }
+
+  int32_t signedVarint() {
+    uint32_t zigzag = varint();
+    return static_cast<int32_t>((zigzag >> 1) ^ (~(zigzag & 1) + 1));
+  }
+
+  SDL_Rect rect() {
+    SDL_Rect r;
+    r.x = signedVarint();
+    r.y = signedVarint();
+    r.w = signedVarint();
+    r.h = signedVarint();
+    return r;
+  }
+
+  // Older captures have no texture state: SDL's defaults
+  CaptureTexture texture(uint32_t version) {
+    CaptureTexture t = {0, 0, SDL_BLENDMODE_NONE, {255, 255, 255, 255}};
+    t.width = static_cast<int>(varint());
+    t.height = static_cast<int>(varint());
+    if (version >= 3) {
+      t.blendMode = static_cast<SDL_BlendMode>(varint());
+      t.mod = {byte(), byte(), byte(), byte()};
+    }
+    return t;
+  }
+};
+
+} // namespace
+
+const char *drawOpName(DrawOp op) {
+  switch (op) {
+  case DrawOp::SetColor:
+    return "setColor";
+  case DrawOp::SetBlendMode:
+    return "setBlendMode";
+  case DrawOp::Clear:
+    return "clear";
+  case DrawOp::FillRect:
+    return "fillRect";
+  case DrawOp::FillTarget:
+    return "fillTarget";
+  case DrawOp::FillRects:
+    return "fillRects";
+  case DrawOp::DrawRect:
+    return "drawRect";
+  case DrawOp::DrawLine:
+    return "drawLine";
+  case DrawOp::DrawPoint:
+    return "drawPoint";
+  case DrawOp::Copy:
+    return "copy";
+  case DrawOp::Present:
+    return "present";
+  case DrawOp::Geometry:
+    return "geometry";
+  case DrawOp::DrawTarget:
+    return "drawTarget";
+  case DrawOp::Count:
+    break;
+  }
+  return "unknown";
+}
+
+DrawCaptureWriter::DrawCaptureWriter() : file(nullptr), frames(0), bytes(0) {}
+
+DrawCaptureWriter::~DrawCaptureWriter() { close(); }
+
+bool DrawCaptureWriter::open(const char *path, int width, int height) {
+  close();
+  file = std::fopen(path, "wb");
+  if (!file)
+    return false;
+
+  uint8_t header[16];
+  std::memcpy(header, MAGIC, 4);
+  putU32(header + 4, DRAW_CAPTURE_VERSION);
+  putU32(header + 8, static_cast<uint32_t>(width));
+  putU32(header + 12, static_cast<uint32_t>(height));
+  if (std::fwrite(header, 1, sizeof(header), file) != sizeof(header)) {
+    close();
+    return false;
+  }
+
+  frames = 0;
+  bytes = sizeof(header);
+  buffer.clear();
+  buffer.reserve(64 * 1024);
+  return true;
+}
+
+void DrawCaptureWriter::close() {
+  if (!file)
+    return;
+
+  // A partial frame is kept; the reader stops at the end of the data
+  if (!buffer.empty()) {
+    std::fwrite(buffer.data(), 1, buffer.size(), file);
+    buffer.clear();
+  }
+  std::fclose(file);
+  file = nullptr;
+}
+
+void DrawCaptureWriter::varint(uint32_t value) {
+  while (value >= 0x80) {
+    buffer.push_back(static_cast<uint8_t>(value | 0x80));
+    value >>= 7;
+  }
+  buffer.push_back(static_cast<uint8_t>(value));
+}
+
+void DrawCaptureWriter::signedVarint(int32_t value) {
+  varint((static_cast<uint32_t>(value) << 1) ^
+         static_cast<uint32_t>(value >> 31));
+}
+
+void DrawCaptureWriter::rect(const SDL_Rect &r) {
+  signedVarint(r.x);
+  signedVarint(r.y);
+  signedVarint(r.w);
+  signedVarint(r.h);
+}
+
+void DrawCaptureWriter::texture(const CaptureTexture &t) {
+  varint(static_cast<uint32_t>(t.width));
+  varint(static_cast<uint32_t>(t.height));
+  varint(static_cast<uint32_t>(t.blendMode));
+  buffer.push_back(t.mod.r);
+  buffer.push_back(t.mod.g);
+  buffer.push_back(t.mod.b);
+  buffer.push_back(t.mod.a);
+}
+
+void DrawCaptureWriter::setColor(Uint8 r, Uint8 g, Uint8 b, Uint8 a) {
+  op(DrawOp::SetColor);
+  buffer.push_back(r);
+  buffer.push_back(g);
+  buffer.push_back(b);
+  buffer.push_back(a);
+}
+
+void DrawCaptureWriter::setBlendMode(SDL_BlendMode mode) {
+  op(DrawOp::SetBlendMode);
+  varint(static_cast<uint32_t>(mode));
+}
+
+void DrawCaptureWriter::clear() { op(DrawOp::Clear); }
+
+void DrawCaptureWriter::fillRect(const SDL_Rect *r) {
+  if (!r) {
+    op(DrawOp::FillTarget);
+    return;
+  }
+  op(DrawOp::FillRect);
+  rect(*r);
+}
+
+void DrawCaptureWriter::fillRects(const SDL_Rect *rects, int count) {
+  op(DrawOp::FillRects);
+  varint(static_cast<uint32_t>(count));
+
+  // Batches are mostly nearby, equal-sized shapes: small deltas
+  SDL_Rect previous = {0, 0, 0, 0};
+  for (int i = 0; i < count; i++) {
+    const SDL_Rect &r = rects[i];
+    signedVarint(r.x - previous.x);
+    signedVarint(r.y - previous.y);
+    signedVarint(r.w - previous.w);
+    signedVarint(r.h - previous.h);
+    previous = r;
+  }
+}
+
+void DrawCaptureWriter::drawRect(const SDL_Rect *r) {
+  if (!r) {
+    op(DrawOp::DrawTarget);
+    return;
+  }
+  op(DrawOp::DrawRect);
+  rect(*r);
+}
+
+void DrawCaptureWriter::drawLine(int x1, int y1, int x2, int y2) {
+  op(DrawOp::DrawLine);
+  signedVarint(x1);
+  signedVarint(y1);
+  signedVarint(x2);
+  signedVarint(y2);
+}
+
+void DrawCaptureWriter::drawPoint(int x, int y) {
+  op(DrawOp::DrawPoint);
+  signedVarint(x);
+  signedVarint(y);
+}
+
+void DrawCaptureWriter::copy(const CaptureTexture &t, const SDL_Rect *source,
+                             const SDL_Rect *destination) {
+  op(DrawOp::Copy);
+  texture(t);
+  buffer.push_back(static_cast<uint8_t>((source ? 1 : 0) |
+                                        (destination ? 2 : 0)));
+  if (source) {
+    rect(*source);
+  }
+  if (destination) {
+    rect(*destination);
+  }
+}
+
+void DrawCaptureWriter::geometry(const CaptureTexture &t,
+                                 const SDL_Vertex *vertices, int count) {
+  op(DrawOp::Geometry);
+  texture(t);
+  varint(static_cast<uint32_t>(count));
+  size_t at = buffer.size();
+  buffer.resize(at + size_t(count) * VERTEX_BYTES);
+  for (int i = 0; i < count; i++, at += VERTEX_BYTES) {
+    const SDL_Vertex &vertex = vertices[i];
+    uint8_t *out = buffer.data() + at;
+    putF32(out, vertex.position.x);
+    putF32(out + 4, vertex.position.y);
+    out[8] = vertex.color.r;
+    out[9] = vertex.color.g;
+    out[10] = vertex.color.b;
+    out[11] = vertex.color.a;
+    putF32(out + 12, vertex.tex_coord.x);
+    putF32(out + 16, vertex.tex_coord.y);
+  }
+}
+
+bool DrawCaptureWriter::present() {
+  op(DrawOp::Present);
+  size_t written = std::fwrite(buffer.data(), 1, buffer.size(), file);
+  bool ok = written == buffer.size();
+  bytes += written;
+  frames++;
+  buffer.clear();
+  return ok;
+}
+
+bool loadDrawCapture(const char *path, DrawCapture &capture,
+                     std::string &error) {
+  FILE *file = std::fopen(path, "rb");
+  if (!file) {
+    error = std::string("can't open ") + path;
+    return false;
+  }
+
+  std::vector<uint8_t> data;
+  uint8_t chunk[64 * 1024];
+  size_t n;
+  while ((n = std::fread(chunk, 1, sizeof(chunk), file)) > 0) {
+    data.insert(data.end(), chunk, chunk + n);
+  }
+  std::fclose(file);
+
+  if (data.size() < 16 || std::memcmp(data.data(), MAGIC, 4) != 0) {
+    error = "not a draw capture";
+    return false;
+  }
+  uint32_t version = getU32(data.data() + 4);
+  if (version < 1 || version > DRAW_CAPTURE_VERSION) {
+    error = "unsupported capture version";
+    return false;
+  }
+
+  capture = DrawCapture();
+  capture.width = static_cast<int>(getU32(data.data() + 8));
+  capture.height = static_cast<int>(getU32(data.data() + 12));
+
+  Cursor in{data.data(), data.size(), 16, false};
+  while (in.pos < in.size) {
+    size_t start = in.pos;
+    DrawCommand command = {};
+    command.op = static_cast<DrawOp>(in.byte());
+    command.first = static_cast<uint32_t>(capture.rects.size());
+    size_t rectMark = capture.rects.size();
+    size_t vertexMark = capture.vertices.size();
+
+    switch (command.op) {
+    case DrawOp::SetColor:
+      for (int i = 0; i < 4; i++) {
+        command.value |= uint32_t(in.byte()) << (8 * i);
+      }
+      break;
+    case DrawOp::SetBlendMode:
+      command.value = in.varint();
+      break;
+    case DrawOp::Clear:
+    case DrawOp::FillTarget:
+    case DrawOp::DrawTarget:
+    case DrawOp::Present:
+      break;
+    case DrawOp::FillRect:
+    case DrawOp::DrawRect:
+    case DrawOp::DrawLine:
+      capture.rects.push_back(in.rect());
+      command.count = 1;
+      break;
+    case DrawOp::DrawPoint: {
+      SDL_Rect point = {0, 0, 0, 0};
+      point.x = in.signedVarint();
+      point.y = in.signedVarint();
+      capture.rects.push_back(point);
+      command.count = 1;
+      break;
+    }
+    case DrawOp::FillRects: {
+      command.count = in.varint();
+      if (command.count > in.size - in.pos) {
+        in.failed = true; // More rects than bytes left
+        break;
+      }
+      SDL_Rect previous = {0, 0, 0, 0};
+      for (uint32_t i = 0; i < command.count && !in.failed; i++) {
+        SDL_Rect delta = in.rect();
+        previous = {previous.x + delta.x, previous.y + delta.y,
+                    previous.w + delta.w, previous.h + delta.h};
+        capture.rects.push_back(previous);
+      }
+      break;
+    }
+    case DrawOp::Copy: {
+      command.texture = in.texture(version);
+      command.flags = in.byte();
+      for (int bit = 1; bit <= 2; bit <<= 1) {
+        if (command.flags & bit) {
+          capture.rects.push_back(in.rect());
+          command.count++;
+        }
+      }
+      break;
+    }
+    case DrawOp::Geometry: {
+      command.texture = in.texture(version);
+      command.first = static_cast<uint32_t>(capture.vertices.size());
+      command.count = in.varint();
+      size_t bytes = size_t(command.count) * VERTEX_BYTES;
+      if (in.failed || bytes > in.size - in.pos) {
+        in.failed = true;
+        break;
+      }
+      capture.vertices.resize(capture.vertices.size() + command.count);
+      for (uint32_t i = 0; i < command.count; i++, in.pos += VERTEX_BYTES) {
+        const uint8_t *raw = in.data + in.pos;
+        SDL_Vertex &vertex = capture.vertices[command.first + i];
+        vertex.position = {getF32(raw), getF32(raw + 4)};
+        vertex.color = {raw[8], raw[9], raw[10], raw[11]};
+        vertex.tex_coord = {getF32(raw + 12), getF32(raw + 16)};
+      }
+      break;
+    }
+    default:
+      in.failed = true;
+      break;
+    }
+
+    if (in.failed) {
+      // A truncated last frame (capture cut off) is dropped, not an error
+      if (capture.frames == 0) {
+        error = "corrupt capture at byte " + std::to_string(start);
+        return false;
+      }
+      capture.rects.resize(rectMark);
+      capture.vertices.resize(vertexMark);
+      break;
+    }
+
+    capture.commands.push_back(command);
+    if (command.op == DrawOp::Present) {
+      capture.frames++;
+    }
+  }
+
+  // Drop commands after the last present (incomplete frame)
+  while (!capture.commands.empty() &&
+         capture.commands.back().op != DrawOp::Present) {
+    capture.commands.pop_back();
+  }
+  return true;
+}
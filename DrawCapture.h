@@ -0,0 +1,119 @@
+#ifndef DRAW_CAPTURE_H
+#define DRAW_CAPTURE_H
+
+#include <SDL2/SDL.h>
+#include <cstdint>
+#include <cstdio>
+#include <string>
+#include <vector>
+
+// Binary draw-command stream written by `stellar_fury --capture PATH` and
+// replayed by tools/draw_replay.
+//
+// File: a 16-byte header (magic "SFDC", version, width, height as little
+// endian uint32), then one command after another: an opcode byte and its
+// operands. Coordinates are zigzag varints (1-2 bytes for on-screen
+// values), and the rects of a batch are delta coded against the previous
+// one. Floats are little endian IEEE 754. Present ends a frame.
+enum class DrawOp : uint8_t {
+  SetColor,     // r, g, b, a bytes
+  SetBlendMode, // varint SDL_BlendMode
+  Clear,
+  FillRect,
+  FillTarget,   // fillRect(nullptr): the whole target
+  FillRects,    // varint count, then rects
+  DrawRect,
+  DrawLine,     // x1, y1, x2, y2
+  DrawPoint,    // x, y
+  Copy,         // texture, flags, then the rects flags say are present
+  Present,
+  Geometry,     // texture, vertex count, then 20-byte vertices:
+                // float x, y, bytes r, g, b, a, float u, v
+  DrawTarget,   // drawRect(nullptr): the whole target's outline
+  Count
+};
+
+// A texture operand: varint w, h and (version 3) blend mode, then the
+// color and alpha mod as r, g, b, a bytes
+struct CaptureTexture {
+  int width;
+  int height;
+  SDL_BlendMode blendMode;
+  SDL_Color mod;
+};
+
+constexpr int DRAW_OP_COUNT = static_cast<int>(DrawOp::Count);
+// 2 added Geometry; 3 added texture blend/mod and DrawTarget
+constexpr uint32_t DRAW_CAPTURE_VERSION = 3;
+
+const char *drawOpName(DrawOp op);
+
+// Encodes commands into a per-frame buffer, written out at each present
+class DrawCaptureWriter {
+public:
+  DrawCaptureWriter();
+  ~DrawCaptureWriter();
+
+  DrawCaptureWriter(const DrawCaptureWriter &) = delete;
+  DrawCaptureWriter &operator=(const DrawCaptureWriter &) = delete;
+
+  bool open(const char *path, int width, int height);
+  void close();
+  bool isOpen() const { return file != nullptr; }
+
+  void setColor(Uint8 r, Uint8 g, Uint8 b, Uint8 a);
+  void setBlendMode(SDL_BlendMode mode);
+  void clear();
+  void fillRect(const SDL_Rect *rect);
+  void fillRects(const SDL_Rect *rects, int count);
+  void drawRect(const SDL_Rect *rect);
+  void drawLine(int x1, int y1, int x2, int y2);
+  void drawPoint(int x, int y);
+  void copy(const CaptureTexture &texture, const SDL_Rect *source,
+            const SDL_Rect *destination);
+  void geometry(const CaptureTexture &texture, const SDL_Vertex *vertices,
+                int count);
+  bool present(); // False if the frame couldn't be written
+
+  uint64_t getFrames() const { return frames; }
+  uint64_t getBytes() const { return bytes; }
+
+private:
+  void op(DrawOp code) { buffer.push_back(static_cast<uint8_t>(code)); }
+  void varint(uint32_t value);
+  void signedVarint(int32_t value);
+  void rect(const SDL_Rect &r);
+  void texture(const CaptureTexture &t);
+
+  FILE *file;
+  std::vector<uint8_t> buffer; // Current frame, reused
+  uint64_t frames;
+  uint64_t bytes;
+};
+
+// A decoded capture. Operands live in `rects`: a command's rects are
+// [first, first + count). Lines and points use x, y (and w, h as x2, y2).
+// Geometry's first and count index `vertices` instead.
+struct DrawCommand {
+  DrawOp op;
+  uint8_t flags;  // Copy: 1 = source rect, 2 = destination rect
+  uint32_t value; // SetColor: RGBA packed; SetBlendMode: mode
+  uint32_t first;
+  uint32_t count;
+  CaptureTexture texture; // Copy, Geometry (before version 3: no blending)
+};
+
+struct DrawCapture {
+  int width = 0;
+  int height = 0;
+  std::vector<DrawCommand> commands;
+  std::vector<SDL_Rect> rects;
+  std::vector<SDL_Vertex> vertices;
+  size_t frames = 0;
+};
+
+// Reads a whole capture; false with a message on a malformed file
+bool loadDrawCapture(const char *path, DrawCapture &capture,
+                     std::string &error);
+
+#endif // DRAW_CAPTURE_H
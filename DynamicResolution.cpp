@@ -0,0 +1,165 @@
+#include "DynamicResolution.h"
+#include "Draw.h"
+#include "Log.h"
+#include <algorithm>
+#include <cmath>
+#include <cstdio>
+#include <string>
+
+DynamicResolution::DynamicResolution(int w, int h,
+                                     const DynamicResolutionConfig &cfg)
+    : enabled(true), width(w), height(h), texture(nullptr), active(false),
+      disabled(false), scale(1.0f), budgetMs(1000.0 / 60), overFrames(0),
+      underFrames(0), settle(0), frames(0), scaledFrames(0), scaleSum(0),
+      lowestScale(1.0f), changes(0) {
+  setConfig(cfg);
+}
+
+DynamicResolution::~DynamicResolution() { release(); }
+
+void DynamicResolution::setEnabled(bool on) {
+  enabled = on;
+  if (!enabled) {
+    setScale(1.0f);
+  }
+}
+
+void DynamicResolution::setConfig(const DynamicResolutionConfig &cfg) {
+  config = cfg;
+  config.maxScale = std::clamp(config.maxScale, STEP, 1.0f);
+  config.minScale = std::clamp(config.minScale, STEP, config.maxScale);
+  scale = config.maxScale;
+  lowestScale = scale;
+}
+
+void DynamicResolution::setRefreshRate(int hz) {
+  if (hz <= 0)
+    hz = 60;
+  budgetMs = 1000.0 / hz;
+}
+
+bool DynamicResolution::begin(SDL_Renderer *renderer) {
+  active = false;
+  if (!enabled || disabled || scale >= 1.0f)
+    return false;
+
+  if (!texture) {
+    if (!SDL_RenderTargetSupported(renderer)) {
+      disabled = true;
+      return false;
+    }
+
+    // Linear filtering for the upscale; the hint is read at creation
+    const char *previous = SDL_GetHint(SDL_HINT_RENDER_SCALE_QUALITY);
+    std::string restore = previous ? previous : "0";
+    SDL_SetHint(SDL_HINT_RENDER_SCALE_QUALITY, "linear");
+    texture = SDL_CreateTexture(renderer, SDL_PIXELFORMAT_RGBA8888,
+                                SDL_TEXTUREACCESS_TARGET, width, height);
+    SDL_SetHint(SDL_HINT_RENDER_SCALE_QUALITY, restore.c_str());
+
+    if (!texture) {
+      LOG_WARN("render", "Dynamic resolution target failed: %s",
+               SDL_GetError());
+      disabled = true;
+      setScale(1.0f);
+      return false;
+    }
+    SDL_SetTextureBlendMode(texture, SDL_BLENDMODE_NONE);
+  }
+
+  if (SDL_SetRenderTarget(renderer, texture) != 0) {
+    LOG_WARN("render", "Dynamic resolution target failed: %s",
+             SDL_GetError());
+    release();
+    disabled = true;
+    setScale(1.0f);
+    return false;
+  }
+
+  // Setting a target resets the scale; the window's returns with it
+  SDL_RenderSetScale(renderer, scale, scale);
+  active = true;
+  return true;
+}
+
+void DynamicResolution::resolve(SDL_Renderer *renderer) {
+  if (!active)
+    return;
+  active = false;
+
+  SDL_SetRenderTarget(renderer, nullptr);
+
+  SDL_Rect source = {0, 0, static_cast<int>(std::ceil(width * scale)),
+                     static_cast<int>(std::ceil(height * scale))};
+  Draw::copy(renderer, texture, &source, nullptr);
+}
+
+void DynamicResolution::endFrame(double workMs) {
+  frames++;
+  scaleSum += scale;
+  if (scale < 1.0f) {
+    scaledFrames++;
+  }
+
+  if (!enabled || disabled)
+    return;
+
+  if (settle > 0) {
+    settle--;
+    return;
+  }
+
+  double high = budgetMs * config.highWater;
+  double low = budgetMs * config.lowWater;
+  overFrames = workMs > high ? overFrames + 1 : 0;
+  underFrames = workMs < low ? underFrames + 1 : 0;
+
+  if (overFrames >= config.dropFrames && scale > config.minScale) {
+    // Aim for the middle of the band; at least one step down
+    double target = (high + low) * 0.5;
+    float next = scale * static_cast<float>(std::sqrt(target / workMs));
+    setScale(std::min(next, scale - STEP));
+  } else if (underFrames >= config.raiseFrames && scale < config.maxScale) {
+    setScale(scale + STEP);
+  }
+}
+
+void DynamicResolution::setScale(float value) {
+  // Whole steps, so a rise undoes a drop exactly
+  value = std::round(value / STEP) * STEP;
+  value = std::clamp(value, config.minScale, config.maxScale);
+  if (!enabled || disabled) {
+    value = 1.0f;
+  }
+  if (value == scale)
+    return;
+
+  LOG_DEBUG("render", "Resolution scale %.2f -> %.2f", scale, value);
+  scale = value;
+  lowestScale = std::min(lowestScale, scale);
+  changes++;
+  overFrames = 0;
+  underFrames = 0;
+  settle = config.settleFrames;
+}
+
+void DynamicResolution::release() {
+  if (texture) {
+    SDL_DestroyTexture(texture);
+    texture = nullptr;
+  }
+  active = false;
+}
+
+void DynamicResolution::report(std::ostream &out) const {
+  if (frames == 0)
+    return;
+
+  char line[128];
+  std::snprintf(line, sizeof(line),
+                "Dynamic resolution: scale avg %.2f, low %.2f, %d changes, "
+                "%.1f%% of frames scaled",
+                scaleSum / frames, lowestScale, changes,
+                100.0 * scaledFrames / frames);
+  out << line << std::endl;
+}
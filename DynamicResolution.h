@@ -0,0 +1,92 @@
+#ifndef DYNAMIC_RESOLUTION_H
+#define DYNAMIC_RESOLUTION_H
+
+#include <SDL2/SDL.h>
+#include <cstdint>
+#include <ostream>
+
+struct DynamicResolutionConfig {
+  float minScale = 0.5f;
+  float maxScale = 1.0f;
+  float highWater = 0.9f; // Budget fraction that triggers a drop
+  float lowWater = 0.6f;  // Budget fraction the work must stay under to rise
+  int dropFrames = 3;     // Consecutive frames over highWater before dropping
+  int raiseFrames = 30;   // Consecutive frames under lowWater before rising
+  int settleFrames = 15;  // Frames ignored after each change
+};
+
+// Renders the world at a reduced resolution when frames run over budget.
+//
+// Below full scale the world is drawn into the top-left corner of an
+// offscreen target (SDL_RenderSetScale shrinks everything drawn) and
+// upscaled to the window with linear filtering before the HUD, which
+// stays at native resolution. At full scale it draws straight to the
+// window, so there is no extra copy when nothing is wrong.
+//
+// The controller watches the frame's work up to the present: update, draw
+// submission and the flush that runs the queued draws (the rasterization
+// itself with the software renderer). SDL_Renderer has no GPU timer
+// queries, so time spent inside a VSync'd present can't be told apart from
+// waiting for the vblank and is left out. A drop aims the work at the
+// middle of the band assuming cost scales with pixel count; rising is one
+// STEP at a time, and the gap between the water marks plus the settle
+// time keep the scale from oscillating.
+class DynamicResolution {
+public:
+  static constexpr float STEP = 0.05f;
+
+  DynamicResolution(int width, int height,
+                    const DynamicResolutionConfig &config =
+                        DynamicResolutionConfig());
+  ~DynamicResolution();
+
+  DynamicResolution(const DynamicResolution &) = delete;
+  DynamicResolution &operator=(const DynamicResolution &) = delete;
+
+  void setEnabled(bool on);
+  bool isEnabled() const { return enabled; }
+  void setConfig(const DynamicResolutionConfig &config);
+  const DynamicResolutionConfig &getConfig() const { return config; }
+  void setRefreshRate(int hz); // Budget is one refresh period
+
+  // Around the world's draws: begin() redirects them to the scaled target
+  // (false at full scale or without render targets), resolve() upscales
+  // them to the window. resolve() is a no-op if begin() didn't redirect.
+  bool begin(SDL_Renderer *renderer);
+  void resolve(SDL_Renderer *renderer);
+
+  // Feeds one frame's work (ms, up to the present) to the controller
+  void endFrame(double workMs);
+
+  float getScale() const { return scale; }
+  double getBudgetMs() const { return budgetMs; }
+
+  void release(); // Frees the target (device reset)
+  void report(std::ostream &out) const;
+
+private:
+  void setScale(float value);
+
+  DynamicResolutionConfig config;
+  bool enabled;
+  int width;
+  int height;
+  SDL_Texture *texture;
+  bool active;   // begin() redirected this frame
+  bool disabled; // No render targets; stay at full scale
+
+  float scale;
+  double budgetMs;
+  int overFrames;
+  int underFrames;
+  int settle;
+
+  // Run statistics
+  uint64_t frames;
+  uint64_t scaledFrames;
+  double scaleSum;
+  float lowestScale;
+  int changes;
+};
+
+#endif // DYNAMIC_RESOLUTION_H
@@ -1,133 +1,123 @@
 #include "Enemy.h"
-#include "Bullet.h"
+#include "AudioMixer.h"
+#include "Camera.h"
+#include "Draw.h"
+#include "FlowField.h"
 #include "Game.h"
 #include "Player.h"
+#include "ProjectileSystem.h"
 #include <cmath>
 
 Enemy::Enemy(float x, float y, EnemyType t)
-    : Entity(x, y, 30, 30), type(t), health(1), maxHealth(1), scoreValue(100),
-      shootTimer(0.0f), shootCooldown(2.0f), animTimer(0.0f) {
+    : Entity(x, y, enemyStats(t).width, enemyStats(t).height), type(t),
+      health(enemyStats(t).health), maxHealth(enemyStats(t).health),
+      scoreValue(enemyStats(t).scoreValue),
+      shootCooldown(enemyStats(t).shootCooldown), animTimer(0.0f) {
 
-  switch (type) {
-  case EnemyType::Drifter:
-    width = 30;
-    height = 30;
-    health = maxHealth = 1;
-    scoreValue = 100;
-    shootCooldown = 2.5f;
-    color = {255, 150, 50, 255}; // Orange
-    break;
+  color = enemyStats(t).color;
+}
 
-  case EnemyType::Hunter:
-    width = 35;
-    height = 35;
-    health = maxHealth = 2;
-    scoreValue = 200;
-    shootCooldown = 1.5f;
-    color = {255, 50, 100, 255}; // Magenta
-    break;
+template <EnemyType T> void Enemy::update(float deltaTime, Game &game) {
+  animTimer += deltaTime;
 
-  case EnemyType::Bomber:
-    width = 50;
-    height = 45;
-    health = maxHealth = 4;
-    scoreValue = 500;
-    shootCooldown = 3.0f;
-    color = {150, 50, 255, 255}; // Purple
-    break;
+  if (script) {
+    script.tick(*this, game, deltaTime);
+  } else if constexpr (T == EnemyType::Drifter) {
+    updateDrifter();
+  } else if constexpr (T == EnemyType::Hunter) {
+    updateHunter(game);
+  } else {
+    updateBomber();
   }
 
-  shootTimer = shootCooldown * 0.5f; // Start halfway to first shot
+  Entity::update(deltaTime);
+
+  // Deactivate once past the bottom of the world
+  if (position.y > game.getCamera().getWorld().bottom() + 100.0f) {
+    active = false;
+  }
 }
 
-void Enemy::update(float deltaTime, Game &game) {
-  animTimer += deltaTime;
+template <EnemyType T> void Enemy::render(SDL_Renderer *renderer) {
+  if constexpr (T == EnemyType::Drifter) {
+    renderDrifter(renderer);
+  } else if constexpr (T == EnemyType::Hunter) {
+    renderHunter(renderer);
+  } else {
+    renderBomber(renderer);
+  }
+}
+
+template void Enemy::update<EnemyType::Drifter>(float, Game &);
+template void Enemy::update<EnemyType::Hunter>(float, Game &);
+template void Enemy::update<EnemyType::Bomber>(float, Game &);
+template void Enemy::render<EnemyType::Drifter>(SDL_Renderer *);
+template void Enemy::render<EnemyType::Hunter>(SDL_Renderer *);
+template void Enemy::render<EnemyType::Bomber>(SDL_Renderer *);
 
+void Enemy::update(float deltaTime, Game &game) {
   switch (type) {
   case EnemyType::Drifter:
-    updateDrifter(deltaTime, game);
+    update<EnemyType::Drifter>(deltaTime, game);
     break;
   case EnemyType::Hunter:
-    updateHunter(deltaTime, game);
+    update<EnemyType::Hunter>(deltaTime, game);
     break;
   case EnemyType::Bomber:
-    updateBomber(deltaTime, game);
+    update<EnemyType::Bomber>(deltaTime, game);
     break;
   }
-
-  Entity::update(deltaTime);
-
-  // Deactivate if off screen (bottom)
-  if (position.y > 700) {
-    active = false;
-  }
 }
 
-void Enemy::updateDrifter(float deltaTime, Game &game) {
-  // Simple downward drift with slight horizontal wobble
-  velocity.y = 80.0f;
-  velocity.x = std::sin(animTimer * 2.0f) * 30.0f;
-
-  // Shoot occasionally
-  shootTimer -= deltaTime;
-  if (shootTimer <= 0) {
-    shootTimer = shootCooldown;
+void Enemy::updateDrifter() {
+  constexpr const EnemyStats &stats = enemyStats<EnemyType::Drifter>();
 
-    auto bullet = std::make_unique<Bullet>(position.x, position.y + height / 2,
-                                           0, 250.0f, false);
-    game.addBullet(std::move(bullet));
-  }
+  // Simple downward drift with slight horizontal wobble
+  velocity.y = stats.descentSpeed;
+  velocity.x = std::sin(animTimer * stats.wobbleFrequency) *
+               stats.wobbleAmplitude;
 }
 
-void Enemy::updateHunter(float deltaTime, Game &game) {
+void Enemy::updateHunter(Game &game) {
+  constexpr const EnemyStats &stats = enemyStats<EnemyType::Hunter>();
+
   // Move downward initially
-  velocity.y = 60.0f;
+  velocity.y = stats.descentSpeed;
 
-  // Track player horizontally if game is playing
+  // Steer along the shared flow field: toward the player, away from crowds
   if (game.getState() == GameState::Playing) {
-    // We need to get player position somehow
-    // For now, move toward center with some tracking
-    float targetX = game.getWidth() / 2.0f;
-    float diff = targetX - position.x;
-    velocity.x = diff * 0.5f;
-
-    // Clamp horizontal speed
-    if (velocity.x > 150)
-      velocity.x = 150;
-    if (velocity.x < -150)
-      velocity.x = -150;
-  }
-
-  // Shoot more aggressively
-  shootTimer -= deltaTime;
-  if (shootTimer <= 0) {
-    shootTimer = shootCooldown;
+    Vector2 steer = game.getFlowField().sample(position);
+    velocity.x = steer.x * 150.0f;
 
-    // Shoot downward
-    auto bullet = std::make_unique<Bullet>(position.x, position.y + height / 2,
-                                           0, 300.0f, false);
-    game.addBullet(std::move(bullet));
+    // Never climb back up; the field only speeds up or slows the descent
+    velocity.y += steer.y * stats.descentSpeed;
   }
 }
 
-void Enemy::updateBomber(float deltaTime, Game &game) {
+void Enemy::updateBomber() {
+  constexpr const EnemyStats &stats = enemyStats<EnemyType::Bomber>();
+
   // Slow, steady descent
-  velocity.y = 40.0f;
-  velocity.x = std::sin(animTimer * 0.8f) * 20.0f;
+  velocity.y = stats.descentSpeed;
+  velocity.x = std::sin(animTimer * stats.wobbleFrequency) *
+               stats.wobbleAmplitude;
+}
 
-  // Drop cluster bombs
-  shootTimer -= deltaTime;
-  if (shootTimer <= 0) {
-    shootTimer = shootCooldown;
+void Enemy::fire(Game &game) {
+  const EnemyStats &stats = enemyStats(type);
+  ProjectileSystem &projectiles = game.getEnemyProjectiles();
+  game.playSound(Sound::EnemyShot, position.x);
 
+  if (type == EnemyType::Bomber) {
     // Drop 3 bullets in a spread
-    for (int i = -1; i <= 1; i++) {
-      auto bullet = std::make_unique<Bullet>(position.x + i * 15.0f,
-                                             position.y + height / 2, i * 50.0f,
-                                             200.0f, false);
-      game.addBullet(std::move(bullet));
-    }
+    projectiles.emitSpread(position.x, position.y + height / 2, 0,
+                           stats.bulletSpeed, 3, 50.0f, 15.0f);
+    return;
   }
+
+  // Drifters and Hunters shoot straight down
+  projectiles.emitStraight(position.x, position.y + height / 2, 0,
+                           stats.bulletSpeed);
 }
 
 void Enemy::takeDamage(int amount) {
@@ -137,97 +127,101 @@ void Enemy::takeDamage(int amount) {
   }
 }
 
+void Enemy::restore(int savedHealth, float savedAnimTimer) {
+  health = savedHealth;
+  animTimer = savedAnimTimer;
+}
+
 void Enemy::render(SDL_Renderer *renderer) {
   switch (type) {
   case EnemyType::Drifter:
-    renderDrifter(renderer);
+    render<EnemyType::Drifter>(renderer);
     break;
   case EnemyType::Hunter:
-    renderHunter(renderer);
+    render<EnemyType::Hunter>(renderer);
     break;
   case EnemyType::Bomber:
-    renderBomber(renderer);
+    render<EnemyType::Bomber>(renderer);
     break;
   }
 }
 
 void Enemy::renderDrifter(SDL_Renderer *renderer) {
   // Diamond shape using rectangles
-  SDL_SetRenderDrawColor(renderer, color.r, color.g, color.b, color.a);
+  Draw::setColor(renderer, color.r, color.g, color.b, color.a);
 
   // Main body
   SDL_Rect body = {static_cast<int>(position.x - 12),
                    static_cast<int>(position.y - 12), 24, 24};
-  SDL_RenderFillRect(renderer, &body);
+  Draw::fillRect(renderer, &body);
 
   // Darker accent
-  SDL_SetRenderDrawColor(renderer, color.r / 2, color.g / 2, color.b / 2, 255);
+  Draw::setColor(renderer, color.r / 2, color.g / 2, color.b / 2, 255);
   SDL_Rect accent = {static_cast<int>(position.x - 6),
                      static_cast<int>(position.y - 6), 12, 12};
-  SDL_RenderFillRect(renderer, &accent);
+  Draw::fillRect(renderer, &accent);
 }
 
 void Enemy::renderHunter(SDL_Renderer *renderer) {
   // Aggressive angular shape
-  SDL_SetRenderDrawColor(renderer, color.r, color.g, color.b, color.a);
+  Draw::setColor(renderer, color.r, color.g, color.b, color.a);
 
   // Main body
   SDL_Rect body = {static_cast<int>(position.x - 15),
                    static_cast<int>(position.y - 12), 30, 24};
-  SDL_RenderFillRect(renderer, &body);
+  Draw::fillRect(renderer, &body);
 
   // Wings
   SDL_Rect leftWing = {static_cast<int>(position.x - 20),
                        static_cast<int>(position.y - 5), 8, 15};
   SDL_Rect rightWing = {static_cast<int>(position.x + 12),
                         static_cast<int>(position.y - 5), 8, 15};
-  SDL_RenderFillRect(renderer, &leftWing);
-  SDL_RenderFillRect(renderer, &rightWing);
+  Draw::fillRect(renderer, &leftWing);
+  Draw::fillRect(renderer, &rightWing);
 
   // Eye glow
   float pulse = 0.5f + 0.5f * std::sin(animTimer * 5.0f);
-  SDL_SetRenderDrawColor(renderer, 255, static_cast<Uint8>(255 * pulse), 255,
-                         255);
+  Draw::setColor(renderer, 255, static_cast<Uint8>(255 * pulse), 255, 255);
   SDL_Rect eye = {static_cast<int>(position.x - 3),
                   static_cast<int>(position.y - 8), 6, 6};
-  SDL_RenderFillRect(renderer, &eye);
+  Draw::fillRect(renderer, &eye);
 }
 
 void Enemy::renderBomber(SDL_Renderer *renderer) {
   // Large, bulky shape
-  SDL_SetRenderDrawColor(renderer, color.r, color.g, color.b, color.a);
+  Draw::setColor(renderer, color.r, color.g, color.b, color.a);
 
   // Main body
   SDL_Rect body = {static_cast<int>(position.x - 22),
                    static_cast<int>(position.y - 18), 44, 36};
-  SDL_RenderFillRect(renderer, &body);
+  Draw::fillRect(renderer, &body);
 
   // Top section
-  SDL_SetRenderDrawColor(renderer, color.r + 30, color.g + 30, color.b, 255);
+  Draw::setColor(renderer, color.r + 30, color.g + 30, color.b, 255);
   SDL_Rect top = {static_cast<int>(position.x - 12),
                   static_cast<int>(position.y - 24), 24, 10};
-  SDL_RenderFillRect(renderer, &top);
+  Draw::fillRect(renderer, &top);
 
   // Bomb bays (bottom)
-  SDL_SetRenderDrawColor(renderer, 50, 50, 50, 255);
+  Draw::setColor(renderer, 50, 50, 50, 255);
   for (int i = -1; i <= 1; i++) {
     SDL_Rect bay = {static_cast<int>(position.x + i * 12 - 4),
                     static_cast<int>(position.y + 14), 8, 8};
-    SDL_RenderFillRect(renderer, &bay);
+    Draw::fillRect(renderer, &bay);
   }
 
   // Health indicator (for multi-hit enemies)
   if (maxHealth > 1) {
     float healthPercent = static_cast<float>(health) / maxHealth;
-    SDL_SetRenderDrawColor(renderer, 255, 255, 255, 100);
+    Draw::setColor(renderer, 255, 255, 255, 100);
     SDL_Rect healthBg = {static_cast<int>(position.x - 20),
                          static_cast<int>(position.y - 30), 40, 4};
-    SDL_RenderFillRect(renderer, &healthBg);
+    Draw::fillRect(renderer, &healthBg);
 
-    SDL_SetRenderDrawColor(renderer, 100, 255, 100, 255);
+    Draw::setColor(renderer, 100, 255, 100, 255);
     SDL_Rect healthBar = {static_cast<int>(position.x - 20),
                           static_cast<int>(position.y - 30),
                           static_cast<int>(40 * healthPercent), 4};
-    SDL_RenderFillRect(renderer, &healthBar);
+    Draw::fillRect(renderer, &healthBar);
   }
 }
@@ -1,32 +1,88 @@
 #ifndef ENEMY_H
 #define ENEMY_H
 
+#include "EnemyScript.h"
+#include "EnemyType.h"
 #include "Entity.h"
+#include "TimingWheel.h"
 
 class Game;
 
-enum class EnemyType {
-  Drifter, // Floats down, fires occasionally
-  Hunter,  // Tracks player, aggressive
-  Bomber   // Large, drops cluster bombs
+// Per-type tuning, indexed by EnemyType
+struct EnemyStats {
+  float width;
+  float height;
+  int health;
+  int scoreValue;
+  float shootCooldown;
+  float descentSpeed;
+  float wobbleFrequency;
+  float wobbleAmplitude;
+  float bulletSpeed;
+  SDL_Color color;
+};
+
+constexpr EnemyStats ENEMY_STATS[ENEMY_TYPE_COUNT] = {
+    // Drifter - orange
+    {30, 30, 1, 100, 2.5f, 80.0f, 2.0f, 30.0f, 250.0f, {255, 150, 50, 255}},
+    // Hunter - magenta (horizontal motion comes from tracking, not wobble)
+    {35, 35, 2, 200, 1.5f, 60.0f, 0.0f, 0.0f, 300.0f, {255, 50, 100, 255}},
+    // Bomber - purple
+    {50, 45, 4, 500, 3.0f, 40.0f, 0.8f, 20.0f, 200.0f, {150, 50, 255, 255}},
+};
+
+template <EnemyType T> constexpr const EnemyStats &enemyStats() {
+  return ENEMY_STATS[static_cast<int>(T)];
+}
+
+inline const EnemyStats &enemyStats(EnemyType type) {
+  return ENEMY_STATS[static_cast<int>(type)];
+}
+
+// Stable reference to an enemy across bucket compaction (see EnemyBatches)
+struct EnemyHandle {
+  uint32_t slot = TimerHandle::INVALID;
+  uint32_t generation = 0;
 };
 
 class Enemy : public Entity {
 public:
   Enemy(float x, float y, EnemyType type);
 
+  // Type-specialized paths used by EnemyBatches (no per-enemy dispatch)
+  template <EnemyType T> void update(float deltaTime, Game &game);
+  template <EnemyType T> void render(SDL_Renderer *renderer);
+
+  // Dispatching versions for code holding an enemy of unknown type
   void update(float deltaTime, Game &game);
   void render(SDL_Renderer *renderer) override;
 
+  // Fires this enemy's weapon pattern; scheduled through Game's timers
+  void fire(Game &game);
+
   void takeDamage(int amount);
 
+  // Picks up where a dormant enemy left off (see WorldChunks)
+  void restore(int savedHealth, float savedAnimTimer);
+  int getHealth() const { return health; }
+  float getAnimTimer() const { return animTimer; }
+
   int getScoreValue() const { return scoreValue; }
   EnemyType getType() const { return type; }
+  float getShootCooldown() const { return shootCooldown; }
+
+  EnemyHandle getHandle() const { return handle; }
+  void setHandle(EnemyHandle h) { handle = h; }
+  TimerHandle &getFireTimer() { return fireTimer; }
+
+  // A script replaces the type's movement (and its fire timer, see Game)
+  void setScript(EnemyScript s) { script = std::move(s); }
+  bool hasScript() const { return static_cast<bool>(script); }
 
 private:
-  void updateDrifter(float deltaTime, Game &game);
-  void updateHunter(float deltaTime, Game &game);
-  void updateBomber(float deltaTime, Game &game);
+  void updateDrifter();
+  void updateHunter(Game &game);
+  void updateBomber();
 
   void renderDrifter(SDL_Renderer *renderer);
   void renderHunter(SDL_Renderer *renderer);
@@ -36,9 +92,12 @@ private:
   int health;
   int maxHealth;
   int scoreValue;
-  float shootTimer;
   float shootCooldown;
   float animTimer;
+
+  EnemyHandle handle;
+  TimerHandle fireTimer;
+  EnemyScript script;
 };
 
 #endif // ENEMY_H
@@ -0,0 +1,118 @@
+#include "EnemyBatches.h"
+
+namespace {
+
+template <EnemyType T>
+void updateBucket(EnemyBatches::Bucket &bucket, float deltaTime, Game &game) {
+  for (auto &enemy : bucket) {
+    enemy.update<T>(deltaTime, game);
+  }
+}
+
+template <EnemyType T>
+void renderBucket(EnemyBatches::Bucket &bucket, SDL_Renderer *renderer,
+                  const WorldRect &visible) {
+  for (auto &enemy : bucket) {
+    if (visible.overlaps(enemy.getBoundingBox())) {
+      enemy.render<T>(renderer);
+    }
+  }
+}
+
+} // namespace
+
+Enemy &EnemyBatches::spawn(float x, float y, EnemyType type) {
+  uint32_t slot;
+  if (!freeSlots.empty()) {
+    slot = freeSlots.back();
+    freeSlots.pop_back();
+  } else {
+    slot = static_cast<uint32_t>(locations.size());
+    locations.emplace_back();
+  }
+
+  Bucket &target = bucket(type);
+  Location &location = locations[slot];
+  location.index = static_cast<uint32_t>(target.size());
+  location.type = type;
+  location.live = true;
+
+  target.emplace_back(x, y, type);
+  target.back().setHandle(EnemyHandle{slot, location.generation});
+  return target.back();
+}
+
+Enemy *EnemyBatches::find(EnemyHandle handle) {
+  if (handle.slot >= locations.size())
+    return nullptr;
+
+  const Location &location = locations[handle.slot];
+  if (!location.live || location.generation != handle.generation)
+    return nullptr;
+
+  return &bucket(location.type)[location.index];
+}
+
+void EnemyBatches::update(float deltaTime, Game &game) {
+  updateBucket<EnemyType::Drifter>(bucket(EnemyType::Drifter), deltaTime,
+                                   game);
+  updateBucket<EnemyType::Hunter>(bucket(EnemyType::Hunter), deltaTime, game);
+  updateBucket<EnemyType::Bomber>(bucket(EnemyType::Bomber), deltaTime, game);
+}
+
+void EnemyBatches::render(SDL_Renderer *renderer, const WorldRect &visible) {
+  renderBucket<EnemyType::Drifter>(bucket(EnemyType::Drifter), renderer,
+                                   visible);
+  renderBucket<EnemyType::Hunter>(bucket(EnemyType::Hunter), renderer,
+                                  visible);
+  renderBucket<EnemyType::Bomber>(bucket(EnemyType::Bomber), renderer,
+                                  visible);
+}
+
+void EnemyBatches::removeInactive(TimingWheel &timers) {
+  for (auto &b : buckets) {
+    // Stable compaction that keeps the handle table pointing at survivors
+    size_t write = 0;
+    for (size_t read = 0; read < b.size(); read++) {
+      Enemy &enemy = b[read];
+
+      if (!enemy.isActive()) {
+        timers.cancel(enemy.getFireTimer());
+        releaseSlot(enemy.getHandle().slot);
+        continue;
+      }
+
+      if (write != read) {
+        b[write] = std::move(enemy);
+      }
+      locations[b[write].getHandle().slot].index =
+          static_cast<uint32_t>(write);
+      write++;
+    }
+    b.erase(b.begin() + write, b.end());
+  }
+}
+
+void EnemyBatches::clear() {
+  for (auto &b : buckets) {
+    for (auto &enemy : b) {
+      releaseSlot(enemy.getHandle().slot);
+    }
+    b.clear();
+  }
+}
+
+void EnemyBatches::releaseSlot(uint32_t slot) {
+  Location &location = locations[slot];
+  location.live = false;
+  location.generation++;
+  freeSlots.push_back(slot);
+}
+
+size_t EnemyBatches::size() const {
+  size_t total = 0;
+  for (const auto &b : buckets) {
+    total += b.size();
+  }
+  return total;
+}
@@ -0,0 +1,59 @@
+#ifndef ENEMY_BATCHES_H
+#define ENEMY_BATCHES_H
+
+#include "Camera.h"
+#include "Enemy.h"
+#include <array>
+#include <vector>
+
+class Game;
+
+// Enemies stored by value in one contiguous bucket per EnemyType, so each
+// update/render loop runs a single type-specialized body.
+//
+// Buckets are always visited in EnemyType order and each bucket keeps spawn
+// order (push_back + stable compaction), so iteration order - and with it
+// collision and kill order - is deterministic.
+//
+// Because compaction moves enemies, anything that must refer to one later
+// (e.g. a scheduled fire timer) holds an EnemyHandle resolved through find().
+class EnemyBatches {
+public:
+  using Bucket = std::vector<Enemy>;
+
+  Enemy &spawn(float x, float y, EnemyType type);
+
+  void update(float deltaTime, Game &game);
+  // Draws the enemies overlapping visible
+  void render(SDL_Renderer *renderer, const WorldRect &visible);
+
+  // Returns nullptr once the enemy has been removed
+  Enemy *find(EnemyHandle handle);
+
+  // Cancels the fire timer of every enemy it removes
+  void removeInactive(TimingWheel &timers);
+  void clear();
+
+  size_t size() const;
+  bool empty() const { return size() == 0; }
+
+  Bucket &bucket(EnemyType type) { return buckets[static_cast<int>(type)]; }
+  std::array<Bucket, ENEMY_TYPE_COUNT> &all() { return buckets; }
+  const std::array<Bucket, ENEMY_TYPE_COUNT> &all() const { return buckets; }
+
+private:
+  struct Location {
+    uint32_t generation = 0;
+    uint32_t index = 0;
+    EnemyType type = EnemyType::Drifter;
+    bool live = false;
+  };
+
+  void releaseSlot(uint32_t slot);
+
+  std::array<Bucket, ENEMY_TYPE_COUNT> buckets;
+  std::vector<Location> locations;
+  std::vector<uint32_t> freeSlots;
+};
+
+#endif // ENEMY_BATCHES_H
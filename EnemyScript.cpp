@@ -0,0 +1,97 @@
+#include "EnemyScript.h"
+#include "Camera.h"
+#include "Enemy.h"
+#include "Game.h"
+
+void *ScriptPool::allocate(size_t bytes) {
+  live++;
+  if (bytes > MAX_BLOCK) {
+    heapFallbacks++;
+    return ::operator new(bytes);
+  }
+
+  size_t sizeClass = classOf(bytes);
+  if (!freeLists[sizeClass]) {
+    grow(sizeClass);
+  }
+  FreeBlock *block = freeLists[sizeClass];
+  freeLists[sizeClass] = block->next;
+  return block;
+}
+
+void ScriptPool::deallocate(void *block, size_t bytes) {
+  live--;
+  if (bytes > MAX_BLOCK) {
+    ::operator delete(block);
+    return;
+  }
+
+  size_t sizeClass = classOf(bytes);
+  auto *freed = static_cast<FreeBlock *>(block);
+  freed->next = freeLists[sizeClass];
+  freeLists[sizeClass] = freed;
+}
+
+void ScriptPool::reserve(size_t bytes, size_t count) {
+  if (bytes > MAX_BLOCK)
+    return;
+
+  size_t sizeClass = classOf(bytes);
+  size_t available = 0;
+  for (FreeBlock *b = freeLists[sizeClass]; b; b = b->next) {
+    available++;
+  }
+  for (; available < count; available += BLOCKS_PER_SLAB) {
+    grow(sizeClass);
+  }
+}
+
+void ScriptPool::grow(size_t sizeClass) {
+  size_t blockSize = (sizeClass + 1) * BLOCK_ALIGN;
+  slabs.push_back(
+      std::make_unique<unsigned char[]>(blockSize * BLOCKS_PER_SLAB));
+  reservedBytes += blockSize * BLOCKS_PER_SLAB;
+
+  // Thread the new blocks onto the free list in address order
+  unsigned char *slab = slabs.back().get();
+  for (size_t i = BLOCKS_PER_SLAB; i-- > 0;) {
+    auto *block = reinterpret_cast<FreeBlock *>(slab + i * blockSize);
+    block->next = freeLists[sizeClass];
+    freeLists[sizeClass] = block;
+  }
+}
+
+EnemyScript bomberScript(ScriptPool &) {
+  ScriptContext &ctx = co_await EnemyScript::context();
+  constexpr const EnemyStats &stats = enemyStats<EnemyType::Bomber>();
+
+  // Come in from above to the upper third of the view
+  ctx.self->setVelocity(0, stats.descentSpeed * 2.0f);
+  co_await EnemyScript::until([&ctx] {
+    const WorldRect &view = ctx.game->getCamera().getView();
+    return ctx.self->getY() > view.y + view.h / 3;
+  });
+
+  for (int pass = 0; pass < 2; pass++) {
+    // Strafe toward the far side of the view
+    const WorldRect &view = ctx.game->getCamera().getView();
+    float direction = ctx.self->getX() < view.x + view.w / 2 ? 1.0f : -1.0f;
+    ctx.self->setVelocity(direction * 120.0f, 0);
+    co_await EnemyScript::delay(1.5f);
+
+    // Pause, then three volleys
+    ctx.self->setVelocity(0, 0);
+    co_await EnemyScript::delay(0.4f);
+    for (int volley = 0; volley < 3; volley++) {
+      ctx.self->fire(*ctx.game);
+      co_await EnemyScript::delay(0.35f);
+    }
+
+    // Dive down a step
+    ctx.self->setVelocity(0, stats.descentSpeed * 4.0f);
+    co_await EnemyScript::delay(0.6f);
+  }
+
+  // Keep diving until off the bottom of the world
+  ctx.self->setVelocity(0, stats.descentSpeed * 3.0f);
+}
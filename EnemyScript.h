@@ -0,0 +1,225 @@
+#ifndef ENEMY_SCRIPT_H
+#define ENEMY_SCRIPT_H
+
+#include <array>
+#include <coroutine>
+#include <cstddef>
+#include <cstdint>
+#include <exception>
+#include <memory>
+#include <utility>
+#include <vector>
+
+class Enemy;
+class Game;
+
+// Free-list allocator for coroutine frames, in 64-byte size classes up to
+// MAX_BLOCK. Blocks come from slabs of BLOCKS_PER_SLAB that are kept for
+// the pool's lifetime, so once the game has seen its peak number of scripts
+// spawning and finishing them never touches the global heap. Frames larger
+// than MAX_BLOCK fall back to the heap (counted in getHeapFallbacks()).
+//
+// Not thread-safe: each Game owns one and only its thread uses it.
+class ScriptPool {
+public:
+  static constexpr size_t BLOCK_ALIGN = 64;
+  static constexpr size_t MAX_BLOCK = 1024;
+  static constexpr size_t BLOCKS_PER_SLAB = 64;
+
+  ScriptPool() = default;
+  ScriptPool(const ScriptPool &) = delete;
+  ScriptPool &operator=(const ScriptPool &) = delete;
+
+  void *allocate(size_t bytes);
+  void deallocate(void *block, size_t bytes);
+
+  // Pre-allocates room for count blocks of bytes each
+  void reserve(size_t bytes, size_t count);
+
+  size_t getLive() const { return live; }
+  size_t getReservedBytes() const { return reservedBytes; }
+  uint64_t getHeapFallbacks() const { return heapFallbacks; }
+
+private:
+  static constexpr size_t CLASS_COUNT = MAX_BLOCK / BLOCK_ALIGN;
+
+  struct FreeBlock {
+    FreeBlock *next;
+  };
+
+  static size_t classOf(size_t bytes) {
+    return (bytes + BLOCK_ALIGN - 1) / BLOCK_ALIGN - 1;
+  }
+  void grow(size_t sizeClass);
+
+  std::array<FreeBlock *, CLASS_COUNT> freeLists{};
+  std::vector<std::unique_ptr<unsigned char[]>> slabs;
+  size_t live = 0;
+  size_t reservedBytes = 0;
+  uint64_t heapFallbacks = 0;
+};
+
+// What a script sees of the world while it runs. self is refreshed before
+// every resume (enemies move when their bucket compacts), so never keep it
+// across a co_await.
+struct ScriptContext {
+  Enemy *self = nullptr;
+  Game *game = nullptr;
+  float deltaTime = 0.0f;
+};
+
+// An enemy behaviour written as a coroutine, resumed once per tick by its
+// Enemy:
+//
+//   EnemyScript strafer(ScriptPool &pool) {
+//     ScriptContext &ctx = co_await EnemyScript::context();
+//     ctx.self->setVelocity(120, 0);
+//     co_await EnemyScript::delay(1.5f);
+//     co_await EnemyScript::until([&ctx] { return ctx.self->getY() > 300; });
+//     ...
+//   }
+//
+// Every script takes the ScriptPool as its first parameter; its frame is
+// allocated there (promise_type::operator new), never on the global heap.
+// Waiting on a delay or condition costs the owner a compare per tick
+// without resuming. When the body returns the enemy keeps its last
+// velocity.
+class EnemyScript {
+public:
+  struct promise_type {
+    ScriptContext context;
+    float wait = 0.0f;                   // Seconds left on a delay
+    bool (*condition)(void *) = nullptr; // Pending until(), if any
+    void *conditionState = nullptr;
+
+    // Frames carry a header recording their pool, so delete can find it
+    static constexpr size_t HEADER = alignof(std::max_align_t);
+
+    template <typename... Args>
+    static void *operator new(size_t size, ScriptPool &pool, Args &...) {
+      auto *block = static_cast<unsigned char *>(pool.allocate(size + HEADER));
+      *reinterpret_cast<ScriptPool **>(block) = &pool;
+      return block + HEADER;
+    }
+
+    static void operator delete(void *frame, size_t size) {
+      unsigned char *block = static_cast<unsigned char *>(frame) - HEADER;
+      (*reinterpret_cast<ScriptPool **>(block))
+          ->deallocate(block, size + HEADER);
+    }
+
+    EnemyScript get_return_object() {
+      return EnemyScript(
+          std::coroutine_handle<promise_type>::from_promise(*this));
+    }
+    std::suspend_always initial_suspend() noexcept { return {}; }
+    std::suspend_always final_suspend() noexcept { return {}; }
+    void return_void() {}
+    void unhandled_exception() { std::terminate(); }
+  };
+
+  using Handle = std::coroutine_handle<promise_type>;
+
+  // co_await context(): the script's ScriptContext, without suspending
+  struct ContextAwaiter {
+    ScriptContext *context = nullptr;
+
+    bool await_ready() const noexcept { return false; }
+    bool await_suspend(Handle handle) noexcept {
+      context = &handle.promise().context;
+      return false;
+    }
+    ScriptContext &await_resume() const noexcept { return *context; }
+  };
+
+  // co_await delay(seconds): resumes once that much game time has passed
+  struct DelayAwaiter {
+    float seconds;
+
+    bool await_ready() const noexcept { return seconds <= 0.0f; }
+    void await_suspend(Handle handle) const noexcept {
+      handle.promise().wait = seconds;
+    }
+    void await_resume() const noexcept {}
+  };
+
+  // co_await until(predicate): resumes on the first tick it holds. The
+  // awaiter lives in the frame while suspended, so the predicate needs no
+  // allocation.
+  template <typename Predicate> struct UntilAwaiter {
+    Predicate predicate;
+
+    bool await_ready() { return predicate(); }
+    void await_suspend(Handle handle) {
+      handle.promise().condition = &check;
+      handle.promise().conditionState = this;
+    }
+    void await_resume() const noexcept {}
+
+    static bool check(void *self) {
+      return static_cast<UntilAwaiter *>(self)->predicate();
+    }
+  };
+
+  static ContextAwaiter context() { return {}; }
+  static std::suspend_always nextTick() { return {}; }
+  static DelayAwaiter delay(float seconds) { return {seconds}; }
+  template <typename Predicate>
+  static UntilAwaiter<Predicate> until(Predicate predicate) {
+    return {std::move(predicate)};
+  }
+
+  EnemyScript() = default;
+  EnemyScript(EnemyScript &&other) noexcept
+      : handle(std::exchange(other.handle, nullptr)) {}
+  EnemyScript &operator=(EnemyScript &&other) noexcept {
+    if (this != &other) {
+      reset();
+      handle = std::exchange(other.handle, nullptr);
+    }
+    return *this;
+  }
+  ~EnemyScript() { reset(); }
+
+  explicit operator bool() const { return static_cast<bool>(handle); }
+  bool isDone() const { return !handle || handle.done(); }
+
+  // Advances the script by one tick of deltaTime
+  void tick(Enemy &self, Game &game, float deltaTime) {
+    if (isDone())
+      return;
+
+    promise_type &promise = handle.promise();
+    promise.context = {&self, &game, deltaTime};
+
+    if (promise.wait > 0.0f) {
+      promise.wait -= deltaTime;
+      if (promise.wait > 0.0f)
+        return;
+    }
+    if (promise.condition) {
+      if (!promise.condition(promise.conditionState))
+        return;
+      promise.condition = nullptr;
+    }
+    handle.resume();
+  }
+
+  void reset() {
+    if (handle) {
+      handle.destroy();
+      handle = nullptr;
+    }
+  }
+
+private:
+  explicit EnemyScript(Handle h) : handle(h) {}
+
+  Handle handle;
+};
+
+// Bomber pattern: enter the view, then strafe, pause, fire three volleys
+// and dive, twice, before diving off the bottom
+EnemyScript bomberScript(ScriptPool &pool);
+
+#endif // ENEMY_SCRIPT_H
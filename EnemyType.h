@@ -0,0 +1,14 @@
+#ifndef ENEMY_TYPE_H
+#define ENEMY_TYPE_H
+
+// Apart from Enemy.h so headers can size per-type tables without pulling
+// in the entity classes
+enum class EnemyType {
+  Drifter, // Floats down, fires occasionally
+  Hunter,  // Tracks player, aggressive
+  Bomber   // Large, drops cluster bombs
+};
+
+constexpr int ENEMY_TYPE_COUNT = 3;
+
+#endif // ENEMY_TYPE_H
@@ -1,4 +1,5 @@
 #include "Entity.h"
+#include "Draw.h"
 
 Entity::Entity(float x, float y, float w, float h)
     : position(x, y), velocity(0, 0), width(w), height(h), active(true),
@@ -7,9 +8,9 @@ Entity::Entity(float x, float y, float w, float h)
 void Entity::update(float deltaTime) { position += velocity * deltaTime; }
 
 void Entity::render(SDL_Renderer *renderer) {
-  SDL_SetRenderDrawColor(renderer, color.r, color.g, color.b, color.a);
+  Draw::setColor(renderer, color.r, color.g, color.b, color.a);
   SDL_Rect rect = getBoundingBox();
-  SDL_RenderFillRect(renderer, &rect);
+  Draw::fillRect(renderer, &rect);
 }
 
 bool Entity::collidesWith(const Entity &other) const {
@@ -0,0 +1,91 @@
+#include "FlowField.h"
+#include <algorithm>
+#include <cmath>
+
+FlowField::FlowField(float w, float h, const FlowFieldConfig &cfg)
+    : width(w), height(h), columns(0), rows(0), rebuildTimer(0.0f) {
+  setConfig(cfg);
+}
+
+void FlowField::setOrigin(const Vector2 &o) {
+  origin.x = std::floor(o.x / config.cellSize) * config.cellSize;
+  origin.y = std::floor(o.y / config.cellSize) * config.cellSize;
+}
+
+void FlowField::setConfig(const FlowFieldConfig &cfg) {
+  config = cfg;
+  if (config.cellSize < 1)
+    config.cellSize = 1;
+
+  columns = std::max(1, static_cast<int>(width) / config.cellSize +
+                            (static_cast<int>(width) % config.cellSize != 0));
+  rows = std::max(1, static_cast<int>(height) / config.cellSize +
+                         (static_cast<int>(height) % config.cellSize != 0));
+
+  density.assign(columns * rows, 0.0f);
+  flow.assign(columns * rows, Vector2(0, 0));
+  rebuildTimer = 0.0f; // Rebuild on the next tick
+}
+
+bool FlowField::tick(float deltaTime) {
+  rebuildTimer -= deltaTime;
+  if (rebuildTimer > 0)
+    return false;
+
+  rebuildTimer += config.updateInterval;
+  if (rebuildTimer < 0)
+    rebuildTimer = 0; // Don't try to catch up after a long frame
+  return true;
+}
+
+void FlowField::clearDensity() {
+  std::fill(density.begin(), density.end(), 0.0f);
+}
+
+void FlowField::deposit(const Vector2 &position) {
+  density[cellIndex(position)] += 1.0f;
+}
+
+void FlowField::rebuild(const Vector2 &target) {
+  const float half = config.cellSize * 0.5f;
+
+  for (int row = 0; row < rows; row++) {
+    int up = std::max(row - 1, 0);
+    int down = std::min(row + 1, rows - 1);
+
+    for (int col = 0; col < columns; col++) {
+      int left = std::max(col - 1, 0);
+      int right = std::min(col + 1, columns - 1);
+
+      // Attraction: unit vector from the cell center to the target
+      Vector2 center(origin.x + col * config.cellSize + half,
+                     origin.y + row * config.cellSize + half);
+      Vector2 attract = (target - center).normalized() * config.attraction;
+
+      // Repulsion: central-difference density gradient, pointing downhill
+      Vector2 repel(density[row * columns + left] -
+                        density[row * columns + right],
+                    density[up * columns + col] -
+                        density[down * columns + col]);
+      repel *= 0.5f * config.repulsion;
+
+      Vector2 steer = attract + repel;
+      if (steer.magnitudeSquared() > 1.0f) {
+        steer = steer.normalized();
+      }
+      flow[row * columns + col] = steer;
+    }
+  }
+}
+
+Vector2 FlowField::sample(const Vector2 &position) const {
+  return flow[cellIndex(position)];
+}
+
+int FlowField::cellIndex(const Vector2 &position) const {
+  int col = static_cast<int>(position.x - origin.x) / config.cellSize;
+  int row = static_cast<int>(position.y - origin.y) / config.cellSize;
+  col = std::clamp(col, 0, columns - 1);
+  row = std::clamp(row, 0, rows - 1);
+  return row * columns + col;
+}
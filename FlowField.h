@@ -0,0 +1,62 @@
+#ifndef FLOW_FIELD_H
+#define FLOW_FIELD_H
+
+#include "Vector2.h"
+#include <vector>
+
+struct FlowFieldConfig {
+  int cellSize = 40;           // Pixels per grid cell
+  float updateInterval = 0.1f; // Seconds between rebuilds
+  float attraction = 1.0f;     // Weight of the pull toward the target
+  float repulsion = 0.5f;      // Weight of the push away from crowding
+};
+
+// Coarse steering grid over the playfield, or in a scrolling world over the
+// active region around the camera (see setOrigin). Each rebuild combines a
+// unit attraction toward the target with a repulsion down the enemy density
+// gradient; steering agents then sample their cell in O(1) instead of
+// looking at each other.
+class FlowField {
+public:
+  FlowField(float width, float height,
+            const FlowFieldConfig &config = FlowFieldConfig());
+
+  void setConfig(const FlowFieldConfig &config);
+  const FlowFieldConfig &getConfig() const { return config; }
+
+  // World position of the grid's top-left corner, snapped to whole cells
+  // so a moving origin doesn't shift cell contents by fractions. Set it
+  // before a rebuild; agents outside the grid sample its edge cells.
+  void setOrigin(const Vector2 &origin);
+  const Vector2 &getOrigin() const { return origin; }
+
+  // Advances the rebuild clock; true when a rebuild is due this tick
+  bool tick(float deltaTime);
+
+  // Rebuild: clearDensity(), deposit() every agent, then rebuild(target)
+  void clearDensity();
+  void deposit(const Vector2 &position);
+  void rebuild(const Vector2 &target);
+
+  // Steering direction at a world position (magnitude <= 1)
+  Vector2 sample(const Vector2 &position) const;
+
+  int getColumns() const { return columns; }
+  int getRows() const { return rows; }
+
+private:
+  int cellIndex(const Vector2 &position) const;
+
+  FlowFieldConfig config;
+  float width;
+  float height;
+  Vector2 origin;
+  int columns;
+  int rows;
+  float rebuildTimer;
+
+  std::vector<float> density;
+  std::vector<Vector2> flow;
+};
+
+#endif // FLOW_FIELD_H
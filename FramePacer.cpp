@@ -0,0 +1,116 @@
+#include "FramePacer.h"
+#include <algorithm>
+
+FramePacer::FramePacer()
+    : lateInput(false), frequency(SDL_GetPerformanceFrequency()),
+      frameStart(0), presentStart(0), lastPresent(0), lastSleepTicks(0),
+      workTicks(), workIndex(0), events(), eventsWritten(0),
+      eventsPresented(0), lastLatencyTicks(-1), peakLatencyTicks(0) {
+  msPerTick = 1000.0 / frequency;
+  setRefreshRate(60);
+}
+
+void FramePacer::setRefreshRate(int hz) {
+  if (hz <= 0)
+    hz = 60;
+  period = frequency / hz;
+}
+
+void FramePacer::waitForWakeup() {
+  lastSleepTicks = 0;
+  if (!lateInput || lastPresent == 0)
+    return;
+
+  Uint64 work = static_cast<Uint64>(getWorkEstimateMs() / msPerTick);
+  if (work >= period)
+    return; // No slack: start right away
+
+  Uint64 wakeup = lastPresent + period - work;
+  Uint64 start = SDL_GetPerformanceCounter();
+  Uint64 now = start;
+
+  // Sleep in whole milliseconds while more than 2 ms remain (timer
+  // slack), then spin for the rest
+  const Uint64 twoMs = frequency / 500;
+  while (now < wakeup && wakeup - now > twoMs) {
+    SDL_Delay(static_cast<Uint32>((wakeup - now - twoMs) * msPerTick) + 1);
+    now = SDL_GetPerformanceCounter();
+  }
+  while (now < wakeup) {
+    now = SDL_GetPerformanceCounter();
+  }
+
+  lastSleepTicks = now - start;
+}
+
+void FramePacer::beginFrame() { frameStart = SDL_GetPerformanceCounter(); }
+
+void FramePacer::recordKey(const SDL_KeyboardEvent &event) {
+  if (event.repeat)
+    return;
+
+  // SDL stamps events in milliseconds when it receives them; carry that
+  // age over to the performance counter
+  Uint64 now = SDL_GetPerformanceCounter();
+  Uint32 ageMs = SDL_GetTicks() - event.timestamp;
+  Uint64 age = static_cast<Uint64>(ageMs) * frequency / 1000;
+
+  KeyEvent &slot = events[eventsWritten % EVENT_CAPACITY];
+  slot.inputTime = age < now ? now - age : now;
+  slot.presentTime = 0;
+  slot.scancode = event.keysym.scancode;
+  slot.pressed = event.state == SDL_PRESSED;
+  eventsWritten++;
+}
+
+void FramePacer::beginPresent() {
+  presentStart = SDL_GetPerformanceCounter();
+  workTicks[workIndex] = presentStart - frameStart;
+  workIndex = (workIndex + 1) % HISTORY;
+}
+
+void FramePacer::endPresent() {
+  lastPresent = SDL_GetPerformanceCounter();
+
+  // Events overwritten before being presented are simply skipped
+  uint64_t first = std::max(eventsPresented,
+                            eventsWritten > EVENT_CAPACITY
+                                ? eventsWritten - EVENT_CAPACITY
+                                : uint64_t(0));
+  if (first == eventsWritten)
+    return;
+
+  Uint64 latency = 0;
+  for (uint64_t i = first; i < eventsWritten; i++) {
+    KeyEvent &event = events[i % EVENT_CAPACITY];
+    event.presentTime = lastPresent;
+    latency = std::max(latency, lastPresent - event.inputTime);
+  }
+  eventsPresented = eventsWritten;
+
+  lastLatencyTicks = static_cast<int64_t>(latency);
+  peakLatencyTicks = std::max(peakLatencyTicks, latency);
+}
+
+double FramePacer::getWorkEstimateMs() const {
+  Uint64 longest = *std::max_element(workTicks, workTicks + HISTORY);
+  return longest * msPerTick + MARGIN_MS;
+}
+
+double FramePacer::getLastWorkMs() const {
+  return workTicks[(workIndex + HISTORY - 1) % HISTORY] * msPerTick;
+}
+
+double FramePacer::getLatencyMs() const {
+  return lastLatencyTicks < 0 ? -1.0 : lastLatencyTicks * msPerTick;
+}
+
+int FramePacer::getEventCount() const {
+  return static_cast<int>(
+      std::min<uint64_t>(eventsWritten, static_cast<uint64_t>(EVENT_CAPACITY)));
+}
+
+const FramePacer::KeyEvent &FramePacer::getEvent(int index) const {
+  uint64_t first = eventsWritten - getEventCount();
+  return events[(first + index) % EVENT_CAPACITY];
+}
@@ -0,0 +1,85 @@
+#ifndef FRAME_PACER_H
+#define FRAME_PACER_H
+
+#include <SDL2/SDL.h>
+#include <cstdint>
+
+// Frame pacing and input-to-present latency measurement.
+//
+// Classic pacing samples input at the top of the frame and then blocks in
+// the VSync'd present, so what is shown can be over a frame old. In late
+// input mode the pacer instead sleeps until the latest point that still
+// makes the next vblank (the last present plus one refresh period, minus
+// an estimate of the frame's work), so input is sampled, simulated and
+// presented with as little waiting in between as possible.
+//
+// The work estimate is the longest of the last HISTORY frames plus a
+// safety margin: a single slow frame pulls the wakeup earlier at once and
+// the pacer only creeps later again as it ages out.
+//
+// Key presses and releases are kept in a ring with the time SDL received
+// them. After each present, every event that frame consumed gets its
+// input-to-present latency; the frame's latency is its oldest event's.
+class FramePacer {
+public:
+  static constexpr int HISTORY = 32;
+  static constexpr int EVENT_CAPACITY = 256;
+  static constexpr double MARGIN_MS = 1.0;
+
+  struct KeyEvent {
+    Uint64 inputTime;   // Performance counter ticks
+    Uint64 presentTime; // 0 until presented
+    SDL_Scancode scancode;
+    bool pressed;
+  };
+
+  FramePacer();
+
+  void setLateInput(bool enabled) { lateInput = enabled; }
+  bool isLateInput() const { return lateInput; }
+  void setRefreshRate(int hz);
+
+  // Late input mode: sleeps until the wakeup point (no-op otherwise)
+  void waitForWakeup();
+
+  // Frame milestones, in order
+  void beginFrame();
+  void recordKey(const SDL_KeyboardEvent &event);
+  void beginPresent();
+  void endPresent();
+
+  double getWorkEstimateMs() const;
+  // Last frame's work, from beginFrame() to beginPresent()
+  double getLastWorkMs() const;
+  double getLastSleepMs() const { return lastSleepTicks * msPerTick; }
+  // Latency of the last frame that showed input, or -1 if none yet
+  double getLatencyMs() const;
+  // Longest latency since the last resetPeak()
+  double getPeakLatencyMs() const { return peakLatencyTicks * msPerTick; }
+  void resetPeak() { peakLatencyTicks = 0; }
+
+  // Recent key events, oldest first (up to EVENT_CAPACITY)
+  int getEventCount() const;
+  const KeyEvent &getEvent(int index) const;
+
+private:
+  bool lateInput;
+  double msPerTick;
+  Uint64 frequency;
+  Uint64 period; // Refresh period in ticks
+
+  Uint64 frameStart;
+  Uint64 presentStart;
+  Uint64 lastPresent; // End of the last present, taken as the vblank
+  Uint64 lastSleepTicks;
+  Uint64 workTicks[HISTORY];
+  int workIndex;
+
+  KeyEvent events[EVENT_CAPACITY];
+  uint64_t eventsWritten;
+  uint64_t eventsPresented;
+  int64_t lastLatencyTicks;
+  Uint64 peakLatencyTicks;
+};
+
+#endif // FRAME_PACER_H
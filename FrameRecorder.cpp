@@ -0,0 +1,444 @@
+#include "FrameRecorder.h"
+#include "Log.h"
+#include <algorithm>
+#include <cinttypes>
+#include <filesystem>
+
+namespace {
+
+constexpr size_t STORED_BLOCK = 65535; // Largest stored deflate block
+constexpr uint32_t ADLER_MOD = 65521;
+constexpr size_t ADLER_RUN = 5552; // Bytes before the sums can overflow
+
+struct CrcTable {
+  uint32_t entries[256];
+
+  CrcTable() {
+    for (uint32_t n = 0; n < 256; n++) {
+      uint32_t c = n;
+      for (int k = 0; k < 8; k++) {
+        c = (c & 1) ? 0xEDB88320u ^ (c >> 1) : c >> 1;
+      }
+      entries[n] = c;
+    }
+  }
+};
+
+uint32_t crc32(const uint8_t *data, size_t size) {
+  static const CrcTable table;
+  uint32_t c = 0xFFFFFFFFu;
+  for (size_t i = 0; i < size; i++) {
+    c = table.entries[(c ^ data[i]) & 0xFF] ^ (c >> 8);
+  }
+  return c ^ 0xFFFFFFFFu;
+}
+
+void put32(std::vector<uint8_t> &out, uint32_t value) {
+  out.push_back(static_cast<uint8_t>(value >> 24));
+  out.push_back(static_cast<uint8_t>(value >> 16));
+  out.push_back(static_cast<uint8_t>(value >> 8));
+  out.push_back(static_cast<uint8_t>(value));
+}
+
+// Writes the length placeholder and type; returns where the chunk starts
+size_t beginChunk(std::vector<uint8_t> &out, const char *type) {
+  size_t start = out.size();
+  put32(out, 0);
+  out.insert(out.end(), type, type + 4);
+  return start;
+}
+
+void endChunk(std::vector<uint8_t> &out, size_t start) {
+  uint32_t length = static_cast<uint32_t>(out.size() - start - 8);
+  for (int i = 0; i < 4; i++) {
+    out[start + i] = static_cast<uint8_t>(length >> (24 - 8 * i));
+  }
+  put32(out, crc32(out.data() + start + 4, length + 4));
+}
+
+// Filtered scanlines: a filter byte (0, none) per row, then its pixels
+size_t pngRawSize(int width, int height) {
+  return (size_t(width) * 3 + 1) * height;
+}
+
+size_t pngSize(int width, int height) {
+  size_t raw = pngRawSize(width, height);
+  size_t blocks = std::max<size_t>(1, (raw + STORED_BLOCK - 1) / STORED_BLOCK);
+  // Signature, IHDR, IDAT around zlib header + blocks + Adler-32, IEND
+  return 8 + 25 + 12 + 2 + blocks * 5 + raw + 4 + 12;
+}
+
+// Appends raw bytes as stored deflate blocks, keeping the Adler-32 sums
+class StoredDeflate {
+public:
+  StoredDeflate(std::vector<uint8_t> &out, size_t total)
+      : out(out), remaining(total), blockLeft(0), a(1), b(0) {}
+
+  void write(const uint8_t *data, size_t size) {
+    while (size > 0) {
+      if (blockLeft == 0) {
+        startBlock();
+      }
+      size_t take = std::min(size, blockLeft);
+      out.insert(out.end(), data, data + take);
+      adler(data, take);
+      data += take;
+      size -= take;
+      blockLeft -= take;
+      remaining -= take;
+    }
+  }
+
+  uint32_t checksum() const { return (b << 16) | a; }
+
+private:
+  void startBlock() {
+    size_t length = std::min(remaining, STORED_BLOCK);
+    out.push_back(length == remaining ? 1 : 0); // BFINAL, BTYPE 00
+    out.push_back(static_cast<uint8_t>(length));
+    out.push_back(static_cast<uint8_t>(length >> 8));
+    out.push_back(static_cast<uint8_t>(~length));
+    out.push_back(static_cast<uint8_t>(~length >> 8));
+    blockLeft = length;
+  }
+
+  void adler(const uint8_t *data, size_t size) {
+    while (size > 0) {
+      size_t run = std::min(size, ADLER_RUN);
+      for (size_t i = 0; i < run; i++) {
+        a += data[i];
+        b += a;
+      }
+      a %= ADLER_MOD;
+      b %= ADLER_MOD;
+      data += run;
+      size -= run;
+    }
+  }
+
+  std::vector<uint8_t> &out;
+  size_t remaining;
+  size_t blockLeft;
+  uint32_t a, b;
+};
+
+bool endsWith(const std::string &text, const char *suffix) {
+  size_t length = std::char_traits<char>::length(suffix);
+  return text.size() >= length &&
+         text.compare(text.size() - length, length, suffix) == 0;
+}
+
+uint8_t clampByte(int value) {
+  return static_cast<uint8_t>(std::clamp(value, 0, 255));
+}
+
+} // namespace
+
+void encodePng(const uint8_t *rgb, int width, int height,
+               std::vector<uint8_t> &out) {
+  out.clear();
+  out.reserve(pngSize(width, height));
+
+  static const uint8_t signature[8] = {0x89, 'P',  'N',  'G',
+                                       '\r', '\n', 0x1A, '\n'};
+  out.insert(out.end(), signature, signature + 8);
+
+  size_t chunk = beginChunk(out, "IHDR");
+  put32(out, static_cast<uint32_t>(width));
+  put32(out, static_cast<uint32_t>(height));
+  out.push_back(8); // Bit depth
+  out.push_back(2); // Truecolour
+  out.push_back(0); // Deflate
+  out.push_back(0); // Adaptive filtering
+  out.push_back(0); // Not interlaced
+  endChunk(out, chunk);
+
+  chunk = beginChunk(out, "IDAT");
+  out.push_back(0x78); // zlib: deflate, 32K window
+  out.push_back(0x01); // No preset dictionary, fastest level
+  StoredDeflate deflate(out, pngRawSize(width, height));
+  const uint8_t filter = 0;
+  size_t stride = size_t(width) * 3;
+  for (int y = 0; y < height; y++) {
+    deflate.write(&filter, 1);
+    deflate.write(rgb + y * stride, stride);
+  }
+  put32(out, deflate.checksum());
+  endChunk(out, chunk);
+
+  chunk = beginChunk(out, "IEND");
+  endChunk(out, chunk);
+}
+
+size_t yuv420Size(int width, int height) {
+  size_t chroma = size_t((width + 1) / 2) * ((height + 1) / 2);
+  return size_t(width) * height + 2 * chroma;
+}
+
+void rgbToYuv420(const uint8_t *rgb, int width, int height, uint8_t *out) {
+  size_t stride = size_t(width) * 3;
+  int chromaWidth = (width + 1) / 2;
+  int chromaHeight = (height + 1) / 2;
+  uint8_t *luma = out;
+  uint8_t *u = out + size_t(width) * height;
+  uint8_t *v = u + size_t(chromaWidth) * chromaHeight;
+
+  for (int y = 0; y < height; y++) {
+    const uint8_t *row = rgb + y * stride;
+    for (int x = 0; x < width; x++) {
+      const uint8_t *p = row + x * 3;
+      luma[x] = static_cast<uint8_t>((77 * p[0] + 150 * p[1] + 29 * p[2] +
+                                      128) >> 8);
+    }
+    luma += width;
+  }
+
+  // Odd edges reuse the last row or column
+  for (int cy = 0; cy < chromaHeight; cy++) {
+    const uint8_t *row0 = rgb + (2 * cy) * stride;
+    const uint8_t *row1 = rgb + std::min(2 * cy + 1, height - 1) * stride;
+    for (int cx = 0; cx < chromaWidth; cx++) {
+      int x0 = 2 * cx * 3;
+      int x1 = std::min(2 * cx + 1, width - 1) * 3;
+      int r = row0[x0] + row0[x1] + row1[x0] + row1[x1];
+      int g = row0[x0 + 1] + row0[x1 + 1] + row1[x0 + 1] + row1[x1 + 1];
+      int b = row0[x0 + 2] + row0[x1 + 2] + row1[x0 + 2] + row1[x1 + 2];
+      // Sums of four: the extra factor of 4 comes off in the shift
+      *u++ = clampByte(128 + ((-43 * r - 85 * g + 128 * b + 512) >> 10));
+      *v++ = clampByte(128 + ((128 * r - 107 * g - 21 * b + 512) >> 10));
+    }
+  }
+}
+
+FrameRecorder::FrameRecorder(const FrameRecorderConfig &config)
+    : config(config), recording(false), queueHead(0), queueCount(0),
+      stopping(false), encoded(0), writeFailures(0), bytes(0), encodeMs(0),
+      video(nullptr), nextWrite(0), frames(0), sequence(0), captured(0),
+      dropped(0), readFailures(0), lastUs(0), totalUs(0), peakUs(0) {
+  this->config.fps = std::max(1, config.fps);
+  this->config.every = std::max(1, config.every);
+  this->config.buffers = std::max(1, config.buffers);
+  this->config.threads = std::max(1, config.threads);
+  format = endsWith(config.path, ".y4m") ? RecordFormat::Y4m
+                                         : RecordFormat::PngSequence;
+}
+
+FrameRecorder::~FrameRecorder() { stop(); }
+
+bool FrameRecorder::start() {
+  if (recording)
+    return true;
+  if (config.width <= 0 || config.height <= 0)
+    return false;
+
+  if (format == RecordFormat::Y4m) {
+    video = std::fopen(config.path.c_str(), "wb");
+    if (!video)
+      return false;
+    // A rational rate, so every N of 60 Hz stays exact. The samples are
+    // full range; readers assume limited range unless told
+    if (std::fprintf(video,
+                     "YUV4MPEG2 W%d H%d F%d:%d Ip A1:1 C420jpeg "
+                     "XCOLORRANGE=FULL\n",
+                     config.width, config.height, config.fps,
+                     config.every) < 0) {
+      std::fclose(video);
+      video = nullptr;
+      return false;
+    }
+  } else {
+    std::error_code error;
+    std::filesystem::create_directories(config.path, error);
+    if (error)
+      return false;
+  }
+
+  size_t frameBytes = size_t(config.width) * config.height * 3;
+  slots.resize(config.buffers);
+  freeSlots.clear();
+  for (int i = config.buffers - 1; i >= 0; i--) {
+    slots[i].pixels.resize(frameBytes);
+    freeSlots.push_back(i);
+  }
+  queue.assign(config.buffers, -1);
+  queueHead = 0;
+  queueCount = 0;
+
+  scratch.resize(config.threads);
+  for (std::vector<uint8_t> &buffer : scratch) {
+    if (format == RecordFormat::Y4m) {
+      buffer.resize(yuv420Size(config.width, config.height));
+    } else {
+      buffer.reserve(pngSize(config.width, config.height));
+    }
+  }
+
+  stopping = false;
+  for (int i = 0; i < config.threads; i++) {
+    workers.emplace_back(&FrameRecorder::workerLoop, this, i);
+  }
+  recording = true;
+  return true;
+}
+
+void FrameRecorder::stop() {
+  if (!recording)
+    return;
+
+  {
+    std::lock_guard<std::mutex> lock(mutex);
+    stopping = true;
+  }
+  wake.notify_all();
+  for (std::thread &worker : workers) {
+    worker.join();
+  }
+  workers.clear();
+
+  if (video) {
+    if (std::fclose(video) != 0) {
+      writeFailures++;
+    }
+    video = nullptr;
+  }
+  recording = false;
+}
+
+void FrameRecorder::capture(SDL_Renderer *renderer) {
+  if (!recording || frames++ % config.every != 0)
+    return;
+
+  Uint64 start = SDL_GetPerformanceCounter();
+
+  int index = -1;
+  {
+    std::lock_guard<std::mutex> lock(mutex);
+    if (!freeSlots.empty()) {
+      index = freeSlots.back();
+      freeSlots.pop_back();
+    }
+  }
+
+  if (index < 0) {
+    // Every buffer is queued or encoding: skip rather than wait
+    dropped++;
+  } else {
+    Slot &slot = slots[index];
+    SDL_Rect area = {0, 0, config.width, config.height};
+    if (SDL_RenderReadPixels(renderer, &area, SDL_PIXELFORMAT_RGB24,
+                             slot.pixels.data(), config.width * 3) != 0) {
+      if (readFailures++ == 0) {
+        LOG_WARN("record", "Frame readback failed: %s", SDL_GetError());
+      }
+      releaseSlot(index);
+    } else {
+      slot.frame = frames - 1;
+      slot.sequence = sequence++;
+      {
+        std::lock_guard<std::mutex> lock(mutex);
+        queue[(queueHead + queueCount) % queue.size()] = index;
+        queueCount++;
+      }
+      wake.notify_one();
+      captured++;
+    }
+  }
+
+  lastUs = static_cast<double>(SDL_GetPerformanceCounter() - start) *
+           1000000.0 / static_cast<double>(SDL_GetPerformanceFrequency());
+  totalUs += lastUs;
+  peakUs = std::max(peakUs, lastUs);
+}
+
+void FrameRecorder::releaseSlot(int slot) {
+  std::lock_guard<std::mutex> lock(mutex);
+  freeSlots.push_back(slot);
+}
+
+void FrameRecorder::workerLoop(int worker) {
+  std::vector<uint8_t> &buffer = scratch[worker];
+
+  for (;;) {
+    int index;
+    {
+      std::unique_lock<std::mutex> lock(mutex);
+      wake.wait(lock, [this]() { return queueCount > 0 || stopping; });
+      // Stopping still drains the queue
+      if (queueCount == 0)
+        return;
+      index = queue[queueHead];
+      queueHead = (queueHead + 1) % queue.size();
+      queueCount--;
+    }
+
+    Uint64 start = SDL_GetPerformanceCounter();
+    const Slot &slot = slots[index];
+    bool ok;
+    size_t written;
+    if (format == RecordFormat::Y4m) {
+      rgbToYuv420(slot.pixels.data(), config.width, config.height,
+                  buffer.data());
+      uint64_t order = slot.sequence;
+      releaseSlot(index); // The planes are all the write needs
+      ok = writeY4m(order, buffer);
+      written = buffer.size() + 6;
+    } else {
+      ok = writePng(slot, buffer);
+      written = buffer.size();
+      releaseSlot(index);
+    }
+    double ms = static_cast<double>(SDL_GetPerformanceCounter() - start) *
+                1000.0 / static_cast<double>(SDL_GetPerformanceFrequency());
+
+    std::lock_guard<std::mutex> lock(mutex);
+    if (ok) {
+      encoded++;
+      bytes += written;
+      encodeMs += ms;
+    } else {
+      writeFailures++;
+    }
+  }
+}
+
+bool FrameRecorder::writePng(const Slot &slot, std::vector<uint8_t> &out) {
+  encodePng(slot.pixels.data(), config.width, config.height, out);
+
+  char path[1024];
+  std::snprintf(path, sizeof(path), "%s/frame_%06" PRIu64 ".png",
+                config.path.c_str(), slot.frame);
+  FILE *file = std::fopen(path, "wb");
+  if (!file)
+    return false;
+  bool ok = std::fwrite(out.data(), 1, out.size(), file) == out.size();
+  return std::fclose(file) == 0 && ok;
+}
+
+bool FrameRecorder::writeY4m(uint64_t order, const std::vector<uint8_t> &yuv) {
+  std::unique_lock<std::mutex> lock(videoMutex);
+  videoTurn.wait(lock, [this, order]() { return nextWrite == order; });
+
+  bool ok = std::fwrite("FRAME\n", 1, 6, video) == 6 &&
+            std::fwrite(yuv.data(), 1, yuv.size(), video) == yuv.size();
+  nextWrite++;
+  lock.unlock();
+  videoTurn.notify_all();
+  return ok;
+}
+
+FrameRecorderStats FrameRecorder::getStats() const {
+  FrameRecorderStats stats;
+  stats.captured = captured;
+  stats.dropped = dropped;
+  stats.lastUs = lastUs;
+  stats.peakUs = peakUs;
+  uint64_t attempts = captured + dropped + readFailures;
+  stats.meanUs = attempts ? totalUs / static_cast<double>(attempts) : 0;
+
+  std::lock_guard<std::mutex> lock(mutex);
+  stats.encoded = encoded;
+  stats.failed = readFailures + writeFailures;
+  stats.bytes = bytes;
+  stats.encodeMeanMs = encoded ? encodeMs / static_cast<double>(encoded) : 0;
+  return stats;
+}
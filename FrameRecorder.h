@@ -0,0 +1,131 @@
+#ifndef FRAME_RECORDER_H
+#define FRAME_RECORDER_H
+
+#include <SDL2/SDL.h>
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <cstdio>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+// A .y4m path records one raw YUV 4:2:0 video, anything else is a
+// directory of numbered PNGs
+enum class RecordFormat { PngSequence, Y4m };
+
+struct FrameRecorderConfig {
+  std::string path;
+  int width = 0;   // Renderer output size
+  int height = 0;
+  int fps = 60;    // Frames the game shows per second
+  int every = 1;   // Record one frame in every (Y4M rate fps:every)
+  int buffers = 8; // Readback ring
+  int threads = 2; // Encoders
+};
+
+struct FrameRecorderStats {
+  uint64_t captured; // Read back and queued
+  uint64_t dropped;  // No free buffer: the encoders were behind
+  uint64_t encoded;  // Written out
+  uint64_t failed;   // Readback or write errors
+  uint64_t bytes;
+  // Game thread cost per recorded frame, readback included
+  double lastUs, meanUs, peakUs;
+  double encodeMeanMs; // Per frame, on a worker
+};
+
+// Records the rendered frames of a run for bug reports.
+//
+// capture() runs on the game thread just before the present: it takes a
+// free buffer from a fixed ring, reads the frame back into it and queues
+// it. A pool of worker threads encodes the queue in order and returns the
+// buffers. The queue is bounded by the ring, and capture() never waits
+// for a worker: with every buffer in flight the frame is dropped and
+// counted instead.
+//
+// PNG frames are named by frame number, so gaps show skipped and dropped
+// frames. They are stored uncompressed (about 1.4 MB at 800x600), which
+// keeps encoding to a copy and two checksums. The Y4M stream has no gaps:
+// a dropped frame shortens the video.
+//
+// Buffers and per-worker scratch are allocated in start(), so recording
+// doesn't allocate after that.
+class FrameRecorder {
+public:
+  explicit FrameRecorder(const FrameRecorderConfig &config);
+  ~FrameRecorder();
+
+  FrameRecorder(const FrameRecorder &) = delete;
+  FrameRecorder &operator=(const FrameRecorder &) = delete;
+
+  // Opens the output and starts the workers; false if it can't be written
+  bool start();
+  // Records the current render target (every config.every calls)
+  void capture(SDL_Renderer *renderer);
+  // Encodes what is queued, then stops the workers and closes the output
+  void stop();
+
+  bool isRecording() const { return recording; }
+  RecordFormat getFormat() const { return format; }
+  const FrameRecorderConfig &getConfig() const { return config; }
+  FrameRecorderStats getStats() const;
+
+private:
+  struct Slot {
+    std::vector<uint8_t> pixels; // RGB24, tightly packed
+    uint64_t frame;              // capture() call it came from
+    uint64_t sequence;           // Order among recorded frames
+  };
+
+  void workerLoop(int worker);
+  bool writePng(const Slot &slot, std::vector<uint8_t> &scratch);
+  bool writeY4m(uint64_t sequence, const std::vector<uint8_t> &yuv);
+  void releaseSlot(int slot);
+
+  FrameRecorderConfig config;
+  RecordFormat format;
+  bool recording;
+
+  // Shared with the workers, under mutex
+  std::vector<Slot> slots;
+  std::vector<int> freeSlots;
+  std::vector<int> queue; // FIFO ring of slot indices
+  size_t queueHead;
+  size_t queueCount;
+  bool stopping;
+  uint64_t encoded;
+  uint64_t writeFailures;
+  uint64_t bytes;
+  double encodeMs;
+  mutable std::mutex mutex;
+  std::condition_variable wake;
+  std::vector<std::thread> workers;
+  std::vector<std::vector<uint8_t>> scratch; // Per worker: PNG or planes
+
+  // Y4M: workers convert in parallel but write in sequence order
+  FILE *video;
+  uint64_t nextWrite;
+  std::mutex videoMutex;
+  std::condition_variable videoTurn;
+
+  // Game thread only
+  uint64_t frames;
+  uint64_t sequence;
+  uint64_t captured;
+  uint64_t dropped;
+  uint64_t readFailures;
+  double lastUs, totalUs, peakUs;
+};
+
+// Encoders, also used by the benchmarks. encodePng writes a complete PNG
+// (RGB, stored deflate) to out; rgbToYuv420 writes the Y, U and V planes
+// (full range BT.601, chroma averaged over 2x2 pixels) and needs
+// yuv420Size() bytes.
+void encodePng(const uint8_t *rgb, int width, int height,
+               std::vector<uint8_t> &out);
+size_t yuv420Size(int width, int height);
+void rgbToYuv420(const uint8_t *rgb, int width, int height, uint8_t *out);
+
+#endif // FRAME_RECORDER_H
@@ -0,0 +1,46 @@
+#include "FrameStats.h"
+#include "Percentile.h"
+#include <algorithm>
+#include <cstdio>
+
+namespace {
+
+void reportRow(std::ostream &out, const char *label,
+               std::vector<double> samples) {
+  std::sort(samples.begin(), samples.end());
+
+  char line[128];
+  std::snprintf(line, sizeof(line), "  %-8s %9.3f %9.3f %9.3f %9.3f", label,
+                percentile(samples, 0.50), percentile(samples, 0.95),
+                percentile(samples, 0.99),
+                samples.empty() ? 0.0 : samples.back());
+  out << line << std::endl;
+}
+
+} // namespace
+
+void FrameStats::reserve(size_t frames) {
+  updateMs.reserve(frames);
+  renderMs.reserve(frames);
+  frameMs.reserve(frames);
+}
+
+void FrameStats::record(double update, double render) {
+  updateMs.push_back(update);
+  renderMs.push_back(render);
+  frameMs.push_back(update + render);
+}
+
+void FrameStats::clear() {
+  updateMs.clear();
+  renderMs.clear();
+  frameMs.clear();
+}
+
+void FrameStats::report(std::ostream &out) const {
+  out << "Frame times over " << frameMs.size() << " frames (ms):" << std::endl;
+  out << "             p50       p95       p99       max" << std::endl;
+  reportRow(out, "update", updateMs);
+  reportRow(out, "render", renderMs);
+  reportRow(out, "frame", frameMs);
+}
@@ -0,0 +1,26 @@
+#ifndef FRAME_STATS_H
+#define FRAME_STATS_H
+
+#include <ostream>
+#include <vector>
+
+// Per-frame timings (milliseconds) collected during a run and summarized as
+// percentiles, split into update (events + simulation) and render
+class FrameStats {
+public:
+  void reserve(size_t frames);
+  void record(double updateMs, double renderMs);
+  void clear();
+
+  size_t getFrameCount() const { return frameMs.size(); }
+
+  // Prints p50/p95/p99/max for update, render and whole frames
+  void report(std::ostream &out) const;
+
+private:
+  std::vector<double> updateMs;
+  std::vector<double> renderMs;
+  std::vector<double> frameMs;
+};
+
+#endif // FRAME_STATS_H
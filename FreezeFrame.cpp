@@ -0,0 +1,79 @@
+#include "FreezeFrame.h"
+#include "Draw.h"
+#include "Game.h"
+#include "Log.h"
+
+FreezeFrame::FreezeFrame(int w, int h)
+    : width(w), height(h), texture(nullptr), valid(false), disabled(false),
+      capturedState(GameState::Menu) {}
+
+FreezeFrame::~FreezeFrame() { release(); }
+
+void FreezeFrame::setEnabled(bool on) {
+  disabled = !on;
+  if (disabled) {
+    release();
+  }
+}
+
+bool FreezeFrame::beginCapture(SDL_Renderer *renderer) {
+  if (disabled)
+    return false;
+  if (!SDL_RenderTargetSupported(renderer)) {
+    disabled = true;
+    return false;
+  }
+
+  if (!texture) {
+    texture = SDL_CreateTexture(renderer, SDL_PIXELFORMAT_RGBA8888,
+                                SDL_TEXTUREACCESS_TARGET, width, height);
+    if (!texture) {
+      LOG_WARN("render", "Freeze frame texture failed: %s", SDL_GetError());
+      disabled = true;
+      return false;
+    }
+
+    // The capture holds premultiplied colour (see FreezeFrame.h). The
+    // software renderer has no custom blend modes; plain blending only
+    // darkens translucent edges there.
+    SDL_BlendMode over = SDL_ComposeCustomBlendMode(
+        SDL_BLENDFACTOR_ONE, SDL_BLENDFACTOR_ONE_MINUS_SRC_ALPHA,
+        SDL_BLENDOPERATION_ADD, SDL_BLENDFACTOR_ONE,
+        SDL_BLENDFACTOR_ONE_MINUS_SRC_ALPHA, SDL_BLENDOPERATION_ADD);
+    if (SDL_SetTextureBlendMode(texture, over) != 0) {
+      SDL_SetTextureBlendMode(texture, SDL_BLENDMODE_BLEND);
+    }
+  }
+
+  if (SDL_SetRenderTarget(renderer, texture) != 0) {
+    LOG_WARN("render", "Freeze frame capture failed: %s", SDL_GetError());
+    release();
+    disabled = true;
+    return false;
+  }
+
+  Draw::setColor(renderer, 0, 0, 0, 0);
+  Draw::clear(renderer);
+  return true;
+}
+
+void FreezeFrame::endCapture(SDL_Renderer *renderer, GameState state) {
+  SDL_SetRenderTarget(renderer, nullptr);
+  valid = true;
+  capturedState = state;
+  LOG_DEBUG("render", "Captured freeze frame (%zu KB)", getBytes() / 1024);
+}
+
+void FreezeFrame::render(SDL_Renderer *renderer) {
+  Draw::copy(renderer, texture, nullptr, nullptr);
+}
+
+void FreezeFrame::release() {
+  if (texture) {
+    SDL_DestroyTexture(texture);
+    texture = nullptr;
+  }
+  valid = false;
+}
+
+void FreezeFrame::invalidate() { valid = false; }
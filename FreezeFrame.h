@@ -0,0 +1,61 @@
+#ifndef FREEZE_FRAME_H
+#define FREEZE_FRAME_H
+
+#include <SDL2/SDL.h>
+#include <cstddef>
+
+enum class GameState;
+
+// Render-target cache of a frozen frame (Paused and GameOver).
+//
+// The world, HUD and the state's overlay are drawn once into a texture
+// cleared to transparent black. SDL's blend mode then leaves the texture
+// holding premultiplied colour, so it is composited with a premultiplied
+// "over" (ONE, ONE_MINUS_SRC_ALPHA) on top of the live starfield. Each
+// frozen frame costs one blit instead of every entity's draw calls.
+//
+// The texture is released when play resumes or the device is reset, and
+// its contents are recaptured after SDL_RENDER_TARGETS_RESET.
+class FreezeFrame {
+public:
+  FreezeFrame(int width, int height);
+  ~FreezeFrame();
+
+  FreezeFrame(const FreezeFrame &) = delete;
+  FreezeFrame &operator=(const FreezeFrame &) = delete;
+
+  // Renders draw() into the cache for state; false if the renderer can't
+  // (draw directly instead)
+  template <typename DrawFunction>
+  bool capture(SDL_Renderer *renderer, GameState state, DrawFunction draw) {
+    if (!beginCapture(renderer))
+      return false;
+    draw();
+    endCapture(renderer, state);
+    return true;
+  }
+
+  bool isValidFor(GameState state) const {
+    return valid && texture && capturedState == state;
+  }
+
+  void render(SDL_Renderer *renderer);
+
+  void release();    // Frees the texture
+  void setEnabled(bool on); // Off: always draw directly
+  void invalidate(); // Contents lost (SDL_RENDER_TARGETS_RESET)
+  size_t getBytes() const { return texture ? size_t(width) * height * 4 : 0; }
+
+private:
+  bool beginCapture(SDL_Renderer *renderer);
+  void endCapture(SDL_Renderer *renderer, GameState state);
+
+  int width;
+  int height;
+  SDL_Texture *texture;
+  bool valid;
+  bool disabled; // Capture failed once (or turned off); draw directly
+  GameState capturedState;
+};
+
+#endif // FREEZE_FRAME_H
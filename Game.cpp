@@ -1,20 +1,83 @@
 #include "Game.h"
+#include "AllocTracker.h"
+#include "AudioMixer.h"
 #include "Bullet.h"
+#include "Camera.h"
+#include "Draw.h"
+#include "DrawCapture.h"
+#include "DynamicResolution.h"
 #include "Enemy.h"
+#include "EnemyBatches.h"
+#include "EnemyScript.h"
+#include "FlowField.h"
+#include "FramePacer.h"
+#include "FrameRecorder.h"
+#include "FreezeFrame.h"
+#include "FrameStats.h"
+#include "GameEvents.h"
 #include "HUD.h"
-#include "Particle.h"
+#include "IdleScheduler.h"
+#include "Log.h"
+#include "ParticleSystem.h"
 #include "Player.h"
+#include "Profiler.h"
+#include "ProjectileSystem.h"
+#include "Scenario.h"
+#include "ScoreStore.h"
 #include "Starfield.h"
+#include "WorldChunks.h"
+#include <algorithm>
+#include <cinttypes>
+#include <ctime>
 #include <iostream>
+#include <iterator>
 
 Game::Game()
-    : window(nullptr), renderer(nullptr), running(false),
-      state(GameState::Menu), score(0), combo(0), comboTimer(0.0f),
-      enemySpawnTimer(0.0f), difficulty(1.0f), keyState(nullptr) {
+    : window(nullptr), renderer(nullptr), running(false), sdlStarted(false),
+      headless(false), state(GameState::Menu), score(0), combo(0),
+      difficulty(1.0f), scripts(std::make_unique<ScriptPool>()),
+      enemies(std::make_unique<EnemyBatches>()),
+      enemyProjectiles(std::make_unique<ProjectileSystem>(
+          SCREEN_WIDTH, SCREEN_HEIGHT, SDL_Color{255, 100, 100, 255})),
+      particles(std::make_unique<ParticleSystem>(BURST_SEED)),
+      events(std::make_unique<GameEvents>()), eventsApplied(0),
+      enemiesSpawned(0), shotsHit(0), shotsMissed(0),
+      camera(std::make_unique<Camera>(SCREEN_WIDTH, SCREEN_HEIGHT)),
+      chunks(std::make_unique<WorldChunks>()), enemiesWoken(0),
+      enemiesSlept(0),
+      flowField(std::make_unique<FlowField>(
+          SCREEN_WIDTH + 2 * Camera::ACTIVE_MARGIN,
+          SCREEN_HEIGHT + 2 * Camera::ACTIVE_MARGIN)),
+      font(std::make_unique<BitmapFont>()),
+      text(std::make_unique<TextBatch>()),
+      freezeFrame(std::make_unique<FreezeFrame>(SCREEN_WIDTH, SCREEN_HEIGHT)),
+      resolution(
+          std::make_unique<DynamicResolution>(SCREEN_WIDTH, SCREEN_HEIGHT)),
+      audio(std::make_unique<AudioMixer>()), audioEnabled(true),
+      pacer(std::make_unique<FramePacer>()),
+      idle(std::make_unique<IdleScheduler>()), idling(false),
+      exitReport(false), frameStats(std::make_unique<FrameStats>()),
+      recordEvery(1), maxCombo(0), survivalTime(0.0f), kills{},
+      telemetry(std::make_unique<Telemetry>()), frameIndex(0),
+      collisionPairs(0), particlesSpawned(0), zeroAllocWarmup(-1.0f),
+      playTime(0.0f), failed(false), keyState(nullptr) {
 
   // Seed random number generator
   std::random_device rd;
   rng.seed(rd());
+  effectsRng.seed(rd());
+
+  setWorldSize(WORLD_WIDTH, WORLD_HEIGHT);
+
+  // Static strings are laid out once
+  menuText.title = font->cache("STELLAR FURY");
+  menuText.start = font->cache("PRESS ENTER TO START");
+  menuText.quit = font->cache("ESC TO QUIT");
+  menuText.paused = font->cache("PAUSED");
+  menuText.resume = font->cache("ESC TO RESUME");
+  menuText.gameOver = font->cache("GAME OVER");
+  menuText.score = font->cache("SCORE");
+  menuText.restart = font->cache("PRESS ENTER TO PLAY AGAIN");
 }
 
 Game::~Game() { cleanup(); }
@@ -22,10 +85,10 @@ Game::~Game() { cleanup(); }
 bool Game::init() {
   // Initialize SDL
   if (SDL_Init(SDL_INIT_VIDEO) < 0) {
-    std::cerr << "SDL could not initialize! Error: " << SDL_GetError()
-              << std::endl;
+    LOG_ERROR("game", "SDL could not initialize! Error: %s", SDL_GetError());
     return false;
   }
+  sdlStarted = true;
 
   // Create window
   window = SDL_CreateWindow("Stellar Fury", SDL_WINDOWPOS_CENTERED,
@@ -33,62 +96,486 @@ bool Game::init() {
                             SDL_WINDOW_SHOWN);
 
   if (!window) {
-    std::cerr << "Window could not be created! Error: " << SDL_GetError()
-              << std::endl;
+    LOG_ERROR("game", "Window could not be created! Error: %s",
+              SDL_GetError());
     return false;
   }
 
-  // Create renderer with VSync
-  renderer = SDL_CreateRenderer(
-      window, -1, SDL_RENDERER_ACCELERATED | SDL_RENDERER_PRESENTVSYNC);
+  // Create renderer with VSync (off for scenarios, which measure raw cost)
+  Uint32 rendererFlags = SDL_RENDERER_ACCELERATED;
+  if (!scenario) {
+    rendererFlags |= SDL_RENDERER_PRESENTVSYNC;
+  }
+  renderer = SDL_CreateRenderer(window, -1, rendererFlags);
 
   if (!renderer) {
-    std::cerr << "Renderer could not be created! Error: " << SDL_GetError()
-              << std::endl;
+    LOG_ERROR("game", "Renderer could not be created! Error: %s",
+              SDL_GetError());
     return false;
   }
 
+  // Late input pacing needs the present to block on the vblank
+  if (scenario) {
+    pacer->setLateInput(false);
+  }
+  int refreshRate = TARGET_FPS;
+  SDL_DisplayMode mode;
+  if (SDL_GetCurrentDisplayMode(SDL_GetWindowDisplayIndex(window), &mode) ==
+          0 &&
+      mode.refresh_rate > 0) {
+    refreshRate = mode.refresh_rate;
+  }
+  pacer->setRefreshRate(refreshRate);
+  resolution->setRefreshRate(refreshRate);
+  if (pacer->isLateInput()) {
+    LOG_INFO("game", "Late input sampling at %d Hz", refreshRate);
+  }
+
+  // The capture must be plain window-space draws, so nothing may redirect
+  // them into a render target the replay wouldn't have
+  if (!capturePath.empty()) {
+    if (!Draw::startCapture(capturePath.c_str(), SCREEN_WIDTH,
+                            SCREEN_HEIGHT)) {
+      LOG_ERROR("render", "Can't write draw capture %s", capturePath.c_str());
+      return false;
+    }
+    resolution->setEnabled(false);
+    freezeFrame->setEnabled(false);
+    LOG_INFO("render", "Capturing draw calls to %s", capturePath.c_str());
+  }
+
+  // Recording reads back whatever reaches the window, at its real size
+  if (!recordPath.empty()) {
+    FrameRecorderConfig config;
+    config.path = recordPath;
+    config.every = recordEvery;
+    config.fps = scenario ? TARGET_FPS : refreshRate;
+    SDL_GetRendererOutputSize(renderer, &config.width, &config.height);
+    recorder = std::make_unique<FrameRecorder>(config);
+    if (!recorder->start()) {
+      LOG_ERROR("record", "Can't record frames to %s", recordPath.c_str());
+      return false;
+    }
+    LOG_INFO("record", "Recording %dx%d frames to %s", config.width,
+             config.height, recordPath.c_str());
+  }
+
   // Enable alpha blending
-  SDL_SetRenderDrawBlendMode(renderer, SDL_BLENDMODE_BLEND);
+  Draw::setBlendMode(renderer, SDL_BLENDMODE_BLEND);
 
   // Initialize systems
-  starfield = std::make_unique<Starfield>(SCREEN_WIDTH, SCREEN_HEIGHT);
-  hud = std::make_unique<HUD>();
+  if (!starfield) {
+    starfield = std::make_unique<Starfield>(SCREEN_WIDTH, SCREEN_HEIGHT);
+  }
+  font->load(renderer);
+  hud = std::make_unique<HUD>(SCREEN_WIDTH, *font);
+  particles->reserve(PARTICLE_RESERVE); // Headless games never draw any
+
+  // The game runs silent if there is no audio device
+  if (audioEnabled) {
+    if (SDL_InitSubSystem(SDL_INIT_AUDIO) < 0) {
+      LOG_WARN("audio", "SDL audio could not initialize! Error: %s",
+               SDL_GetError());
+    } else {
+      audio->open();
+    }
+  }
+
+  registerCounters();
+
+  // Scores live in the per-user data directory (scenarios don't record)
+  if (!scenario) {
+    std::string scorePath = "stellar_fury_scores.dat";
+    if (char *prefPath = SDL_GetPrefPath("StellarFury", "StellarFury")) {
+      scorePath = std::string(prefPath) + scorePath;
+      SDL_free(prefPath);
+    }
+
+    scoreStore = std::make_unique<ScoreStore>();
+    scoreStore->open(scorePath);
+
+    std::vector<RunRecord> best = scoreStore->getTopScores();
+    if (!best.empty()) {
+      LOG_INFO("game", "High score: %d (%" PRIu64 " runs)", best.front().score,
+               scoreStore->getRunCount());
+    }
+  }
 
   running = true;
   return true;
 }
 
+bool Game::openStatsFile(const char *path) {
+  if (!telemetry->open(path))
+    return false;
+
+  LOG_INFO("game", "Writing live stats to %s", path);
+  return true;
+}
+
+void Game::registerCounters() {
+  Telemetry &t = *telemetry;
+  const TelemetryUnit us = TelemetryUnit::Microseconds;
+  counters.updateUs = t.registerCounter("frame.update", us);
+  counters.renderUs = t.registerCounter("frame.render", us);
+  counters.frameUs = t.registerCounter("frame.total", us);
+  static_assert(ENEMY_TYPE_COUNT == 3, "one counter name per enemy type");
+  counters.enemies[0] = t.registerCounter("entities.drifters");
+  counters.enemies[1] = t.registerCounter("entities.hunters");
+  counters.enemies[2] = t.registerCounter("entities.bombers");
+  counters.playerBullets = t.registerCounter("entities.playerBullets");
+  counters.enemyProjectiles = t.registerCounter("entities.enemyProjectiles");
+  counters.particles = t.registerCounter("entities.particles");
+  counters.timers = t.registerCounter("timers.pending");
+  counters.collisionPairs = t.registerCounter("collision.pairsTested");
+  counters.particlesSpawned = t.registerCounter("particles.spawned");
+  counters.drawCalls = t.registerCounter("render.drawCalls");
+  counters.drawPrimitives = t.registerCounter("render.primitives");
+  counters.cachedBytes = t.registerCounter("render.freezeFrameBytes");
+  counters.renderScale =
+      t.registerCounter("render.scale", TelemetryUnit::Thousandths);
+  counters.difficulty =
+      t.registerCounter("game.difficulty", TelemetryUnit::Thousandths);
+  counters.score = t.registerCounter("game.score");
+  counters.combo = t.registerCounter("game.combo");
+  counters.health = t.registerCounter("player.health");
+  counters.audioCallbackUs = t.registerCounter("audio.callback", us);
+  counters.audioPeakUs = t.registerCounter("audio.callbackPeak", us);
+  counters.audioLoad =
+      t.registerCounter("audio.load", TelemetryUnit::Thousandths);
+  counters.audioVoices = t.registerCounter("audio.voices");
+  counters.audioStolen = t.registerCounter("audio.stolen");
+  counters.audioRejected = t.registerCounter("audio.rejected");
+  counters.inputLatencyUs = t.registerCounter("input.latency", us);
+  counters.inputLatencyPeakUs = t.registerCounter("input.latencyPeak", us);
+  counters.pacerWorkUs = t.registerCounter("pacer.workEstimate", us);
+  counters.pacerSleepUs = t.registerCounter("pacer.sleep", us);
+  counters.cpuUsage =
+      t.registerCounter("cpu.usage", TelemetryUnit::Thousandths);
+  counters.idle = t.registerCounter("cpu.idle");
+  counters.dormant = t.registerCounter("world.dormant");
+  counters.woken = t.registerCounter("world.woken");
+  counters.slept = t.registerCounter("world.slept");
+  counters.spawned = t.registerCounter("world.spawned");
+  counters.events = t.registerCounter("events.applied");
+  counters.shotsHit = t.registerCounter("player.shotsHit");
+  counters.shotsMissed = t.registerCounter("player.shotsMissed");
+  counters.recordUs = t.registerCounter("record.overhead", us);
+  counters.recordPeakUs = t.registerCounter("record.overheadPeak", us);
+  counters.recordFrames = t.registerCounter("record.frames");
+  counters.recordDropped = t.registerCounter("record.dropped");
+}
+
+void Game::publishCounters(double updateMs, double renderMs) {
+  counters.updateUs.set(static_cast<int64_t>(updateMs * 1000.0));
+  counters.renderUs.set(static_cast<int64_t>(renderMs * 1000.0));
+  counters.frameUs.set(static_cast<int64_t>((updateMs + renderMs) * 1000.0));
+
+  for (int i = 0; i < ENEMY_TYPE_COUNT; i++) {
+    auto &bucket = enemies->bucket(static_cast<EnemyType>(i));
+    counters.enemies[i].set(static_cast<int64_t>(bucket.size()));
+  }
+  counters.playerBullets.set(static_cast<int64_t>(playerBullets.size()));
+  counters.enemyProjectiles.set(static_cast<int64_t>(enemyProjectiles->size()));
+  counters.particles.set(static_cast<int64_t>(particles->size()));
+  counters.timers.set(static_cast<int64_t>(timers.pending()));
+  counters.collisionPairs.set(collisionPairs);
+  counters.particlesSpawned.set(particlesSpawned);
+  counters.dormant.set(static_cast<int64_t>(chunks->size()));
+  counters.woken.set(enemiesWoken);
+  counters.slept.set(enemiesSlept);
+  counters.spawned.set(enemiesSpawned);
+  counters.events.set(eventsApplied);
+  counters.shotsHit.set(shotsHit);
+  counters.shotsMissed.set(shotsMissed);
+  const Draw::Stats &draw = Draw::getStats();
+  counters.drawCalls.set(static_cast<int64_t>(draw.drawCalls));
+  counters.drawPrimitives.set(static_cast<int64_t>(draw.primitives));
+  counters.cachedBytes.set(static_cast<int64_t>(freezeFrame->getBytes()));
+  counters.renderScale.set(
+      static_cast<int64_t>(resolution->getScale() * 1000.0f + 0.5f));
+  counters.difficulty.set(static_cast<int64_t>(difficulty * 1000.0f));
+  counters.score.set(score);
+  counters.combo.set(combo);
+  counters.health.set(player ? player->getHealth() : 0);
+
+  // Callback share of its buffer's playback time; the peak covers the
+  // last second
+  AudioMixer::Stats sound = audio->getStats();
+  counters.audioCallbackUs.set(static_cast<int64_t>(sound.lastNs / 1000));
+  counters.audioPeakUs.set(static_cast<int64_t>(sound.peakNs / 1000));
+  counters.audioLoad.set(sound.budgetNs
+                             ? static_cast<int64_t>(sound.lastNs * 1000 /
+                                                    sound.budgetNs)
+                             : 0);
+  counters.audioVoices.set(sound.voices);
+  counters.audioStolen.set(static_cast<int64_t>(sound.stolen));
+  counters.audioRejected.set(static_cast<int64_t>(sound.rejected));
+  counters.cpuUsage.set(
+      static_cast<int64_t>(idle->getRecentCpuUsage() * 1000.0));
+  counters.idle.set(idling ? 1 : 0);
+  if (recorder) {
+    FrameRecorderStats record = recorder->getStats();
+    counters.recordUs.set(static_cast<int64_t>(record.lastUs));
+    counters.recordPeakUs.set(static_cast<int64_t>(record.peakUs));
+    counters.recordFrames.set(static_cast<int64_t>(record.encoded));
+    counters.recordDropped.set(static_cast<int64_t>(record.dropped));
+  }
+
+  // Key press to present of the last frame that showed input
+  double latencyMs = pacer->getLatencyMs();
+  counters.inputLatencyUs.set(
+      latencyMs < 0 ? 0 : static_cast<int64_t>(latencyMs * 1000.0));
+  counters.inputLatencyPeakUs.set(
+      static_cast<int64_t>(pacer->getPeakLatencyMs() * 1000.0));
+  counters.pacerWorkUs.set(
+      static_cast<int64_t>(pacer->getWorkEstimateMs() * 1000.0));
+  counters.pacerSleepUs.set(
+      static_cast<int64_t>(pacer->getLastSleepMs() * 1000.0));
+
+  if (frameIndex % TARGET_FPS == 0) {
+    audio->resetPeak();
+    pacer->resetPeak();
+  }
+
+  telemetry->publish(++frameIndex);
+  collisionPairs = 0;
+  particlesSpawned = 0;
+  enemiesWoken = 0;
+  enemiesSlept = 0;
+  enemiesSpawned = 0;
+  eventsApplied = 0;
+}
+
+void Game::setLateInput(bool enabled) { pacer->setLateInput(enabled); }
+
+void Game::startHeadless(unsigned seed) {
+  headless = true;
+  rng.seed(seed);
+  effectsRng.seed(seed);
+  startGame();
+}
+
+void Game::step(const Uint8 *keys, float deltaTime) {
+  if (state != GameState::Playing)
+    return;
+
+  keyState = keys;
+  updatePlaying(deltaTime);
+
+  // Per-frame counts publishCounters() would otherwise reset
+  collisionPairs = 0;
+  particlesSpawned = 0;
+  enemiesWoken = 0;
+  enemiesSlept = 0;
+  enemiesSpawned = 0;
+  eventsApplied = 0;
+}
+
+void Game::setFrameRecording(const char *path, int every) {
+  recordPath = path;
+  recordEvery = std::max(1, every);
+}
+
+void Game::setIdle(bool enabled, int fps) {
+  idle->setEnabled(enabled);
+  idle->setIdleFps(fps);
+}
+
+void Game::setStarfield(const StarfieldConfig &config) {
+  starfield = std::make_unique<Starfield>(SCREEN_WIDTH, SCREEN_HEIGHT, config);
+}
+
+void Game::setDynamicResolution(bool enabled, float minScale,
+                                float maxScale) {
+  DynamicResolutionConfig config = resolution->getConfig();
+  config.minScale = minScale;
+  config.maxScale = maxScale;
+  resolution->setConfig(config);
+  resolution->setEnabled(enabled);
+}
+
+void Game::setWorldSize(float width, float height) {
+  camera->setWorldSize(width, height);
+  chunks->resize(camera->getWorld().w, camera->getWorld().h);
+}
+
+void Game::setScenario(const ScenarioConfig &config) {
+  scenario = std::make_unique<Scenario>(config);
+  rng.seed(config.seed);
+  effectsRng.seed(config.seed);
+}
+
 void Game::run() {
   Uint64 lastTime = SDL_GetPerformanceCounter();
   const Uint64 frequency = SDL_GetPerformanceFrequency();
+  const double msPerTick = 1000.0 / frequency;
+  if (AllocTracker::isEnabled()) {
+    AllocTracker::get().markGameThread();
+  }
+
+  if (scenario) {
+    frameStats->reserve(
+        static_cast<size_t>(scenario->getConfig().duration / SCENARIO_DT) + 1);
+    startGame();
+    scenario->start(*this);
+  }
 
   while (running) {
+    // Nothing moves outside gameplay: sleep until input or the idle tick.
+    // Late input: wait out the slack before the vblank, not after it
+    GameState frameState = state;
+    idling = idle->wait(frameState);
+    if (!idling) {
+      pacer->waitForWakeup();
+    }
+
     // Calculate delta time
     Uint64 currentTime = SDL_GetPerformanceCounter();
     float deltaTime = static_cast<float>(currentTime - lastTime) / frequency;
     lastTime = currentTime;
 
-    // Cap delta time to prevent spiral of death
-    if (deltaTime > 0.05f) {
-      deltaTime = 0.05f;
+    // Cap delta time to prevent spiral of death (idle frames are slow on
+    // purpose, and only the starfield moves)
+    float maxDeltaTime = idling ? 0.25f : 0.05f;
+    if (deltaTime > maxDeltaTime) {
+      deltaTime = maxDeltaTime;
+    }
+
+    // Scenarios step a fixed timestep so runs are reproducible
+    if (scenario) {
+      deltaTime = SCENARIO_DT;
+    }
+
+    Uint64 frameStart = SDL_GetPerformanceCounter();
+    pacer->beginFrame();
+    Uint64 renderStart;
+    {
+      PROFILE_SCOPE("frame");
+      handleEvents();
+      update(deltaTime);
+      renderStart = SDL_GetPerformanceCounter();
+      render();
+    }
+    PROFILE_FRAME();
+    ALLOC_FRAME();
+    checkZeroAlloc(deltaTime);
+
+    Uint64 frameEnd = SDL_GetPerformanceCounter();
+    double updateMs = (renderStart - frameStart) * msPerTick;
+    double renderMs = (frameEnd - renderStart) * msPerTick;
+    idle->endFrame(frameState);
+    if (frameState == GameState::Playing) {
+      resolution->endFrame(pacer->getLastWorkMs());
+    }
+    publishCounters(updateMs, renderMs);
+
+    if (scenario) {
+      frameStats->record(updateMs, renderMs);
+
+      if (scenario->isFinished()) {
+        running = false;
+      }
+    }
+  }
+
+  if (scenario) {
+    // Reports go straight to stdout, after any queued log lines
+    Log::flush();
+    const ScenarioConfig &config = scenario->getConfig();
+    std::cout << "Scenario " << Scenario::kindName(config.kind) << " (count "
+              << scenario->getCount() << ", seed " << config.seed << ", "
+              << config.duration << "s)" << std::endl;
+    frameStats->report(std::cout);
+    if (resolution->isEnabled()) {
+      resolution->report(std::cout);
+    }
+    if (audio->isReady()) {
+      audio->report(std::cout);
+    }
+    if (AllocTracker::isEnabled()) {
+      AllocTracker::get().report(std::cout);
     }
+  } else if (exitReport) {
+    Log::flush();
+    idle->report(std::cout);
+    if (resolution->isEnabled()) {
+      resolution->report(std::cout);
+    }
+  }
+}
 
-    handleEvents();
-    update(deltaTime);
-    render();
+void Game::setZeroAllocAssert(float warmupSeconds) {
+  zeroAllocWarmup = warmupSeconds;
+}
+
+void Game::checkZeroAlloc(float deltaTime) {
+  if (zeroAllocWarmup < 0 || state != GameState::Playing)
+    return;
+
+  // Only gameplay time counts towards the warmup
+  playTime += deltaTime;
+  if (playTime < zeroAllocWarmup)
+    return;
+
+  AllocTracker &tracker = AllocTracker::get();
+  if (tracker.getFrameTotal().allocs == 0)
+    return;
+
+  LOG_ERROR("alloc",
+            "Allocation in steady state at %.2fs: %" PRIu64 " allocs, %" PRIu64
+            " bytes",
+            playTime, tracker.getFrameTotal().allocs,
+            tracker.getFrameTotal().bytes);
+  for (int i = 0; i < tracker.getTagCount(); i++) {
+    const AllocTracker::Counts &counts = tracker.getFrameCounts(i);
+    if (counts.allocs > 0 && i != AllocTracker::OTHER_THREADS_TAG) {
+      LOG_ERROR("alloc", "  %s: %" PRIu64 " allocs, %" PRIu64 " bytes",
+                tracker.getTagName(i), counts.allocs, counts.bytes);
+    }
   }
+
+  failed = true;
+  running = false;
 }
 
 void Game::cleanup() {
   // Clear entities
+  timers.clear();
   player.reset();
-  enemies.clear();
+  enemies->clear();
   playerBullets.clear();
-  enemyBullets.clear();
-  particles.clear();
+  enemyProjectiles->clear();
+  particles->clear();
   starfield.reset();
   hud.reset();
+  font->release();
+  freezeFrame->release();
+  resolution->release();
+
+  if (const DrawCaptureWriter *capture = Draw::getCapture()) {
+    LOG_INFO("render", "Draw capture: %" PRIu64 " frames, %" PRIu64 " bytes",
+             capture->getFrames(), capture->getBytes());
+    Draw::stopCapture();
+  }
+
+  // Finish encoding what is queued; the buffers don't need the renderer
+  if (recorder) {
+    recorder->stop();
+    FrameRecorderStats record = recorder->getStats();
+    LOG_INFO("record",
+             "Recorded %" PRIu64 " frames (%" PRIu64 " dropped, %" PRIu64
+             " failed), %" PRIu64 " bytes",
+             record.encoded, record.dropped, record.failed, record.bytes);
+    LOG_INFO("record",
+             "Game thread cost %.0f us mean, %.0f us peak; encode %.2f ms "
+             "per frame",
+             record.meanUs, record.peakUs, record.encodeMeanMs);
+    recorder.reset();
+  }
+
+  // Stop the audio callback before SDL goes away
+  audio->close();
 
   // Destroy SDL resources
   if (renderer) {
@@ -101,10 +588,15 @@ void Game::cleanup() {
     window = nullptr;
   }
 
-  SDL_Quit();
+  if (sdlStarted) {
+    SDL_Quit();
+    sdlStarted = false;
+  }
 }
 
 void Game::handleEvents() {
+  PROFILE_SCOPE("handleEvents");
+  ALLOC_SCOPE("events");
   SDL_Event event;
 
   while (SDL_PollEvent(&event)) {
@@ -113,7 +605,24 @@ void Game::handleEvents() {
       running = false;
       break;
 
+    case SDL_KEYUP:
+      pacer->recordKey(event.key);
+      break;
+
+    // Render targets lose their contents, a device reset the textures too
+    case SDL_RENDER_TARGETS_RESET:
+      freezeFrame->invalidate();
+      break;
+
+    case SDL_RENDER_DEVICE_RESET:
+      freezeFrame->release();
+      resolution->release();
+      font->load(renderer);
+      break;
+
     case SDL_KEYDOWN:
+      pacer->recordKey(event.key);
+
       if (event.key.keysym.sym == SDLK_ESCAPE) {
         if (state == GameState::Playing) {
           state = GameState::Paused;
@@ -129,6 +638,26 @@ void Game::handleEvents() {
           startGame();
         }
       }
+
+#ifdef STELLAR_PROFILE
+      // F3 toggles the frame-time graph, F4 dumps a Chrome trace
+      if (event.key.keysym.sym == SDLK_F3) {
+        Profiler::get().toggleGraph();
+      }
+      if (event.key.keysym.sym == SDLK_F4) {
+        const char *path = "stellar_fury_trace.json";
+        if (Profiler::get().dumpChromeTrace(path)) {
+          LOG_INFO("profiler", "Wrote profile trace to %s", path);
+        }
+      }
+#endif
+
+#ifdef STELLAR_ALLOC_TRACK
+      // F5 toggles the per-frame allocation bar
+      if (event.key.keysym.sym == SDLK_F5) {
+        AllocTracker::get().toggleOverlay();
+      }
+#endif
       break;
     }
   }
@@ -138,8 +667,14 @@ void Game::handleEvents() {
 }
 
 void Game::update(float deltaTime) {
+  PROFILE_SCOPE("update");
+
   // Always update starfield
-  starfield->update(deltaTime);
+  {
+    PROFILE_SCOPE("update.starfield");
+    ALLOC_SCOPE("starfield");
+    starfield->update(deltaTime);
+  }
 
   switch (state) {
   case GameState::Menu:
@@ -164,6 +699,8 @@ void Game::updateMenu(float deltaTime) {
 void Game::updatePlaying(float deltaTime) {
   // Update player
   if (player) {
+    PROFILE_SCOPE("update.player");
+    ALLOC_SCOPE("player");
     player->update(deltaTime, keyState, *this);
 
     // Check if player is dead
@@ -173,109 +710,176 @@ void Game::updatePlaying(float deltaTime) {
     }
   }
 
-  // Spawn enemies
-  enemySpawnTimer -= deltaTime;
-  if (enemySpawnTimer <= 0) {
-    spawnEnemy();
-    enemySpawnTimer = 2.0f / difficulty; // Spawn faster as difficulty increases
+  // Fire due timers: enemy spawns and shots, expiry, combo reset
+  {
+    PROFILE_SCOPE("update.timers");
+    ALLOC_SCOPE("timers");
+    timers.advance(deltaTime);
+  }
+
+  if (scenario) {
+    PROFILE_SCOPE("update.scenario");
+    ALLOC_SCOPE("scenario");
+    scenario->update(deltaTime, *this);
+  }
+
+  // Follow the player, then stream enemies in and out around the new view
+  if (player) {
+    PROFILE_SCOPE("update.world");
+    ALLOC_SCOPE("world");
+    Vector2 moved = camera->follow(player->getPosition());
+    if (starfield) {
+      starfield->scroll(moved.x, moved.y);
+    }
+    streamWorld();
+    enemyProjectiles->setBounds(camera->getSleepRegion());
+  }
+
+  // Rebuild the steering field at its own low rate
+  if (player && flowField->tick(deltaTime)) {
+    PROFILE_SCOPE("update.flowField");
+    ALLOC_SCOPE("flowField");
+    WorldRect region = camera->getActiveRegion();
+    flowField->setOrigin(Vector2(region.x, region.y));
+    flowField->clearDensity();
+    for (auto &bucket : enemies->all()) {
+      for (auto &enemy : bucket) {
+        flowField->deposit(enemy.getPosition());
+      }
+    }
+    flowField->rebuild(player->getPosition());
   }
 
-  // Update enemies
-  for (auto &enemy : enemies) {
-    enemy->update(deltaTime, *this);
+  // Update enemies (one type-specialized pass per bucket)
+  {
+    PROFILE_SCOPE("update.enemies");
+    ALLOC_SCOPE("enemies");
+    enemies->update(deltaTime, *this);
   }
 
   // Update player bullets
-  for (auto &bullet : playerBullets) {
-    bullet->update(deltaTime);
+  {
+    PROFILE_SCOPE("update.playerBullets");
+    ALLOC_SCOPE("bullets");
+    WorldRect region = camera->getSleepRegion();
+    for (auto &bullet : playerBullets) {
+      bullet->update(deltaTime);
+      if (bullet->isActive() && !region.contains(bullet->getPosition())) {
+        bullet->setActive(false);
+        events->push(BulletExpired{bullet->getX(), bullet->getY(), false});
+      }
+    }
   }
 
-  // Update enemy bullets
-  for (auto &bullet : enemyBullets) {
-    bullet->update(deltaTime);
+  // Advance the enemy projectile clock (positions are evaluated lazily)
+  {
+    PROFILE_SCOPE("update.enemyProjectiles");
+    ALLOC_SCOPE("projectiles");
+    enemyProjectiles->update(deltaTime);
   }
 
   // Update particles
-  for (auto &particle : particles) {
-    particle->update(deltaTime);
+  {
+    PROFILE_SCOPE("update.particles");
+    ALLOC_SCOPE("particles");
+    particles->update(deltaTime);
   }
 
   // Check collisions - player bullets vs enemies
-  for (auto &bullet : playerBullets) {
-    if (!bullet->isActive())
-      continue;
-
-    for (auto &enemy : enemies) {
-      if (!enemy->isActive())
+  {
+    PROFILE_SCOPE("collide.playerBullets");
+    ALLOC_SCOPE("collisions");
+    for (auto &bullet : playerBullets) {
+      if (!bullet->isActive())
         continue;
 
-      if (bullet->collidesWith(*enemy)) {
-        bullet->setActive(false);
-        enemy->takeDamage(1);
-
-        if (!enemy->isActive()) {
-          // Enemy destroyed
-          addScore(enemy->getScoreValue());
-          createExplosion(enemy->getX(), enemy->getY(), 20,
-                          {255, 150, 50, 255});
+      for (auto &bucket : enemies->all()) {
+        for (auto &enemy : bucket) {
+          if (!enemy.isActive())
+            continue;
+
+          collisionPairs++;
+          if (bullet->collidesWith(enemy)) {
+            bullet->setActive(false);
+            enemy.takeDamage(1);
+            events->push(BulletExpired{bullet->getX(), bullet->getY(), true});
+
+            if (enemy.isActive()) {
+              events->push(
+                  EnemyHit{enemy.getX(), enemy.getY(), enemy.getType()});
+            } else {
+              events->push(EnemyKilled{enemy.getX(), enemy.getY(),
+                                       enemy.getType(),
+                                       enemy.getScoreValue()});
+            }
+            break; // A bullet hits one enemy
+          }
         }
+        if (!bullet->isActive())
+          break;
       }
     }
   }
 
-  // Check collisions - enemy bullets vs player
   if (player) {
-    for (auto &bullet : enemyBullets) {
-      if (!bullet->isActive())
-        continue;
-
-      if (bullet->collidesWith(*player)) {
-        bullet->setActive(false);
-        player->takeDamage(1);
-        createExplosion(player->getX(), player->getY(), 10,
-                        {255, 100, 100, 255});
+    // Check collisions - enemy bullets vs player
+    {
+      PROFILE_SCOPE("collide.enemyProjectiles");
+      ALLOC_SCOPE("collisions");
+      collisionPairs += static_cast<int>(enemyProjectiles->size());
+      int hits = enemyProjectiles->collide(player->getBoundingBox());
+      for (int i = 0; i < hits; i++) {
+        events->push(PlayerHit{player->getX(), player->getY(), 1,
+                               HitCause::Projectile});
       }
     }
 
     // Check collisions - enemies vs player
-    for (auto &enemy : enemies) {
-      if (!enemy->isActive())
-        continue;
-
-      if (enemy->collidesWith(*player)) {
-        enemy->setActive(false);
-        player->takeDamage(2);
-        createExplosion(enemy->getX(), enemy->getY(), 25, {255, 200, 50, 255});
+    {
+      PROFILE_SCOPE("collide.enemies");
+      ALLOC_SCOPE("collisions");
+      for (auto &bucket : enemies->all()) {
+        for (auto &enemy : bucket) {
+          if (!enemy.isActive())
+            continue;
+
+          collisionPairs++;
+          if (enemy.collidesWith(*player)) {
+            enemy.setActive(false);
+            events->push(
+                PlayerHit{enemy.getX(), enemy.getY(), 2, HitCause::Ram});
+          }
+        }
       }
     }
   }
 
-  // Update combo timer
-  if (combo > 0) {
-    comboTimer -= deltaTime;
-    if (comboTimer <= 0) {
-      combo = 0;
-    }
+  // Side effects of everything detected above
+  {
+    PROFILE_SCOPE("events");
+    ALLOC_SCOPE("events");
+    applyEvents();
   }
 
-  // Remove inactive entities
-  playerBullets.erase(
-      std::remove_if(playerBullets.begin(), playerBullets.end(),
-                     [](const auto &b) { return !b->isActive(); }),
-      playerBullets.end());
-
-  enemyBullets.erase(
-      std::remove_if(enemyBullets.begin(), enemyBullets.end(),
-                     [](const auto &b) { return !b->isActive(); }),
-      enemyBullets.end());
-
-  enemies.erase(std::remove_if(enemies.begin(), enemies.end(),
-                               [](const auto &e) { return !e->isActive(); }),
-                enemies.end());
+  // Remove inactive entities, cancelling any timers they still own
+  {
+    PROFILE_SCOPE("removeInactive");
+    ALLOC_SCOPE("removeInactive");
+    auto expired = [this](auto &e) {
+      if (e->isActive())
+        return false;
+      timers.cancel(e->getExpiryTimer());
+      return true;
+    };
+
+    playerBullets.erase(
+        std::remove_if(playerBullets.begin(), playerBullets.end(), expired),
+        playerBullets.end());
+
+    enemies->removeInactive(timers);
+  }
 
-  particles.erase(std::remove_if(particles.begin(), particles.end(),
-                                 [](const auto &p) { return !p->isActive(); }),
-                  particles.end());
+  survivalTime += deltaTime;
 
   // Increase difficulty over time
   difficulty += deltaTime * 0.01f;
@@ -283,79 +887,214 @@ void Game::updatePlaying(float deltaTime) {
     difficulty = 5.0f;
 }
 
+void Game::applyEvents() {
+  events->merge();
+  eventsApplied += static_cast<int>(events->size());
+
+  // Scoring, in kill order so combos build the same way every run
+  for (const EnemyKilled &kill : events->get<EnemyKilled>()) {
+    kills[static_cast<int>(kill.type)]++;
+    addScore(kill.scoreValue);
+  }
+
+  // Damage and the HUD
+  const std::vector<PlayerHit> &playerHits = events->get<PlayerHit>();
+  if (player) {
+    for (const PlayerHit &hit : playerHits) {
+      player->takeDamage(hit.damage);
+    }
+  }
+  if (hud && !playerHits.empty()) {
+    hud->flashDamage();
+  }
+
+  // Particles (explosions bring their own sound)
+  for (const EnemyKilled &kill : events->get<EnemyKilled>()) {
+    createExplosion(kill.x, kill.y, 20, {255, 150, 50, 255});
+  }
+  for (const PlayerHit &hit : playerHits) {
+    if (hit.cause == HitCause::Ram) {
+      createExplosion(hit.x, hit.y, 25, {255, 200, 50, 255});
+    } else {
+      createExplosion(hit.x, hit.y, 10, {255, 100, 100, 255});
+    }
+  }
+
+  // Audio
+  for (const EnemyHit &hit : events->get<EnemyHit>()) {
+    playSound(Sound::Hit, hit.x);
+  }
+  for (const PlayerHit &hit : playerHits) {
+    playSound(Sound::PlayerHit, hit.x);
+  }
+
+  // Stats
+  for (const BulletExpired &bullet : events->get<BulletExpired>()) {
+    if (bullet.hit) {
+      shotsHit++;
+    } else {
+      shotsMissed++;
+    }
+  }
+  enemiesSpawned += static_cast<int>(events->get<EnemySpawned>().size());
+
+  events->clear();
+}
+
 void Game::updateGameOver(float deltaTime) {
   (void)deltaTime; // Unused for now
 }
 
 void Game::render() {
+  PROFILE_SCOPE("render");
+  ALLOC_SCOPE("render");
+
+  Draw::resetStats();
+
+  // Under load, gameplay draws the background and world into a smaller
+  // offscreen target; renderPlaying() upscales it before the HUD
+  if (state == GameState::Playing) {
+    resolution->begin(renderer);
+  }
+
   // Clear screen with dark background
-  SDL_SetRenderDrawColor(renderer, 10, 10, 20, 255);
-  SDL_RenderClear(renderer);
+  Draw::setColor(renderer, 10, 10, 20, 255);
+  Draw::clear(renderer);
 
   // Render starfield (always visible)
-  starfield->render(renderer);
+  {
+    PROFILE_SCOPE("render.starfield");
+    starfield->render(renderer);
+  }
 
   switch (state) {
   case GameState::Menu:
+    freezeFrame->release();
     renderMenu();
     break;
   case GameState::Playing:
-  case GameState::Paused:
+    freezeFrame->release(); // Play resumed: free the cached frame
     renderPlaying();
-    if (state == GameState::Paused) {
-      // Draw pause overlay
-      SDL_SetRenderDrawColor(renderer, 0, 0, 0, 150);
-      SDL_Rect overlay = {0, 0, SCREEN_WIDTH, SCREEN_HEIGHT};
-      SDL_RenderFillRect(renderer, &overlay);
-    }
     break;
+  case GameState::Paused:
   case GameState::GameOver:
-    renderPlaying(); // Show last frame
-    renderGameOver();
+    renderFrozen();
     break;
   }
 
-  SDL_RenderPresent(renderer);
+#ifdef STELLAR_PROFILE
+  Profiler::get().renderFrameGraph(renderer, 20, SCREEN_HEIGHT - 100);
+#endif
+#ifdef STELLAR_ALLOC_TRACK
+  AllocTracker::get().renderOverlay(renderer, SCREEN_WIDTH - 260,
+                                    SCREEN_HEIGHT - 30);
+#endif
+
+  // Run the queued draws before the present, so their cost counts as
+  // frame work rather than as waiting for the vblank
+  {
+    PROFILE_SCOPE("render.flush");
+    Draw::flush(renderer);
+  }
+
+  // The finished frame, before the present makes the back buffer undefined
+  if (recorder) {
+    PROFILE_SCOPE("render.record");
+    recorder->capture(renderer);
+  }
+
+  PROFILE_SCOPE("render.present");
+  pacer->beginPresent();
+  Draw::present(renderer);
+  pacer->endPresent();
 }
 
-void Game::renderMenu() {
-  // Draw title (simple rectangle placeholder)
-  SDL_SetRenderDrawColor(renderer, 0, 200, 255, 255);
-  SDL_Rect titleRect = {SCREEN_WIDTH / 2 - 150, 150, 300, 60};
-  SDL_RenderFillRect(renderer, &titleRect);
+void Game::renderFrozen() {
+  PROFILE_SCOPE("render.frozen");
 
-  // Draw "Press ENTER" indicator
-  SDL_SetRenderDrawColor(renderer, 200, 200, 200, 255);
-  SDL_Rect startRect = {SCREEN_WIDTH / 2 - 100, 350, 200, 30};
-  SDL_RenderFillRect(renderer, &startRect);
+  // Nothing but the starfield moves: draw the world and overlay once into
+  // the cache, then blit it every frame
+  if (!freezeFrame->isValidFor(state) &&
+      !freezeFrame->capture(renderer, state,
+                            [this]() { renderFrozenLayer(); })) {
+    renderFrozenLayer(); // No render targets: draw it all every frame
+    return;
+  }
+
+  freezeFrame->render(renderer);
+}
+
+void Game::renderFrozenLayer() {
+  renderPlaying(); // Show last frame
+
+  if (state == GameState::Paused) {
+    // Draw pause overlay
+    Draw::setColor(renderer, 0, 0, 0, 150);
+    SDL_Rect overlay = {0, 0, SCREEN_WIDTH, SCREEN_HEIGHT};
+    Draw::fillRect(renderer, &overlay);
+
+    text->addCached(*font, menuText.paused, SCREEN_WIDTH / 2, 240, 5,
+                    {255, 255, 255, 255}, TextAlign::Center);
+    text->addCached(*font, menuText.resume, SCREEN_WIDTH / 2, 320, 2,
+                    {180, 180, 180, 255}, TextAlign::Center);
+    text->render(renderer, *font);
+  } else {
+    renderGameOver();
+  }
+}
+
+void Game::renderMenu() {
+  int centerX = SCREEN_WIDTH / 2;
+  text->addCached(*font, menuText.title, centerX, 150, 6, {0, 200, 255, 255},
+                  TextAlign::Center);
+  text->addCached(*font, menuText.start, centerX, 350, 2,
+                  {200, 200, 200, 255}, TextAlign::Center);
+  text->addCached(*font, menuText.quit, centerX, 390, 1, {130, 130, 130, 255},
+                  TextAlign::Center);
+  text->render(renderer, *font);
 }
 
 void Game::renderPlaying() {
+  // The world is drawn shifted by the camera and culled to its view; the
+  // HUD stays in screen space
+  Draw::setOffset(camera->getOffsetX(), camera->getOffsetY());
+  WorldRect visible = camera->getCullRect();
+
   // Render particles (behind everything)
-  for (auto &particle : particles) {
-    particle->render(renderer);
+  {
+    PROFILE_SCOPE("render.particles");
+    particles->render(renderer, visible);
   }
 
   // Render bullets
-  for (auto &bullet : playerBullets) {
-    bullet->render(renderer);
-  }
-  for (auto &bullet : enemyBullets) {
-    bullet->render(renderer);
+  {
+    PROFILE_SCOPE("render.bullets");
+    for (auto &bullet : playerBullets) {
+      if (visible.overlaps(bullet->getBoundingBox())) {
+        bullet->render(renderer);
+      }
+    }
+    enemyProjectiles->render(renderer, visible);
   }
 
   // Render enemies
-  for (auto &enemy : enemies) {
-    enemy->render(renderer);
+  {
+    PROFILE_SCOPE("render.enemies");
+    enemies->render(renderer, visible);
   }
 
   // Render player
   if (player) {
+    PROFILE_SCOPE("render.player");
     player->render(renderer);
   }
 
+  Draw::setOffset(0, 0);
+  resolution->resolve(renderer);
+
   // Render HUD
   if (hud && player) {
+    PROFILE_SCOPE("render.hud");
     hud->render(renderer, score, combo, player->getHealth(),
                 player->getMaxHealth());
   }
@@ -363,42 +1102,61 @@ void Game::renderPlaying() {
 
 void Game::renderGameOver() {
   // Semi-transparent overlay
-  SDL_SetRenderDrawColor(renderer, 0, 0, 0, 180);
+  Draw::setColor(renderer, 0, 0, 0, 180);
   SDL_Rect overlay = {0, 0, SCREEN_WIDTH, SCREEN_HEIGHT};
-  SDL_RenderFillRect(renderer, &overlay);
+  Draw::fillRect(renderer, &overlay);
 
-  // Game Over text (placeholder rectangle)
-  SDL_SetRenderDrawColor(renderer, 255, 50, 50, 255);
-  SDL_Rect gameOverRect = {SCREEN_WIDTH / 2 - 120, 200, 240, 50};
-  SDL_RenderFillRect(renderer, &gameOverRect);
+  int centerX = SCREEN_WIDTH / 2;
+  text->addCached(*font, menuText.gameOver, centerX, 200, 6,
+                  {255, 50, 50, 255}, TextAlign::Center);
 
-  // Score display (placeholder)
-  SDL_SetRenderDrawColor(renderer, 255, 255, 255, 255);
-  SDL_Rect scoreRect = {SCREEN_WIDTH / 2 - 80, 280, 160, 30};
-  SDL_RenderFillRect(renderer, &scoreRect);
+  // "SCORE 1234" centred on the gap between label and value
+  SDL_Color white = {255, 255, 255, 255};
+  text->addCached(*font, menuText.score, centerX - 8, 285, 3, white,
+                  TextAlign::Right);
+  text->addNumber(*font, score, centerX + 8, 285, 3, white);
 
-  // Restart prompt
-  SDL_SetRenderDrawColor(renderer, 150, 150, 150, 255);
-  SDL_Rect restartRect = {SCREEN_WIDTH / 2 - 100, 350, 200, 25};
-  SDL_RenderFillRect(renderer, &restartRect);
+  text->addCached(*font, menuText.restart, centerX, 350, 2,
+                  {150, 150, 150, 255}, TextAlign::Center);
+  text->render(renderer, *font);
 }
 
 void Game::startGame() {
   // Reset game state
   score = 0;
   combo = 0;
-  comboTimer = 0.0f;
-  enemySpawnTimer = 1.0f;
   difficulty = 1.0f;
+  maxCombo = 0;
+  survivalTime = 0.0f;
+  std::fill(std::begin(kills), std::end(kills), 0);
+  shotsHit = 0;
+  shotsMissed = 0;
+  events->clear();
+
+  // Drop every pending timer along with the entities that own them
+  timers.clear();
+  comboTimer = TimerHandle{};
 
   // Clear entities
-  enemies.clear();
+  enemies->clear();
+  chunks->clear();
   playerBullets.clear();
-  enemyBullets.clear();
-  particles.clear();
-
-  // Create player
-  player = std::make_unique<Player>(SCREEN_WIDTH / 2.0f, SCREEN_HEIGHT - 80.0f);
+  enemyProjectiles->clear();
+  particles->clear();
+
+  // Create player at the bottom centre of the world
+  const WorldRect &world = camera->getWorld();
+  player = std::make_unique<Player>(world.x + world.w / 2.0f,
+                                    world.bottom() - 80.0f);
+  camera->follow(player->getPosition());
+  enemyProjectiles->setBounds(camera->getSleepRegion());
+
+  if (scenario) {
+    // The scenario supplies the load and the run must last its duration
+    player->setInvulnerable(true);
+  } else {
+    scheduleEnemySpawn(1.0f);
+  }
 
   state = GameState::Playing;
 }
@@ -406,50 +1164,178 @@ void Game::startGame() {
 void Game::endGame() {
   state = GameState::GameOver;
   createExplosion(player->getX(), player->getY(), 50, {255, 200, 100, 255});
+
+  if (!scoreStore)
+    return;
+
+  // Queued for the store's writer thread; no disk I/O here
+  RunRecord run;
+  run.timestamp = static_cast<int64_t>(std::time(nullptr));
+  run.score = score;
+  run.maxCombo = maxCombo;
+  run.survivalSeconds = survivalTime;
+  // The record layout is on disk, so a new type needs a new version
+  static_assert(std::size(RunRecord{}.kills) == ENEMY_TYPE_COUNT,
+                "RunRecord::kills must hold every enemy type");
+  for (int i = 0; i < ENEMY_TYPE_COUNT; i++) {
+    run.kills[i] = kills[i];
+  }
+
+  int rank = scoreStore->submit(run);
+  LOG_INFO("game", "Score %d, best combo x%d, survived %ds", score, maxCombo,
+           static_cast<int>(survivalTime));
+  if (rank > 0) {
+    LOG_INFO("game", "New high score #%d", rank);
+  }
 }
 
 void Game::addScore(int points) {
   combo++;
-  comboTimer = 2.0f; // Reset combo timer
   score += points * combo;
+  maxCombo = std::max(maxCombo, combo);
+
+  // Restart the combo window
+  timers.cancel(comboTimer);
+  comboTimer = timers.schedule(2.0f, [this]() { combo = 0; });
 }
 
 void Game::spawnEnemy() {
-  float x = randomFloat(50, SCREEN_WIDTH - 50);
-  float y = -50;
+  // Just above the top of the view
+  const WorldRect &view = camera->getView();
+  float x = randomFloat(view.x + 50, view.right() - 50);
+  float y = view.y - 50;
 
   // Choose enemy type based on difficulty
   int type = randomInt(0, 2);
 
-  auto enemy = std::make_unique<Enemy>(x, y, static_cast<EnemyType>(type));
-  enemies.push_back(std::move(enemy));
+  spawnEnemy(x, y, static_cast<EnemyType>(type));
 }
 
-void Game::addBullet(std::unique_ptr<Bullet> bullet) {
-  if (bullet->isPlayerBullet()) {
-    playerBullets.push_back(std::move(bullet));
-  } else {
-    enemyBullets.push_back(std::move(bullet));
+void Game::spawnEnemy(float x, float y, EnemyType type) {
+  ALLOC_SCOPE("enemies");
+  armEnemy(enemies->spawn(x, y, type), false);
+}
+
+void Game::addDormantEnemy(float x, float y, EnemyType type) {
+  ALLOC_SCOPE("world");
+  const EnemyStats &stats = enemyStats(type);
+  chunks->add(DormantEnemy{x, y, 0.0f, static_cast<int16_t>(stats.health),
+                           static_cast<uint8_t>(type)});
+}
+
+size_t Game::getEnemyCount() const { return enemies->size(); }
+
+size_t Game::getDormantCount() const { return chunks->size(); }
+
+void Game::streamWorld() {
+  // Sleepers are dropped (with their fire timers) by removeInactive
+  WorldRect sleepRegion = camera->getSleepRegion();
+  for (auto &bucket : enemies->all()) {
+    for (auto &enemy : bucket) {
+      if (!enemy.isActive() || sleepRegion.contains(enemy.getPosition()))
+        continue;
+
+      chunks->add(DormantEnemy{enemy.getX(), enemy.getY(),
+                               enemy.getAnimTimer(),
+                               static_cast<int16_t>(enemy.getHealth()),
+                               static_cast<uint8_t>(enemy.getType())});
+      enemy.setActive(false);
+      enemiesSlept++;
+    }
   }
+
+  enemiesWoken += chunks->wake(
+      camera->getActiveRegion(),
+      [this](const DormantEnemy &dormant) { wakeEnemy(dormant); });
 }
 
-void Game::addParticle(std::unique_ptr<Particle> particle) {
-  particles.push_back(std::move(particle));
+void Game::wakeEnemy(const DormantEnemy &dormant) {
+  EnemyType type = static_cast<EnemyType>(dormant.type);
+  Enemy &enemy = enemies->spawn(dormant.x, dormant.y, type);
+  enemy.restore(dormant.health, dormant.animTimer);
+  armEnemy(enemy, true); // Scripts start over; their progress isn't saved
 }
 
-void Game::createExplosion(float x, float y, int count, SDL_Color color) {
-  for (int i = 0; i < count; i++) {
-    float angle = randomFloat(0, 2.0f * 3.14159f);
-    float speed = randomFloat(50, 200);
-    float vx = std::cos(angle) * speed;
-    float vy = std::sin(angle) * speed;
-    float lifetime = randomFloat(0.3f, 0.8f);
-    float size = randomFloat(2, 6);
-
-    auto particle =
-        std::make_unique<Particle>(x, y, vx, vy, lifetime, size, color);
-    particles.push_back(std::move(particle));
+void Game::armEnemy(Enemy &enemy, bool woken) {
+  events->push(
+      EnemySpawned{enemy.getX(), enemy.getY(), enemy.getType(), woken});
+  if (enemy.getType() == EnemyType::Bomber) {
+    enemy.setScript(bomberScript(*scripts));
+    return;
   }
+  scheduleEnemyFire(enemy.getHandle(),
+                    enemy.getShootCooldown() * 0.5f); // Halfway to first shot
+}
+
+void Game::scheduleEnemySpawn(float delay) {
+  spawnTimer = timers.schedule(delay, [this]() {
+    spawnEnemy();
+    scheduleEnemySpawn(2.0f / difficulty); // Spawn faster as difficulty rises
+  });
+}
+
+void Game::scheduleEnemyFire(EnemyHandle handle, float delay) {
+  Enemy *enemy = enemies->find(handle);
+  if (!enemy)
+    return;
+
+  enemy->getFireTimer() =
+      timers.schedule(delay, [this, handle]() { fireEnemy(handle); });
+}
+
+void Game::fireEnemy(EnemyHandle handle) {
+  Enemy *enemy = enemies->find(handle);
+  if (!enemy || !enemy->isActive())
+    return;
+
+  enemy->fire(*this);
+  scheduleEnemyFire(handle, enemy->getShootCooldown());
+}
+
+void Game::addBullet(std::unique_ptr<Bullet> bullet) {
+  ALLOC_SCOPE("bullets");
+  if (!bullet->isPlayerBullet()) {
+    // Enemy fire lives in the projectile engine as a compact record
+    Vector2 velocity = bullet->getVelocity();
+    enemyProjectiles->emitStraight(bullet->getX(), bullet->getY(), velocity.x,
+                                   velocity.y);
+    return;
+  }
+
+  Bullet *b = bullet.get();
+  b->getExpiryTimer() = timers.schedule(b->getLifetime(), [this, b]() {
+    b->setActive(false);
+    events->push(BulletExpired{b->getX(), b->getY(), false});
+  });
+
+  playerBullets.push_back(std::move(bullet));
+}
+
+void Game::createExplosion(float x, float y, int count, SDL_Color color) {
+  // Bigger bursts are louder; the mixer caps overlapping explosions
+  playSound(Sound::Explosion, x, std::min(1.0f, count / 25.0f));
+
+  // Particles are only visual; nobody sees a headless game
+  if (headless)
+    return;
+
+  // A random template, turned and sped up or slowed a little, keeps
+  // bursts from repeating without any per-particle randomness
+  ALLOC_SCOPE("particles");
+  int burst = std::uniform_int_distribution<int>(
+      0, BurstLibrary::TEMPLATE_COUNT - 1)(effectsRng);
+  float rotation =
+      std::uniform_real_distribution<float>(0, 2.0f * 3.14159f)(effectsRng);
+  float speedScale =
+      std::uniform_real_distribution<float>(0.9f, 1.1f)(effectsRng);
+  particles->spawnBurst(x, y, count, color, burst, rotation, speedScale);
+  particlesSpawned += count;
+}
+
+void Game::playSound(Sound sound, float x, float gain) {
+  const WorldRect &view = camera->getView();
+  float pan = (x - view.x) / view.w * 2.0f - 1.0f;
+  audio->play(sound, gain, std::clamp(pan, -1.0f, 1.0f));
 }
 
 float Game::randomFloat(float min, float max) {
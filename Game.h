@@ -1,18 +1,44 @@
 #ifndef GAME_H
 #define GAME_H
 
+#include "BitmapFont.h"
+#include "EnemyType.h"
+#include "Telemetry.h"
+#include "TimingWheel.h"
 #include <SDL2/SDL.h>
 #include <memory>
 #include <random>
+#include <string>
 #include <vector>
 
 // Forward declarations
 class Player;
 class Enemy;
+class EnemyBatches;
+struct EnemyHandle;
+class ScriptPool;
+class GameEvents;
 class Bullet;
-class Particle;
+class ParticleSystem;
+class ProjectileSystem;
+class FlowField;
+class Camera;
+class WorldChunks;
+struct DormantEnemy;
 class Starfield;
+struct StarfieldConfig;
 class HUD;
+class Scenario;
+struct ScenarioConfig;
+class FrameStats;
+class ScoreStore;
+class AudioMixer;
+class FramePacer;
+class IdleScheduler;
+class FreezeFrame;
+class DynamicResolution;
+class FrameRecorder;
+enum class Sound;
 
 enum class GameState { Menu, Playing, Paused, GameOver };
 
@@ -23,22 +49,91 @@ public:
 
   bool init();
   void run();
+
+  // Exports live counters through a memory-mapped file; call before init()
+  bool openStatsFile(const char *path);
+
+  // Records every draw call to path for tools/draw_replay; call before
+  // init()
+  void setDrawCapture(const char *path) { capturePath = path; }
+
+  // Records one rendered frame in every to path (a .y4m video or a PNG
+  // directory) on background threads; call before init()
+  void setFrameRecording(const char *path, int every);
+
+  // Runs a stress scenario instead of the menu; call before init()
+  void setScenario(const ScenarioConfig &config);
+
+  // Fails the run on any heap allocation once this much play time has
+  // passed (needs an ALLOC_TRACK=1 build)
+  void setZeroAllocAssert(float warmupSeconds);
+  bool hasFailed() const { return failed; }
+
+  // Skips opening an audio device; call before init()
+  void setAudioEnabled(bool enabled) { audioEnabled = enabled; }
+
+  // Sleeps each frame until just before the vblank, then samples input
+  // (VSync only, so not for scenarios); call before init()
+  void setLateInput(bool enabled);
+
+  // Throttles Menu, Paused and GameOver to fps (enabled by default)
+  void setIdle(bool enabled, int fps);
+
+  // Prints CPU use per state (and the resolution report) on exit; scenarios
+  // always print their reports
+  void setExitReport(bool enabled) { exitReport = enabled; }
+
+  // Background mode, seed and density; call before init()
+  void setStarfield(const StarfieldConfig &config);
+
+  // Lowers the world's render resolution (down to minScale) while frames
+  // run over budget; the HUD stays native
+  void setDynamicResolution(bool enabled, float minScale, float maxScale);
+
+  // Size of the scrolling world (at least the screen); drops every
+  // dormant enemy
+  void setWorldSize(float width, float height);
   void cleanup();
 
+  // Headless stepping for VecEnv: no window, renderer, audio or particles
+  // (init() is never called). startHeadless() seeds the game and starts a
+  // run, step() advances it one frame with keys as the keyboard state.
+  // Games share no state, so separate games may step on separate threads.
+  void startHeadless(unsigned seed);
+  void step(const Uint8 *keys, float deltaTime);
+
   // Getters
   SDL_Renderer *getRenderer() const { return renderer; }
   int getWidth() const { return SCREEN_WIDTH; }
   int getHeight() const { return SCREEN_HEIGHT; }
+  const Camera &getCamera() const { return *camera; }
+  Player *getPlayer() { return player.get(); }
+  const Player *getPlayer() const { return player.get(); }
   GameState getState() const { return state; }
   int getScore() const { return score; }
   int getCombo() const { return combo; }
+  float getDifficulty() const { return difficulty; }
+  TimingWheel &getTimers() { return timers; }
+  ProjectileSystem &getEnemyProjectiles() { return *enemyProjectiles; }
+  const ProjectileSystem &getEnemyProjectiles() const {
+    return *enemyProjectiles;
+  }
+  const EnemyBatches &getEnemies() const { return *enemies; }
+  const std::vector<std::unique_ptr<Bullet>> &getPlayerBullets() const {
+    return playerBullets;
+  }
+  FlowField &getFlowField() { return *flowField; }
+  size_t getEnemyCount() const; // Awake only
+  size_t getDormantCount() const;
 
   // Game actions
   void addScore(int points);
   void spawnEnemy();
+  void spawnEnemy(float x, float y, EnemyType type);
+  void addDormantEnemy(float x, float y, EnemyType type); // Starts asleep
   void addBullet(std::unique_ptr<Bullet> bullet);
-  void addParticle(std::unique_ptr<Particle> particle);
   void createExplosion(float x, float y, int count, SDL_Color color);
+  void playSound(Sound sound, float x, float gain = 1.0f); // Panned by x
 
   // Random number generation
   float randomFloat(float min, float max);
@@ -56,41 +151,150 @@ private:
   void renderMenu();
   void renderPlaying();
   void renderGameOver();
+  void renderFrozen();
+  void renderFrozenLayer();
+
+  // Wakes dormant enemies entering the active region, puts those that
+  // left the sleep region back to sleep
+  void streamWorld();
+  void wakeEnemy(const DormantEnemy &dormant);
+
+  // Consumes the frame's events in batched phases: scoring, damage and
+  // HUD, particles, audio, stats
+  void applyEvents();
 
   void startGame();
   void endGame();
 
+  // Timer-driven events
+  void scheduleEnemySpawn(float delay);
+  // Starts a fresh enemy's behaviour: a script for bombers, the fire timer
+  // for the rest
+  void armEnemy(Enemy &enemy, bool woken);
+  void scheduleEnemyFire(EnemyHandle handle, float delay);
+  void fireEnemy(EnemyHandle handle);
+
+  void checkZeroAlloc(float deltaTime);
+
+  void registerCounters();
+  void publishCounters(double updateMs, double renderMs);
+
   // Constants
   static const int SCREEN_WIDTH = 800;
   static const int SCREEN_HEIGHT = 600;
+  static const int WORLD_WIDTH = 3200;
+  static const int WORLD_HEIGHT = 2400;
   static const int TARGET_FPS = 60;
+  static constexpr float SCENARIO_DT = 1.0f / TARGET_FPS;
+  static constexpr unsigned BURST_SEED = 0x5eed;
+  static constexpr size_t PARTICLE_RESERVE = 4096;
 
   // SDL
   SDL_Window *window;
   SDL_Renderer *renderer;
   bool running;
+  bool sdlStarted; // init() ran SDL_Init; headless games never do
+  bool headless;
 
   // Game state
   GameState state;
   int score;
   int combo;
-  float comboTimer;
-  float enemySpawnTimer;
   float difficulty;
 
-  // Entities
+  // Cooldowns, expiry, combo reset and spawning all run off this wheel, so
+  // per-tick cost scales with what expires rather than with entity count
+  TimingWheel timers;
+  TimerHandle comboTimer;
+  TimerHandle spawnTimer;
+
+  // Entities. Script frames live in the pool, so it outlives the enemies
+  std::unique_ptr<ScriptPool> scripts;
   std::unique_ptr<Player> player;
-  std::vector<std::unique_ptr<Enemy>> enemies;
+  std::unique_ptr<EnemyBatches> enemies;
   std::vector<std::unique_ptr<Bullet>> playerBullets;
-  std::vector<std::unique_ptr<Bullet>> enemyBullets;
-  std::vector<std::unique_ptr<Particle>> particles;
+  std::unique_ptr<ProjectileSystem> enemyProjectiles;
+  std::unique_ptr<ParticleSystem> particles;
+
+  // Collision results and spawns, applied once per frame
+  std::unique_ptr<GameEvents> events;
+  int eventsApplied; // This frame
+  int enemiesSpawned;
+  int shotsHit; // This run
+  int shotsMissed;
+
+  // World: the camera decides what is simulated and drawn, everything
+  // else sleeps in chunks
+  std::unique_ptr<Camera> camera;
+  std::unique_ptr<WorldChunks> chunks;
+  int enemiesWoken; // This frame
+  int enemiesSlept;
 
   // Systems
+  std::unique_ptr<FlowField> flowField;
   std::unique_ptr<Starfield> starfield;
   std::unique_ptr<HUD> hud;
+  std::unique_ptr<BitmapFont> font; // Atlas baked in init()
+  std::unique_ptr<TextBatch> text;  // Menu and overlay text
+  struct MenuText {
+    TextId title, start, quit, paused, resume, gameOver, score, restart;
+  } menuText;
+  std::unique_ptr<FreezeFrame> freezeFrame; // Paused/GameOver render cache
+  std::unique_ptr<DynamicResolution> resolution; // Scaled world target
+  std::unique_ptr<AudioMixer> audio;
+  bool audioEnabled;
+
+  // Stress scenario (command line) and its frame timings
+  std::unique_ptr<Scenario> scenario;
+  std::unique_ptr<FramePacer> pacer;
+  std::unique_ptr<IdleScheduler> idle;
+  bool idling; // This frame waited in the idle scheduler
+  bool exitReport;
+  std::unique_ptr<FrameStats> frameStats;
+  std::string capturePath;
+  std::unique_ptr<FrameRecorder> recorder; // Null unless recording
+  std::string recordPath;
+  int recordEvery;
+
+  // High scores and run history (not used by scenario runs)
+  std::unique_ptr<ScoreStore> scoreStore;
+  int maxCombo;
+  float survivalTime;
+  int kills[ENEMY_TYPE_COUNT]; // Per EnemyType
+
+  // Live counters, stored once per frame
+  struct Counters {
+    TelemetryCounter updateUs, renderUs, frameUs;
+    TelemetryCounter enemies[ENEMY_TYPE_COUNT]; // Per EnemyType
+    TelemetryCounter playerBullets, enemyProjectiles, particles;
+    TelemetryCounter timers, collisionPairs, particlesSpawned;
+    TelemetryCounter drawCalls, drawPrimitives, cachedBytes, renderScale;
+    TelemetryCounter difficulty, score, combo, health;
+    TelemetryCounter audioCallbackUs, audioPeakUs, audioLoad, audioVoices;
+    TelemetryCounter audioStolen, audioRejected;
+    TelemetryCounter inputLatencyUs, inputLatencyPeakUs;
+    TelemetryCounter pacerWorkUs, pacerSleepUs;
+    TelemetryCounter cpuUsage, idle;
+    TelemetryCounter dormant, woken, slept, spawned;
+    TelemetryCounter events, shotsHit, shotsMissed;
+    TelemetryCounter recordUs, recordPeakUs, recordFrames, recordDropped;
+  };
+  std::unique_ptr<Telemetry> telemetry;
+  Counters counters;
+  uint64_t frameIndex;
+  int collisionPairs;  // Tested this frame
+  int particlesSpawned; // This frame
+
+  // Zero-allocation assertion (warmup < 0 disables)
+  float zeroAllocWarmup;
+  float playTime;
+  bool failed;
 
-  // Random
+  // Random. Explosion looks draw from their own generator, so a game
+  // with particles (windowed) and one without (headless) see the same
+  // gameplay stream for the same seed
   std::mt19937 rng;
+  std::mt19937 effectsRng;
 
   // Input state
   const Uint8 *keyState;
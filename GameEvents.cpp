@@ -0,0 +1,54 @@
+#include "GameEvents.h"
+#include <algorithm>
+
+namespace {
+
+template <typename Event>
+void appendFrom(std::vector<Event> &to, const EventLane &from) {
+  const std::vector<Event> &events = from.buffer<Event>();
+  to.insert(to.end(), events.begin(), events.end());
+}
+
+} // namespace
+
+void EventLane::append(const EventLane &other) {
+  std::apply([&other](auto &...mine) { (appendFrom(mine, other), ...); },
+             buffers);
+}
+
+void EventLane::reserve(size_t perType) {
+  std::apply([perType](auto &...buffer) { (buffer.reserve(perType), ...); },
+             buffers);
+}
+
+void EventLane::clear() {
+  std::apply([](auto &...buffer) { (buffer.clear(), ...); }, buffers);
+}
+
+size_t EventLane::size() const {
+  return std::apply(
+      [](const auto &...buffer) { return (buffer.size() + ...); }, buffers);
+}
+
+GameEvents::GameEvents(int laneCount) { setLaneCount(laneCount); }
+
+void GameEvents::setLaneCount(int count) {
+  size_t first = lanes.size();
+  lanes.resize(std::max(1, count));
+  for (size_t i = first; i < lanes.size(); i++) {
+    lanes[i].reserve(LANE_CAPACITY);
+  }
+}
+
+void GameEvents::merge() {
+  for (size_t i = 1; i < lanes.size(); i++) {
+    lanes[0].append(lanes[i]);
+    lanes[i].clear();
+  }
+}
+
+void GameEvents::clear() {
+  for (auto &lane : lanes) {
+    lane.clear();
+  }
+}
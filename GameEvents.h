@@ -0,0 +1,115 @@
+#ifndef GAME_EVENTS_H
+#define GAME_EVENTS_H
+
+#include <cstddef>
+#include <cstdint>
+#include <tuple>
+#include <vector>
+
+enum class EnemyType;
+
+// Game events: plain records that detection appends and the batched
+// phases of Game::applyEvents() consume. Positions are in world space.
+
+struct EnemySpawned {
+  float x, y;
+  EnemyType type;
+  bool woken; // Back from a chunk rather than newly spawned
+};
+
+// A hit the enemy survived
+struct EnemyHit {
+  float x, y;
+  EnemyType type;
+};
+
+struct EnemyKilled {
+  float x, y;
+  EnemyType type;
+  int scoreValue;
+};
+
+enum class HitCause : uint8_t { Projectile, Ram };
+
+struct PlayerHit {
+  float x, y; // Where the blow landed (the rammer for Ram)
+  int damage;
+  HitCause cause;
+};
+
+// A player bullet gone, by hitting an enemy or running out of range or time
+struct BulletExpired {
+  float x, y;
+  bool hit;
+};
+
+// One producer's events: a buffer per type, each in push order.
+//
+// Aligned to a cache line so producers on different threads writing
+// neighbouring lanes don't share one.
+class alignas(64) EventLane {
+public:
+  template <typename Event> void push(const Event &event) {
+    buffer<Event>().push_back(event);
+  }
+
+  template <typename Event> std::vector<Event> &buffer() {
+    return std::get<std::vector<Event>>(buffers);
+  }
+  template <typename Event> const std::vector<Event> &buffer() const {
+    return std::get<std::vector<Event>>(buffers);
+  }
+
+  // Appends other's events after this lane's, type by type
+  void append(const EventLane &other);
+  void reserve(size_t perType);
+  void clear();
+  size_t size() const;
+
+private:
+  std::tuple<std::vector<EnemySpawned>, std::vector<EnemyHit>,
+             std::vector<EnemyKilled>, std::vector<PlayerHit>,
+             std::vector<BulletExpired>>
+      buffers;
+};
+
+// Per-frame event buffers with one lane per producer.
+//
+// The game thread pushes to lane 0. Worker threads each push to their own
+// lane, with no locking; merge() then appends lanes 1..n to lane 0 in
+// lane order once the workers are done. The merged order depends only on
+// which lane produced what, never on thread timing, so a frame replays
+// the same way whatever the thread count, as long as work is split
+// across lanes the same way.
+//
+// Lanes start with LANE_CAPACITY events of each type and keep what they
+// grow to across frames, so pushing doesn't allocate mid-game.
+class GameEvents {
+public:
+  // Events of each type a lane holds before it has to grow
+  static constexpr size_t LANE_CAPACITY = 256;
+
+  explicit GameEvents(int laneCount = 1);
+
+  // Producers
+  template <typename Event> void push(const Event &event) {
+    lanes[0].push(event);
+  }
+  EventLane &lane(int index) { return lanes[index]; }
+  int getLaneCount() const { return static_cast<int>(lanes.size()); }
+  void setLaneCount(int count); // Only between frames
+
+  // Consumers: call merge(), read with get(), then clear(). Consumers must
+  // not push while reading.
+  void merge();
+  template <typename Event> const std::vector<Event> &get() const {
+    return lanes[0].buffer<Event>();
+  }
+  size_t size() const { return lanes[0].size(); }
+  void clear();
+
+private:
+  std::vector<EventLane> lanes;
+};
+
+#endif // GAME_EVENTS_H
@@ -1,6 +1,11 @@
 #include "HUD.h"
+#include "Draw.h"
 
-HUD::HUD() : displayedScore(0), scoreAnimTimer(0.0f) {}
+HUD::HUD(int width, BitmapFont &hudFont)
+    : screenWidth(width), font(hudFont), scoreLabel(hudFont.cache("SCORE")),
+      comboSign(hudFont.cache("x")), displayedScore(0), scoreAnimTimer(0.0f),
+      damageFlash(0) {
+}
 
 void HUD::render(SDL_Renderer *renderer, int score, int combo, int health,
                  int maxHealth) {
@@ -10,6 +15,7 @@ void HUD::render(SDL_Renderer *renderer, int score, int combo, int health,
   if (combo > 1) {
     renderCombo(renderer, combo);
   }
+  text.render(renderer, font);
 
   // Animate score counting up
   if (displayedScore < score) {
@@ -27,14 +33,14 @@ void HUD::renderHealthBar(SDL_Renderer *renderer, int health, int maxHealth) {
   int y = 20;
 
   // Background
-  SDL_SetRenderDrawColor(renderer, 50, 50, 50, 200);
+  Draw::setColor(renderer, 50, 50, 50, 200);
   SDL_Rect bg = {x - 2, y - 2, barWidth + 4, barHeight + 4};
-  SDL_RenderFillRect(renderer, &bg);
+  Draw::fillRect(renderer, &bg);
 
   // Health bar background (dark red)
-  SDL_SetRenderDrawColor(renderer, 100, 30, 30, 255);
+  Draw::setColor(renderer, 100, 30, 30, 255);
   SDL_Rect healthBg = {x, y, barWidth, barHeight};
-  SDL_RenderFillRect(renderer, &healthBg);
+  Draw::fillRect(renderer, &healthBg);
 
   // Health bar fill
   float healthPercent = static_cast<float>(health) / maxHealth;
@@ -42,75 +48,65 @@ void HUD::renderHealthBar(SDL_Renderer *renderer, int health, int maxHealth) {
 
   // Color based on health level
   if (healthPercent > 0.6f) {
-    SDL_SetRenderDrawColor(renderer, 50, 200, 100, 255); // Green
+    Draw::setColor(renderer, 50, 200, 100, 255); // Green
   } else if (healthPercent > 0.3f) {
-    SDL_SetRenderDrawColor(renderer, 255, 200, 50, 255); // Yellow
+    Draw::setColor(renderer, 255, 200, 50, 255); // Yellow
   } else {
-    SDL_SetRenderDrawColor(renderer, 255, 80, 80, 255); // Red
+    Draw::setColor(renderer, 255, 80, 80, 255); // Red
   }
 
   SDL_Rect healthFill = {x, y, fillWidth, barHeight};
-  SDL_RenderFillRect(renderer, &healthFill);
+  Draw::fillRect(renderer, &healthFill);
 
   // Health bar shine
-  SDL_SetRenderDrawColor(renderer, 255, 255, 255, 50);
+  Draw::setColor(renderer, 255, 255, 255, 50);
   SDL_Rect shine = {x, y, fillWidth, barHeight / 3};
-  SDL_RenderFillRect(renderer, &shine);
+  Draw::fillRect(renderer, &shine);
 
   // Health segments
-  SDL_SetRenderDrawColor(renderer, 0, 0, 0, 100);
+  Draw::setColor(renderer, 0, 0, 0, 100);
   for (int i = 1; i < maxHealth; i++) {
     int segX = x + (barWidth * i / maxHealth);
-    SDL_RenderDrawLine(renderer, segX, y, segX, y + barHeight);
+    Draw::drawLine(renderer, segX, y, segX, y + barHeight);
   }
 
-  // Border
-  SDL_SetRenderDrawColor(renderer, 200, 200, 200, 255);
+  // Border, red while a hit is flashing
+  if (damageFlash > 0) {
+    damageFlash--;
+    Draw::setColor(renderer, 255, 60, 60, 255);
+  } else {
+    Draw::setColor(renderer, 200, 200, 200, 255);
+  }
   SDL_Rect border = {x - 1, y - 1, barWidth + 2, barHeight + 2};
-  SDL_RenderDrawRect(renderer, &border);
+  Draw::drawRect(renderer, &border);
 }
 
 void HUD::renderScore(SDL_Renderer *renderer, int score) {
   (void)score; // Use displayedScore instead for animation
 
   // Score display area (top right)
-  int x = 800 - 180;
+  int x = screenWidth - 180;
   int y = 20;
 
   // Background
-  SDL_SetRenderDrawColor(renderer, 30, 30, 50, 200);
+  Draw::setColor(renderer, 30, 30, 50, 200);
   SDL_Rect bg = {x, y, 160, 35};
-  SDL_RenderFillRect(renderer, &bg);
+  Draw::fillRect(renderer, &bg);
 
   // Border
-  SDL_SetRenderDrawColor(renderer, 100, 150, 255, 255);
-  SDL_RenderDrawRect(renderer, &bg);
-
-  // Score visualization (bar representing score magnitude)
-  // Each segment = 1000 points
-  int segments = displayedScore / 1000;
-  if (segments > 14)
-    segments = 14;
-
-  SDL_SetRenderDrawColor(renderer, 0, 200, 255, 255);
-  for (int i = 0; i < segments; i++) {
-    SDL_Rect seg = {x + 8 + i * 10, y + 8, 8, 18};
-    SDL_RenderFillRect(renderer, &seg);
-  }
-
-  // Partial segment for remainder
-  int remainder = (displayedScore % 1000) / 100;
-  if (segments < 14 && remainder > 0) {
-    SDL_SetRenderDrawColor(renderer, 0, 200, 255,
-                           static_cast<Uint8>(150 + remainder * 10));
-    SDL_Rect partSeg = {x + 8 + segments * 10, y + 8, 8, 18};
-    SDL_RenderFillRect(renderer, &partSeg);
-  }
+  Draw::setColor(renderer, 100, 150, 255, 255);
+  Draw::drawRect(renderer, &bg);
+
+  // Label, then the counting-up value right-aligned (formatted without
+  // allocating)
+  text.addCached(font, scoreLabel, x + 8, y + 14, 1, {100, 150, 255, 255});
+  text.addNumber(font, displayedScore, x + 152, y + 11, 2, {0, 200, 255, 255},
+                 TextAlign::Right);
 }
 
 void HUD::renderCombo(SDL_Renderer *renderer, int combo) {
   // Combo display (center top)
-  int x = 400;
+  int x = screenWidth / 2;
   int y = 25;
 
   // Combo glow based on combo level
@@ -118,9 +114,9 @@ void HUD::renderCombo(SDL_Renderer *renderer, int combo) {
   if (glowSize > 80)
     glowSize = 80;
 
-  SDL_SetRenderDrawColor(renderer, 255, 200, 50, 50);
+  Draw::setColor(renderer, 255, 200, 50, 50);
   SDL_Rect glow = {x - glowSize / 2, y - 10, glowSize, 30};
-  SDL_RenderFillRect(renderer, &glow);
+  Draw::fillRect(renderer, &glow);
 
   // Combo indicator boxes
   int numBoxes = combo;
@@ -137,18 +133,15 @@ void HUD::renderCombo(SDL_Renderer *renderer, int combo) {
     Uint8 g = static_cast<Uint8>(150 + i * 10);
     Uint8 b = static_cast<Uint8>(50 + i * 20);
 
-    SDL_SetRenderDrawColor(renderer, r, g, b, 255);
+    Draw::setColor(renderer, r, g, b, 255);
     SDL_Rect box = {startX + i * (boxWidth + 2), y, boxWidth, 15};
-    SDL_RenderFillRect(renderer, &box);
+    Draw::fillRect(renderer, &box);
   }
 
-  // "x" multiplier indicator
-  if (combo > 1) {
-    SDL_SetRenderDrawColor(renderer, 255, 255, 255, 200);
-    // Simple "x" shape
-    SDL_RenderDrawLine(renderer, x + totalWidth / 2 + 8, y + 2,
-                       x + totalWidth / 2 + 18, y + 12);
-    SDL_RenderDrawLine(renderer, x + totalWidth / 2 + 18, y + 2,
-                       x + totalWidth / 2 + 8, y + 12);
-  }
+  // "x5" multiplier
+  SDL_Color white = {255, 255, 255, 220};
+  int textX = x + totalWidth / 2 + 8;
+  text.addCached(font, comboSign, textX, y + 1, 2, white);
+  text.addNumber(font, combo, textX + BitmapFont::ADVANCE * 2, y + 1, 2,
+                 white);
 }
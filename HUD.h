@@ -1,23 +1,38 @@
 #ifndef HUD_H
 #define HUD_H
 
+#include "BitmapFont.h"
 #include <SDL2/SDL.h>
 
+// Health bar, score and combo. All text goes out in one geometry call.
 class HUD {
 public:
-  HUD();
+  // font must outlive the HUD; its labels are cached here
+  HUD(int screenWidth, BitmapFont &font);
 
   void render(SDL_Renderer *renderer, int score, int combo, int health,
               int maxHealth);
 
+  // Flashes the health bar border for the next few frames
+  void flashDamage() { damageFlash = DAMAGE_FLASH_FRAMES; }
+
 private:
+  static constexpr int DAMAGE_FLASH_FRAMES = 12;
+
   void renderHealthBar(SDL_Renderer *renderer, int health, int maxHealth);
   void renderScore(SDL_Renderer *renderer, int score);
   void renderCombo(SDL_Renderer *renderer, int combo);
 
+  int screenWidth;
+  const BitmapFont &font;
+  TextBatch text; // Reused each frame
+  TextId scoreLabel;
+  TextId comboSign;
+
   // Animation
   int displayedScore;
   float scoreAnimTimer;
+  int damageFlash; // Frames left
 };
 
 #endif // HUD_H
@@ -0,0 +1,90 @@
+#include "IdleScheduler.h"
+#include "Game.h"
+#include <cstdio>
+
+namespace {
+
+const char *stateNames[IdleScheduler::STATE_COUNT] = {"menu", "playing",
+                                                      "paused", "gameover"};
+
+} // namespace
+
+IdleScheduler::IdleScheduler()
+    : enabled(true), frequency(SDL_GetPerformanceFrequency()), lastWake(0),
+      lastCpu(std::clock()), lastWall(SDL_GetPerformanceCounter()),
+      cpuSeconds(), wallSeconds(), frames(), windowCpu(0), windowWall(0),
+      recentUsage(0) {
+  setIdleFps(DEFAULT_IDLE_FPS);
+}
+
+void IdleScheduler::setIdleFps(int fps) {
+  if (fps < 1)
+    fps = 1;
+  idlePeriod = frequency / fps;
+}
+
+bool IdleScheduler::isIdleState(GameState state) {
+  return state != GameState::Playing;
+}
+
+bool IdleScheduler::wait(GameState state) {
+  if (!enabled || !isIdleState(state))
+    return false;
+
+  Uint64 now = SDL_GetPerformanceCounter();
+  Uint64 nextWake = lastWake + idlePeriod;
+  if (now < nextWake) {
+    // A null event pointer leaves the event queued for handleEvents()
+    int timeoutMs = static_cast<int>((nextWake - now) * 1000 / frequency);
+    if (timeoutMs > 0) {
+      SDL_WaitEventTimeout(nullptr, timeoutMs);
+    }
+  }
+
+  lastWake = SDL_GetPerformanceCounter();
+  return true;
+}
+
+void IdleScheduler::endFrame(GameState state) {
+  std::clock_t cpu = std::clock();
+  Uint64 wall = SDL_GetPerformanceCounter();
+  double cpuDelta = static_cast<double>(cpu - lastCpu) / CLOCKS_PER_SEC;
+  double wallDelta = static_cast<double>(wall - lastWall) / frequency;
+  lastCpu = cpu;
+  lastWall = wall;
+
+  int index = static_cast<int>(state);
+  cpuSeconds[index] += cpuDelta;
+  wallSeconds[index] += wallDelta;
+  frames[index]++;
+
+  windowCpu += cpuDelta;
+  windowWall += wallDelta;
+  if (windowWall >= 1.0) {
+    recentUsage = windowCpu / windowWall;
+    windowCpu = 0;
+    windowWall = 0;
+  }
+}
+
+double IdleScheduler::getCpuUsage(GameState state) const {
+  int index = static_cast<int>(state);
+  return wallSeconds[index] > 0 ? cpuSeconds[index] / wallSeconds[index] : 0;
+}
+
+void IdleScheduler::report(std::ostream &out) const {
+  out << "CPU use per state (" << (enabled ? "idle throttling" : "no idle")
+      << "):" << std::endl;
+  out << "             time    frames      fps      cpu" << std::endl;
+
+  char line[128];
+  for (int i = 0; i < STATE_COUNT; i++) {
+    if (frames[i] == 0)
+      continue;
+    std::snprintf(line, sizeof(line), "  %-8s %7.1fs %9ld %8.1f %7.1f%%",
+                  stateNames[i], wallSeconds[i], frames[i],
+                  frames[i] / wallSeconds[i],
+                  100.0 * getCpuUsage(static_cast<GameState>(i)));
+    out << line << std::endl;
+  }
+}
@@ -0,0 +1,65 @@
+#ifndef IDLE_SCHEDULER_H
+#define IDLE_SCHEDULER_H
+
+#include <SDL2/SDL.h>
+#include <ctime>
+#include <ostream>
+
+enum class GameState;
+
+// Throttles the loop while no gameplay is running, and measures CPU use
+// per game state.
+//
+// In Menu, Paused and GameOver nothing moves but the starfield, so the
+// loop blocks in SDL_WaitEventTimeout until the next idle tick (idleFps)
+// or until an event arrives, whichever is first. Input is handled on the
+// frame it wakes, and Playing always runs at full rate, so any state
+// change back to gameplay resumes the normal loop at once.
+//
+// CPU use is process CPU time (std::clock) over wall time, accumulated
+// for the state each frame ran in; compare a run against --no-idle.
+class IdleScheduler {
+public:
+  static constexpr int STATE_COUNT = 4;
+  static constexpr int DEFAULT_IDLE_FPS = 10;
+
+  IdleScheduler();
+
+  void setEnabled(bool on) { enabled = on; }
+  bool isEnabled() const { return enabled; }
+  void setIdleFps(int fps);
+
+  static bool isIdleState(GameState state);
+
+  // In an idle state, blocks until the next idle tick or an event (left
+  // queued for the event loop). Returns true if it waited.
+  bool wait(GameState state);
+
+  // Charges the time since the last call to the state the frame ran in
+  void endFrame(GameState state);
+
+  // Fraction of one core, over the whole run / the last full second
+  double getCpuUsage(GameState state) const;
+  double getRecentCpuUsage() const { return recentUsage; }
+
+  void report(std::ostream &out) const;
+
+private:
+  bool enabled;
+  Uint64 frequency;
+  Uint64 idlePeriod; // Ticks between idle frames
+  Uint64 lastWake;
+
+  std::clock_t lastCpu;
+  Uint64 lastWall;
+  double cpuSeconds[STATE_COUNT];
+  double wallSeconds[STATE_COUNT];
+  long frames[STATE_COUNT];
+
+  // Rolling one-second window
+  double windowCpu;
+  double windowWall;
+  double recentUsage;
+};
+
+#endif // IDLE_SCHEDULER_H
@@ -0,0 +1,540 @@
+#include "Log.h"
+#include <algorithm>
+#include <chrono>
+#include <cerrno>
+#include <cstdarg>
+#include <csignal>
+#include <cstdlib>
+#include <cstring>
+#include <mutex>
+#include <thread>
+
+#ifdef _WIN32
+#include <io.h>
+#else
+#include <unistd.h>
+#endif
+
+// Bounded multi-producer queue (Vyukov): each cell's sequence says whether
+// it is free for the producer at that position or ready for the consumer
+struct alignas(64) LogCell {
+  std::atomic<uint64_t> sequence;
+  LogEntry entry;
+};
+
+namespace {
+
+constexpr uint32_t MASK = Log::CAPACITY - 1;
+static_assert((Log::CAPACITY & MASK) == 0, "capacity must be a power of two");
+
+struct Ring {
+  Ring() {
+    for (uint32_t i = 0; i < Log::CAPACITY; i++) {
+      cells[i].sequence.store(i, std::memory_order_relaxed);
+    }
+  }
+
+  LogCell cells[Log::CAPACITY];
+  alignas(64) std::atomic<uint64_t> enqueuePos{0};
+  alignas(64) std::atomic<uint64_t> dequeuePos{0};
+  alignas(64) std::atomic<uint64_t> written{0};
+  std::atomic<uint64_t> dropped{0};
+};
+
+Ring ring;
+
+struct Rule {
+  char module[32];
+  LogLevel level;
+};
+
+constexpr int MAX_RULES = 16;
+
+// Guards the site registry and filter rules (never the hot path)
+std::mutex configMutex;
+LogSite *sites = nullptr;
+Rule rules[MAX_RULES];
+int ruleCount = 0;
+LogLevel defaultLevel = LogLevel::Info;
+
+std::atomic<FILE *> output{nullptr};
+// The crash handler writes to descriptors, never through stdio: the crash
+// may land while another thread holds a FILE lock. -1 means stdout or
+// stderr by level, like a null output.
+std::atomic<int> outputFd{-1};
+std::atomic<bool> running{false};
+std::atomic<bool> stopping{false};
+std::thread writer;
+std::mutex drainMutex; // One formatter at a time (writer or a flush)
+
+const auto startTime = std::chrono::steady_clock::now();
+std::atomic<uint32_t> nextThreadId{0};
+thread_local uint32_t threadId = 0;
+
+const int CRASH_SIGNALS[] = {SIGSEGV, SIGABRT, SIGFPE, SIGILL,
+#ifdef SIGBUS
+                             SIGBUS
+#endif
+};
+
+const char *levelName(LogLevel level) {
+  switch (level) {
+  case LogLevel::Debug:
+    return "DEBUG";
+  case LogLevel::Info:
+    return "INFO";
+  case LogLevel::Warn:
+    return "WARN";
+  case LogLevel::Error:
+    return "ERROR";
+  case LogLevel::Off:
+    break;
+  }
+  return "";
+}
+
+// Caller holds configMutex
+LogLevel levelFor(const char *module) {
+  for (int i = 0; i < ruleCount; i++) {
+    if (std::strcmp(rules[i].module, module) == 0)
+      return rules[i].level;
+  }
+  return defaultLevel;
+}
+
+bool siteEnabled(const LogSite &site) {
+  LogLevel minimum = levelFor(site.module);
+  return minimum != LogLevel::Off && site.level >= minimum;
+}
+
+bool tryPop(LogEntry &entry) {
+  uint64_t pos = ring.dequeuePos.load(std::memory_order_relaxed);
+  while (true) {
+    LogCell &cell = ring.cells[pos & MASK];
+    uint64_t seq = cell.sequence.load(std::memory_order_acquire);
+    int64_t diff = static_cast<int64_t>(seq) - static_cast<int64_t>(pos + 1);
+
+    if (diff == 0) {
+      if (ring.dequeuePos.compare_exchange_weak(pos, pos + 1,
+                                                std::memory_order_relaxed)) {
+        entry = cell.entry;
+        cell.sequence.store(pos + Log::CAPACITY, std::memory_order_release);
+        return true;
+      }
+    } else if (diff < 0) {
+      return false; // Empty (or the next entry is still being written)
+    } else {
+      pos = ring.dequeuePos.load(std::memory_order_relaxed);
+    }
+  }
+}
+
+void append(char *out, size_t capacity, size_t &used, const char *spec,
+            ...) __attribute__((format(printf, 4, 5)));
+
+void append(char *out, size_t capacity, size_t &used, const char *spec, ...) {
+  if (used + 1 >= capacity)
+    return;
+  va_list args;
+  va_start(args, spec);
+  int n = std::vsnprintf(out + used, capacity - used, spec, args);
+  va_end(args);
+  if (n > 0)
+    used = std::min(used + n, capacity - 1);
+}
+
+// Re-expands the format with the stored arguments, one conversion at a time
+size_t formatEntry(const LogEntry &entry, char *out, size_t capacity) {
+  size_t used = 0;
+  double seconds = entry.time / 1e9;
+  append(out, capacity, used, "[%10.4f] %-5s %s: ", seconds,
+         levelName(entry.site->level), entry.site->module);
+
+  const char *f = entry.site->format;
+  int argIndex = 0;
+  while (*f && used + 1 < capacity) {
+    if (*f != '%') {
+      out[used++] = *f++;
+      continue;
+    }
+    if (f[1] == '%') {
+      out[used++] = '%';
+      f += 2;
+      continue;
+    }
+
+    // Copy flags, width and precision; drop length modifiers
+    char spec[32];
+    size_t specLength = 0;
+    spec[specLength++] = *f++;
+    while (*f && std::strchr("-+ #0123456789.", *f) && specLength < 24) {
+      spec[specLength++] = *f++;
+    }
+    while (*f && std::strchr("hlLqjzt", *f)) {
+      f++;
+    }
+    char conversion = *f;
+    if (!conversion)
+      break;
+    f++;
+
+    if (argIndex >= entry.argCount) {
+      append(out, capacity, used, "<?>");
+      continue;
+    }
+    LogArgType type = entry.types[argIndex];
+    const LogValue &arg = entry.values[argIndex++];
+
+    if (type == LogArgType::String) {
+      spec[specLength++] = 's';
+      spec[specLength] = '\0';
+      append(out, capacity, used, spec, entry.text + arg.text.offset);
+      continue;
+    }
+
+    switch (conversion) {
+    case 'd':
+    case 'i':
+    case 'c':
+      if (conversion == 'c') {
+        spec[specLength++] = 'c';
+      } else {
+        spec[specLength++] = 'l';
+        spec[specLength++] = 'l';
+        spec[specLength++] = 'd';
+      }
+      spec[specLength] = '\0';
+      if (conversion == 'c') {
+        append(out, capacity, used, spec, static_cast<int>(arg.i));
+      } else {
+        append(out, capacity, used, spec,
+               static_cast<long long>(type == LogArgType::Double
+                                          ? static_cast<int64_t>(arg.d)
+                                          : arg.i));
+      }
+      break;
+    case 'u':
+    case 'x':
+    case 'X':
+    case 'o':
+      spec[specLength++] = 'l';
+      spec[specLength++] = 'l';
+      spec[specLength++] = conversion;
+      spec[specLength] = '\0';
+      append(out, capacity, used, spec, static_cast<unsigned long long>(arg.u));
+      break;
+    case 'p':
+      spec[specLength++] = 'p';
+      spec[specLength] = '\0';
+      append(out, capacity, used, spec, const_cast<void *>(arg.p));
+      break;
+    default: // Floating point conversions
+      spec[specLength++] = conversion;
+      spec[specLength] = '\0';
+      append(out, capacity, used, spec,
+             type == LogArgType::Double
+                 ? arg.d
+                 : static_cast<double>(type == LogArgType::Int
+                                           ? arg.i
+                                           : static_cast<int64_t>(arg.u)));
+      break;
+    }
+  }
+
+  out[used++] = '\n';
+  return used;
+}
+
+void writeLine(const LogEntry &entry) {
+  char line[512];
+  size_t length = formatEntry(entry, line, sizeof(line));
+
+  FILE *file = output.load(std::memory_order_relaxed);
+  if (!file)
+    file = entry.site->level >= LogLevel::Warn ? stderr : stdout;
+  std::fwrite(line, 1, length, file);
+}
+
+// Formats everything currently in the ring; returns entries written
+uint64_t drain() {
+  LogEntry entry;
+  uint64_t count = 0;
+  while (tryPop(entry)) {
+    writeLine(entry);
+    count++;
+  }
+
+  static uint64_t reportedDrops = 0;
+  uint64_t drops = ring.dropped.load(std::memory_order_relaxed);
+  if (drops != reportedDrops) {
+    std::fprintf(stderr, "[log] %llu entries dropped (ring full)\n",
+                 static_cast<unsigned long long>(drops - reportedDrops));
+    reportedDrops = drops;
+  }
+
+  if (count > 0) {
+    FILE *file = output.load(std::memory_order_relaxed);
+    std::fflush(file ? file : stdout);
+    std::fflush(stderr);
+    ring.written.fetch_add(count, std::memory_order_release);
+  }
+  return count;
+}
+
+void writerLoop() {
+  while (true) {
+    uint64_t count;
+    {
+      std::lock_guard<std::mutex> lock(drainMutex);
+      count = drain();
+    }
+    if (count == 0) {
+      if (stopping.load(std::memory_order_acquire))
+        return;
+      std::this_thread::sleep_for(std::chrono::milliseconds(1));
+    }
+  }
+}
+
+void writeFd(int fd, const char *data, size_t size) {
+  while (size > 0) {
+#ifdef _WIN32
+    int n = _write(fd, data, static_cast<unsigned>(size));
+#else
+    ssize_t n = ::write(fd, data, size);
+    if (n < 0 && errno == EINTR)
+      continue;
+#endif
+    if (n <= 0)
+      return;
+    data += n;
+    size -= static_cast<size_t>(n);
+  }
+}
+
+// Writes out what the crashing process logged, then lets the default
+// action (core dump / abort) happen. Lines are formatted into a static
+// buffer and written straight to the descriptor, so nothing here takes a
+// stdio lock. Lines the writer thread had already buffered in stdio but
+// not flushed are lost.
+void crashHandler(int signal) {
+  static LogEntry entry;
+  static char line[512];
+  int fd = outputFd.load(std::memory_order_relaxed);
+  while (tryPop(entry)) {
+    size_t length = formatEntry(entry, line, sizeof(line));
+    int target = fd;
+    if (target < 0) {
+      target = entry.site->level >= LogLevel::Warn ? 2 : 1;
+    }
+    writeFd(target, line, length);
+  }
+
+  std::signal(signal, SIG_DFL);
+  std::raise(signal);
+}
+
+} // namespace
+
+LogSite::LogSite(LogLevel l, const char *m, const char *f)
+    : level(l), module(m), format(f), enabled(false), next(nullptr) {
+  Log::registerSite(*this);
+}
+
+void Log::registerSite(LogSite &site) {
+  std::lock_guard<std::mutex> lock(configMutex);
+  site.next = sites;
+  sites = &site;
+  site.enabled.store(siteEnabled(site), std::memory_order_relaxed);
+}
+
+void Log::refreshSites() {
+  for (LogSite *site = sites; site; site = site->next) {
+    site->enabled.store(siteEnabled(*site), std::memory_order_relaxed);
+  }
+}
+
+void Log::start() {
+  if (running.exchange(true))
+    return;
+
+  stopping.store(false);
+  writer = std::thread(writerLoop);
+
+  for (int signal : CRASH_SIGNALS) {
+    std::signal(signal, crashHandler);
+  }
+
+  static bool atExitRegistered = false;
+  if (!atExitRegistered) {
+    std::atexit(shutdown);
+    atExitRegistered = true;
+  }
+}
+
+void Log::shutdown() {
+  if (!running.exchange(false)) {
+    // No writer: format anything left on the calling thread
+    std::lock_guard<std::mutex> lock(drainMutex);
+    drain();
+    return;
+  }
+
+  stopping.store(true, std::memory_order_release);
+  if (writer.joinable())
+    writer.join();
+
+  std::lock_guard<std::mutex> lock(drainMutex);
+  drain();
+}
+
+void Log::flush() {
+  if (!running.load()) {
+    std::lock_guard<std::mutex> lock(drainMutex);
+    drain();
+    return;
+  }
+
+  // Everything claimed before this point must be written
+  uint64_t target = ring.enqueuePos.load(std::memory_order_acquire);
+  while (ring.written.load(std::memory_order_acquire) < target) {
+    std::this_thread::sleep_for(std::chrono::microseconds(100));
+  }
+}
+
+void Log::setLevel(LogLevel level) {
+  std::lock_guard<std::mutex> lock(configMutex);
+  defaultLevel = level;
+  refreshSites();
+}
+
+void Log::setModuleLevel(const char *module, LogLevel level) {
+  std::lock_guard<std::mutex> lock(configMutex);
+
+  int index = 0;
+  while (index < ruleCount && std::strcmp(rules[index].module, module) != 0) {
+    index++;
+  }
+  if (index == ruleCount) {
+    if (ruleCount == MAX_RULES)
+      return;
+    ruleCount++;
+  }
+
+  std::strncpy(rules[index].module, module, sizeof(rules[index].module) - 1);
+  rules[index].module[sizeof(rules[index].module) - 1] = '\0';
+  rules[index].level = level;
+  refreshSites();
+}
+
+bool Log::parseLevel(const char *name, LogLevel &level) {
+  const char *names[] = {"debug", "info", "warn", "error", "off"};
+  for (int i = 0; i < 5; i++) {
+    if (std::strcmp(name, names[i]) == 0) {
+      level = static_cast<LogLevel>(i);
+      return true;
+    }
+  }
+  return false;
+}
+
+bool Log::configure(const char *spec) {
+  char buffer[256];
+  std::strncpy(buffer, spec, sizeof(buffer) - 1);
+  buffer[sizeof(buffer) - 1] = '\0';
+
+  for (char *token = std::strtok(buffer, ","); token;
+       token = std::strtok(nullptr, ",")) {
+    LogLevel level;
+    char *equals = std::strchr(token, '=');
+    if (!equals) {
+      if (!parseLevel(token, level))
+        return false;
+      setLevel(level);
+      continue;
+    }
+
+    *equals = '\0';
+    if (!parseLevel(equals + 1, level))
+      return false;
+    setModuleLevel(token, level);
+  }
+  return true;
+}
+
+void Log::setOutput(FILE *file) {
+  int fd = -1;
+  if (file) {
+#ifdef _WIN32
+    fd = _fileno(file);
+#else
+    fd = fileno(file);
+#endif
+  }
+  outputFd.store(fd, std::memory_order_relaxed);
+  output.store(file, std::memory_order_relaxed);
+}
+
+uint64_t Log::getDropped() {
+  return ring.dropped.load(std::memory_order_relaxed);
+}
+
+LogCell *Log::beginEntry(const LogSite &site, LogEntry *&entry) {
+  uint64_t pos = ring.enqueuePos.load(std::memory_order_relaxed);
+  LogCell *cell;
+  while (true) {
+    cell = &ring.cells[pos & MASK];
+    uint64_t seq = cell->sequence.load(std::memory_order_acquire);
+    int64_t diff = static_cast<int64_t>(seq) - static_cast<int64_t>(pos);
+
+    if (diff == 0) {
+      if (ring.enqueuePos.compare_exchange_weak(pos, pos + 1,
+                                                std::memory_order_relaxed))
+        break;
+    } else if (diff < 0) {
+      ring.dropped.fetch_add(1, std::memory_order_relaxed);
+      return nullptr;
+    } else {
+      pos = ring.enqueuePos.load(std::memory_order_relaxed);
+    }
+  }
+
+  if (threadId == 0)
+    threadId = nextThreadId.fetch_add(1, std::memory_order_relaxed) + 1;
+
+  entry = &cell->entry;
+  entry->site = &site;
+  entry->time = std::chrono::duration_cast<std::chrono::nanoseconds>(
+                    std::chrono::steady_clock::now() - startTime)
+                    .count();
+  entry->thread = threadId;
+  entry->argCount = 0;
+  entry->textUsed = 0;
+  return cell;
+}
+
+void Log::commitEntry(LogCell *cell) {
+  // The producer owns the cell, so its sequence still equals its position
+  uint64_t seq = cell->sequence.load(std::memory_order_relaxed);
+  cell->sequence.store(seq + 1, std::memory_order_release);
+}
+
+void Log::addString(LogEntry &entry, LogValue &slot, const char *s) {
+  size_t room = LogEntry::TEXT_BYTES - entry.textUsed;
+  if (room == 0) {
+    // Out of text space: point at the final terminator
+    slot.text.offset = LogEntry::TEXT_BYTES - 1;
+    slot.text.length = 0;
+    return;
+  }
+
+  size_t length = s ? std::strlen(s) : 0;
+  length = std::min(length, room - 1);
+
+  slot.text.offset = entry.textUsed;
+  slot.text.length = static_cast<uint16_t>(length);
+  if (length > 0)
+    std::memcpy(entry.text + entry.textUsed, s, length);
+  entry.text[entry.textUsed + length] = '\0';
+  entry.textUsed = static_cast<uint8_t>(entry.textUsed + length + 1);
+}
@@ -0,0 +1,164 @@
+#ifndef LOG_H
+#define LOG_H
+
+#include <atomic>
+#include <cstdint>
+#include <cstdio>
+#include <type_traits>
+
+// Asynchronous logger. A call site records a binary entry - its static
+// LogSite (format string, module, level) plus the raw arguments - into a
+// lock-free ring; a background thread formats and writes it. The caller
+// never formats, locks or touches a stream.
+//
+//   LOG_INFO("game", "Score %d, best combo x%d", score, maxCombo);
+//
+// Formats are printf-style and checked by the compiler. String arguments
+// (const char *) are copied into the entry, up to TEXT_BYTES in total.
+// When the ring is full the entry is dropped and counted.
+
+enum class LogLevel : uint8_t { Debug, Info, Warn, Error, Off };
+
+struct LogCell;
+
+class LogSite {
+public:
+  LogSite(LogLevel level, const char *module, const char *format);
+
+  bool isEnabled() const { return enabled.load(std::memory_order_relaxed); }
+
+  const LogLevel level;
+  const char *const module;
+  const char *const format;
+
+private:
+  friend class Log;
+  std::atomic<bool> enabled;
+  LogSite *next; // Registry of every site seen so far
+};
+
+enum class LogArgType : uint8_t { Int, UInt, Double, String, Pointer };
+
+union LogValue {
+  int64_t i;
+  uint64_t u;
+  double d;
+  const void *p;
+  struct {
+    uint16_t offset;
+    uint16_t length;
+  } text;
+};
+
+// Laid out so the header and the first three argument values share one
+// cache line: a typical call writes a single line of the ring
+struct LogEntry {
+  static constexpr int MAX_ARGS = 8;
+  static constexpr int TEXT_BYTES = 64;
+
+  const LogSite *site;
+  uint64_t time; // Nanoseconds since process start
+  uint32_t thread;
+  uint8_t argCount;
+  uint8_t textUsed;
+  LogArgType types[MAX_ARGS];
+  LogValue values[MAX_ARGS];
+  char text[TEXT_BYTES];
+};
+
+class Log {
+public:
+  static constexpr uint32_t CAPACITY = 4096; // Entries, power of two
+
+  // Starts the writer thread and installs crash handlers that flush
+  static void start();
+  // Drains the ring and stops the writer (also run at exit)
+  static void shutdown();
+  // Blocks until everything logged so far has been written
+  static void flush();
+
+  // Minimum level for every module without its own rule
+  static void setLevel(LogLevel level);
+  static void setModuleLevel(const char *module, LogLevel level);
+  // "warn" or "info,game=debug,scores=error"; false on a bad spec
+  static bool configure(const char *spec);
+  static bool parseLevel(const char *name, LogLevel &level);
+
+  // Where formatted lines go: nullptr restores stdout (Debug/Info) and
+  // stderr (Warn/Error)
+  static void setOutput(FILE *file);
+
+  static uint64_t getDropped();
+
+  template <typename... Args>
+  static void write(const LogSite &site, const Args &...args) {
+    static_assert(sizeof...(Args) <= LogEntry::MAX_ARGS,
+                  "too many log arguments");
+    LogEntry *entry;
+    LogCell *cell = beginEntry(site, entry);
+    if (!cell)
+      return;
+    (addArg(*entry, args), ...);
+    commitEntry(cell);
+  }
+
+private:
+  // Claims a ring cell (nullptr and a drop when full) and stamps the entry
+  static LogCell *beginEntry(const LogSite &site, LogEntry *&entry);
+  static void commitEntry(LogCell *cell);
+  static void addString(LogEntry &entry, LogValue &slot, const char *s);
+
+  template <typename T> static void addArg(LogEntry &entry, const T &value) {
+    int index = entry.argCount++;
+    LogArgType &type = entry.types[index];
+    LogValue &slot = entry.values[index];
+    if constexpr (std::is_same_v<T, bool> || std::is_enum_v<T>) {
+      type = LogArgType::Int;
+      slot.i = static_cast<int64_t>(value);
+    } else if constexpr (std::is_integral_v<T> && std::is_signed_v<T>) {
+      type = LogArgType::Int;
+      slot.i = value;
+    } else if constexpr (std::is_integral_v<T>) {
+      type = LogArgType::UInt;
+      slot.u = value;
+    } else if constexpr (std::is_floating_point_v<T>) {
+      type = LogArgType::Double;
+      slot.d = value;
+    } else if constexpr (std::is_convertible_v<T, const char *>) {
+      type = LogArgType::String;
+      addString(entry, slot, value);
+    } else {
+      static_assert(std::is_pointer_v<T>, "unsupported log argument type");
+      type = LogArgType::Pointer;
+      slot.p = value;
+    }
+  }
+
+  friend class LogSite;
+  static void registerSite(LogSite &site);
+  // Recomputes every site's enabled flag; caller holds the config lock
+  static void refreshSites();
+};
+
+// Never called; lets the compiler check formats against their arguments
+#if defined(__GNUC__) || defined(__clang__)
+__attribute__((format(printf, 1, 2)))
+#endif
+inline void logFormatCheck(const char *, ...) {}
+
+#define LOG_AT(level, module, format, ...)                                     \
+  do {                                                                         \
+    static LogSite logSite(level, module, format);                             \
+    if (logSite.isEnabled()) {                                                 \
+      if (false)                                                               \
+        logFormatCheck(format, ##__VA_ARGS__);                                 \
+      Log::write(logSite, ##__VA_ARGS__);                                      \
+    }                                                                          \
+  } while (0)
+
+#define LOG_DEBUG(module, ...) LOG_AT(LogLevel::Debug, module, __VA_ARGS__)
+#define LOG_INFO(module, ...) LOG_AT(LogLevel::Info, module, __VA_ARGS__)
+#define LOG_WARN(module, ...) LOG_AT(LogLevel::Warn, module, __VA_ARGS__)
+#define LOG_ERROR(module, ...) LOG_AT(LogLevel::Error, module, __VA_ARGS__)
+
+#endif // LOG_H
@@ -0,0 +1,174 @@
+#include "ParticleSystem.h"
+#include "Draw.h"
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+#include <random>
+
+BurstLibrary::BurstLibrary(unsigned seed) {
+  std::mt19937 rng(seed);
+  std::uniform_real_distribution<float> angle(0, 2.0f * 3.14159f);
+  std::uniform_real_distribution<float> speeds(50, 200);
+  std::uniform_real_distribution<float> lifetimes(0.3f, 0.8f);
+  std::uniform_real_distribution<float> sizes(2, 6);
+
+  for (int t = 0; t < TEMPLATE_COUNT; t++) {
+    for (int i = 0; i < BURST_SIZE; i++) {
+      float a = angle(rng);
+      dirX[t][i] = std::cos(a);
+      dirY[t][i] = std::sin(a);
+      speed[t][i] = speeds(rng);
+      lifetime[t][i] = lifetimes(rng);
+      size[t][i] = sizes(rng);
+    }
+  }
+}
+
+ParticleSystem::ParticleSystem(unsigned seed) : library(seed) {}
+
+void ParticleSystem::resize(size_t count) {
+  x.resize(count);
+  y.resize(count);
+  vx.resize(count);
+  vy.resize(count);
+  life.resize(count);
+  maxLife.resize(count);
+  sizes.resize(count);
+  colors.resize(count);
+}
+
+void ParticleSystem::reserve(size_t count) {
+  x.reserve(count);
+  y.reserve(count);
+  vx.reserve(count);
+  vy.reserve(count);
+  life.reserve(count);
+  maxLife.reserve(count);
+  sizes.reserve(count);
+  colors.reserve(count);
+}
+
+size_t ParticleSystem::grow(size_t count) {
+  size_t first = x.size();
+  resize(first + count);
+  return first;
+}
+
+void ParticleSystem::spawnBurst(float originX, float originY, int count,
+                                SDL_Color color, int templateIndex,
+                                float rotation, float speedScale) {
+  float c = std::cos(rotation) * speedScale;
+  float s = std::sin(rotation) * speedScale;
+
+  while (count > 0) {
+    int n = std::min(count, BurstLibrary::BURST_SIZE);
+    int t = templateIndex % BurstLibrary::TEMPLATE_COUNT;
+    size_t first = grow(n);
+
+    const float *dx = library.dirX[t];
+    const float *dy = library.dirY[t];
+    const float *speed = library.speed[t];
+    float *outX = x.data() + first;
+    float *outY = y.data() + first;
+    float *outVX = vx.data() + first;
+    float *outVY = vy.data() + first;
+
+    // Straight-line loops over plain arrays, so the compiler vectorizes
+    for (int i = 0; i < n; i++) {
+      outX[i] = originX;
+      outY[i] = originY;
+      outVX[i] = (dx[i] * c - dy[i] * s) * speed[i];
+      outVY[i] = (dx[i] * s + dy[i] * c) * speed[i];
+    }
+    std::memcpy(life.data() + first, library.lifetime[t], n * sizeof(float));
+    std::memcpy(maxLife.data() + first, library.lifetime[t],
+                n * sizeof(float));
+    std::memcpy(sizes.data() + first, library.size[t], n * sizeof(float));
+    std::fill_n(colors.data() + first, n, color);
+
+    count -= n;
+    templateIndex++;
+  }
+}
+
+void ParticleSystem::add(float px, float py, float pvx, float pvy,
+                         float lifetime, float size, SDL_Color color) {
+  size_t i = grow(1);
+  x[i] = px;
+  y[i] = py;
+  vx[i] = pvx;
+  vy[i] = pvy;
+  life[i] = lifetime;
+  maxLife[i] = lifetime;
+  sizes[i] = size;
+  colors[i] = color;
+}
+
+void ParticleSystem::update(float deltaTime) {
+  size_t count = x.size();
+  size_t expired = 0;
+
+  // Integrate with drag, shrink as the lifetime runs down
+  for (size_t i = 0; i < count; i++) {
+    x[i] += vx[i] * deltaTime;
+    y[i] += vy[i] * deltaTime;
+    vx[i] *= 0.98f;
+    vy[i] *= 0.98f;
+    life[i] -= deltaTime;
+    sizes[i] *= 0.99f + 0.01f * std::max(life[i], 0.0f) / maxLife[i];
+    expired += life[i] <= 0.0f;
+  }
+  if (expired == 0)
+    return;
+
+  // Stable compaction, so draw order stays spawn order
+  size_t write = 0;
+  for (size_t read = 0; read < count; read++) {
+    if (life[read] <= 0.0f)
+      continue;
+    if (write != read) {
+      x[write] = x[read];
+      y[write] = y[read];
+      vx[write] = vx[read];
+      vy[write] = vy[read];
+      life[write] = life[read];
+      maxLife[write] = maxLife[read];
+      sizes[write] = sizes[read];
+      colors[write] = colors[read];
+    }
+    write++;
+  }
+  resize(write);
+}
+
+void ParticleSystem::render(SDL_Renderer *renderer, const WorldRect &visible) {
+  for (size_t i = 0; i < x.size(); i++) {
+    if (!visible.contains(Vector2(x[i], y[i])))
+      continue;
+
+    // Fade out over lifetime
+    const SDL_Color &color = colors[i];
+    float lifePercent = life[i] / maxLife[i];
+    Uint8 alpha = static_cast<Uint8>(color.a * lifePercent);
+    Draw::setColor(renderer, color.r, color.g, color.b, alpha);
+
+    float size = sizes[i];
+    int halfSize = static_cast<int>(size / 2);
+    SDL_Rect rect = {static_cast<int>(x[i]) - halfSize,
+                     static_cast<int>(y[i]) - halfSize,
+                     static_cast<int>(size), static_cast<int>(size)};
+    Draw::fillRect(renderer, &rect);
+
+    // Brighter core
+    if (size > 3) {
+      Draw::setColor(renderer, 255, 255, 255, alpha / 2);
+      int coreSize = static_cast<int>(size / 3);
+      SDL_Rect core = {static_cast<int>(x[i]) - coreSize / 2,
+                       static_cast<int>(y[i]) - coreSize / 2, coreSize,
+                       coreSize};
+      Draw::fillRect(renderer, &core);
+    }
+  }
+}
+
+void ParticleSystem::clear() { resize(0); }
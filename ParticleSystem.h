@@ -0,0 +1,74 @@
+#ifndef PARTICLE_SYSTEM_H
+#define PARTICLE_SYSTEM_H
+
+#include "Camera.h"
+#include <SDL2/SDL.h>
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+// Explosion shapes generated once from a seed: TEMPLATE_COUNT bursts of
+// BURST_SIZE particles, each a unit direction, speed, lifetime and size
+// drawn from the same ranges explosions always used. Entries within a
+// burst are independent, so any prefix of one is itself a valid burst.
+struct BurstLibrary {
+  static constexpr int TEMPLATE_COUNT = 16;
+  static constexpr int BURST_SIZE = 64;
+
+  explicit BurstLibrary(unsigned seed);
+
+  // [template][particle]
+  float dirX[TEMPLATE_COUNT][BURST_SIZE];
+  float dirY[TEMPLATE_COUNT][BURST_SIZE];
+  float speed[TEMPLATE_COUNT][BURST_SIZE];
+  float lifetime[TEMPLATE_COUNT][BURST_SIZE];
+  float size[TEMPLATE_COUNT][BURST_SIZE];
+};
+
+// Visual particles in structure-of-arrays form. A particle lives until its
+// lifetime runs out (no timers), drifting with drag, shrinking and fading.
+//
+// Spawning a burst copies a template with a rotation and speed scale
+// applied, with no trig or random numbers per particle. update() integrates
+// and compacts in one pass, keeping spawn order, so draw order is stable.
+// The arrays keep their capacity, so in steady state nothing allocates.
+class ParticleSystem {
+public:
+  explicit ParticleSystem(unsigned seed);
+
+  // Spawns count particles at (x, y) from burst template (wrapping), turned
+  // by rotation radians with speeds multiplied by speedScale. Counts over
+  // BURST_SIZE continue with the following templates.
+  void spawnBurst(float x, float y, int count, SDL_Color color,
+                  int templateIndex, float rotation, float speedScale);
+
+  // One particle, for effects that aren't bursts
+  void add(float x, float y, float vx, float vy, float lifetime, float size,
+           SDL_Color color);
+
+  // Room for count particles before spawning has to grow the arrays
+  void reserve(size_t count);
+
+  void update(float deltaTime);
+  // Draws the particles inside visible
+  void render(SDL_Renderer *renderer, const WorldRect &visible);
+  void clear();
+
+  size_t size() const { return x.size(); }
+  const BurstLibrary &getLibrary() const { return library; }
+
+private:
+  void resize(size_t count);
+  // Grows every array by count; returns the first new index
+  size_t grow(size_t count);
+
+  BurstLibrary library;
+
+  std::vector<float> x, y;
+  std::vector<float> vx, vy;
+  std::vector<float> life, maxLife;
+  std::vector<float> sizes;
+  std::vector<SDL_Color> colors;
+};
+
+#endif // PARTICLE_SYSTEM_H
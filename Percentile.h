@@ -0,0 +1,18 @@
+#ifndef PERCENTILE_H
+#define PERCENTILE_H
+
+#include <algorithm>
+#include <cstddef>
+#include <vector>
+
+// Nearest-rank percentile (p in 0..1) of an already sorted series; zero
+// when it is empty. Shared by every report that prints p50/p95/p99.
+template <typename T> T percentile(const std::vector<T> &sorted, double p) {
+  if (sorted.empty())
+    return T();
+  size_t rank = static_cast<size_t>(p * sorted.size() + 0.999999);
+  rank = std::clamp<size_t>(rank, 1, sorted.size());
+  return sorted[rank - 1];
+}
+
+#endif // PERCENTILE_H
@@ -1,11 +1,16 @@
 #include "Player.h"
+#include "AllocTracker.h"
+#include "AudioMixer.h"
 #include "Bullet.h"
+#include "Camera.h"
+#include "Draw.h"
 #include "Game.h"
 #include <cmath>
 
 Player::Player(float x, float y)
     : Entity(x, y, 40, 50), speed(300.0f), shootCooldown(0.15f),
-      shootTimer(0.0f), health(5), maxHealth(5), engineFlicker(0.0f) {
+      shotReady(true), health(5), maxHealth(5), invulnerable(false),
+      engineFlicker(0.0f) {
 
   color = {0, 200, 255, 255}; // Cyan player ship
 }
@@ -16,18 +21,15 @@ void Player::update(float deltaTime, const Uint8 *keyState, Game &game) {
   // Apply velocity
   Entity::update(deltaTime);
 
-  // Keep player on screen
-  clampToScreen(game.getWidth(), game.getHeight());
+  // Keep player inside the world (the camera follows)
+  clampToWorld(game.getCamera().getWorld());
 
-  // Update shoot timer
-  if (shootTimer > 0) {
-    shootTimer -= deltaTime;
-  }
-
-  // Shoot if space is pressed
-  if (keyState[SDL_SCANCODE_SPACE] && shootTimer <= 0) {
+  // Shoot if space is pressed; the cooldown timer re-arms the gun
+  if (keyState[SDL_SCANCODE_SPACE] && shotReady) {
     shoot(game);
-    shootTimer = shootCooldown;
+    shotReady = false;
+    cooldownTimer = game.getTimers().schedule(
+        shootCooldown, [this]() { shotReady = true; });
   }
 
   // Update engine flicker for visual effect
@@ -57,30 +59,36 @@ void Player::handleInput(const Uint8 *keyState) {
 }
 
 void Player::shoot(Game &game) {
+  ALLOC_SCOPE("bullets");
+
   // Create bullet at player's position
   auto bullet = std::make_unique<Bullet>(position.x, position.y - height / 2, 0,
                                          -500.0f, // Shoot upward
                                          true     // Player bullet
   );
   game.addBullet(std::move(bullet));
+  game.playSound(Sound::PlayerShot, position.x);
 }
 
-void Player::clampToScreen(int screenWidth, int screenHeight) {
+void Player::clampToWorld(const WorldRect &world) {
   // Add padding for wings (10px extra on each side)
   float paddingX = width / 2 + 10;
   float paddingY = height / 2 + 5;
 
-  if (position.x < paddingX)
-    position.x = paddingX;
-  if (position.x > screenWidth - paddingX)
-    position.x = screenWidth - paddingX;
-  if (position.y < paddingY)
-    position.y = paddingY;
-  if (position.y > screenHeight - paddingY)
-    position.y = screenHeight - paddingY;
+  if (position.x < world.x + paddingX)
+    position.x = world.x + paddingX;
+  if (position.x > world.right() - paddingX)
+    position.x = world.right() - paddingX;
+  if (position.y < world.y + paddingY)
+    position.y = world.y + paddingY;
+  if (position.y > world.bottom() - paddingY)
+    position.y = world.bottom() - paddingY;
 }
 
 void Player::takeDamage(int amount) {
+  if (invulnerable)
+    return;
+
   health -= amount;
   if (health < 0)
     health = 0;
@@ -88,31 +96,31 @@ void Player::takeDamage(int amount) {
 
 void Player::render(SDL_Renderer *renderer) {
   // Draw ship body (triangle-ish shape using rectangles)
-  SDL_SetRenderDrawColor(renderer, color.r, color.g, color.b, color.a);
+  Draw::setColor(renderer, color.r, color.g, color.b, color.a);
 
   // Main body
   SDL_Rect body = {static_cast<int>(position.x - 15),
                    static_cast<int>(position.y - 20), 30, 40};
-  SDL_RenderFillRect(renderer, &body);
+  Draw::fillRect(renderer, &body);
 
   // Nose
   SDL_Rect nose = {static_cast<int>(position.x - 8),
                    static_cast<int>(position.y - 30), 16, 15};
-  SDL_RenderFillRect(renderer, &nose);
+  Draw::fillRect(renderer, &nose);
 
   // Wings
-  SDL_SetRenderDrawColor(renderer, 0, 150, 200, 255);
+  Draw::setColor(renderer, 0, 150, 200, 255);
   SDL_Rect leftWing = {static_cast<int>(position.x - 25),
                        static_cast<int>(position.y), 12, 20};
   SDL_Rect rightWing = {static_cast<int>(position.x + 13),
                         static_cast<int>(position.y), 12, 20};
-  SDL_RenderFillRect(renderer, &leftWing);
-  SDL_RenderFillRect(renderer, &rightWing);
+  Draw::fillRect(renderer, &leftWing);
+  Draw::fillRect(renderer, &rightWing);
 
   // Engine glow (flickering)
   int glowIntensity = static_cast<int>(150 + 100 * std::sin(engineFlicker));
-  SDL_SetRenderDrawColor(renderer, 255, glowIntensity, 50, 255);
+  Draw::setColor(renderer, 255, glowIntensity, 50, 255);
   SDL_Rect engine = {static_cast<int>(position.x - 8),
                      static_cast<int>(position.y + 15), 16, 10};
-  SDL_RenderFillRect(renderer, &engine);
+  Draw::fillRect(renderer, &engine);
 }
@@ -2,8 +2,10 @@
 #define PLAYER_H
 
 #include "Entity.h"
+#include "TimingWheel.h"
 
 class Game;
+struct WorldRect;
 
 class Player : public Entity {
 public:
@@ -13,20 +15,24 @@ public:
   void render(SDL_Renderer *renderer) override;
 
   void takeDamage(int amount);
+  void setInvulnerable(bool value) { invulnerable = value; }
 
   int getHealth() const { return health; }
   int getMaxHealth() const { return maxHealth; }
+  bool isShotReady() const { return shotReady; }
 
 private:
   void handleInput(const Uint8 *keyState);
   void shoot(Game &game);
-  void clampToScreen(int screenWidth, int screenHeight);
+  void clampToWorld(const WorldRect &world);
 
   float speed;
   float shootCooldown;
-  float shootTimer;
+  bool shotReady;
+  TimerHandle cooldownTimer;
   int health;
   int maxHealth;
+  bool invulnerable;
 
   // Visual
   float engineFlicker;
@@ -0,0 +1,110 @@
+#include "Profiler.h"
+#include "Draw.h"
+#include <cstdio>
+
+ProfileRing::ProfileRing(uint32_t id)
+    : depth(0), events(CAPACITY), head(0), threadId(id) {}
+
+Profiler &Profiler::get() {
+  static Profiler profiler;
+  return profiler;
+}
+
+Profiler::Profiler() : frameCursor(0), lastFrameMark(0), graphVisible(false) {
+  frameTimes.fill(0.0f);
+}
+
+ProfileRing &Profiler::threadRing() {
+  thread_local ProfileRing *ring = &get().registerThread();
+  return *ring;
+}
+
+ProfileRing &Profiler::registerThread() {
+  std::lock_guard<std::mutex> lock(registryMutex);
+  rings.push_back(
+      std::make_unique<ProfileRing>(static_cast<uint32_t>(rings.size() + 1)));
+  return *rings.back();
+}
+
+void Profiler::endFrame() {
+  uint64_t now = SDL_GetPerformanceCounter();
+  if (lastFrameMark != 0) {
+    float ms = static_cast<float>(now - lastFrameMark) * 1000.0f /
+               SDL_GetPerformanceFrequency();
+    frameTimes[frameCursor] = ms;
+    frameCursor = (frameCursor + 1) % GRAPH_FRAMES;
+  }
+  lastFrameMark = now;
+}
+
+void Profiler::renderFrameGraph(SDL_Renderer *renderer, int x, int y) {
+  if (!graphVisible)
+    return;
+
+  const int height = 80;
+  const float pixelsPerMs = height / 50.0f; // Full height = 50 ms
+
+  // Background
+  Draw::setColor(renderer, 0, 0, 0, 160);
+  SDL_Rect bg = {x, y, GRAPH_FRAMES, height};
+  Draw::fillRect(renderer, &bg);
+
+  // One bar per frame, oldest on the left
+  for (int i = 0; i < GRAPH_FRAMES; i++) {
+    float ms = frameTimes[(frameCursor + i) % GRAPH_FRAMES];
+    int barHeight = static_cast<int>(ms * pixelsPerMs);
+    if (barHeight > height)
+      barHeight = height;
+
+    if (ms <= 16.7f) {
+      Draw::setColor(renderer, 50, 200, 100, 255); // Green
+    } else if (ms <= 33.4f) {
+      Draw::setColor(renderer, 255, 200, 50, 255); // Yellow
+    } else {
+      Draw::setColor(renderer, 255, 80, 80, 255); // Red
+    }
+    Draw::drawLine(renderer, x + i, y + height, x + i,
+                   y + height - barHeight);
+  }
+
+  // 60 FPS and 30 FPS budget lines
+  Draw::setColor(renderer, 255, 255, 255, 120);
+  int line60 = y + height - static_cast<int>(16.7f * pixelsPerMs);
+  int line30 = y + height - static_cast<int>(33.4f * pixelsPerMs);
+  Draw::drawLine(renderer, x, line60, x + GRAPH_FRAMES, line60);
+  Draw::drawLine(renderer, x, line30, x + GRAPH_FRAMES, line30);
+}
+
+bool Profiler::dumpChromeTrace(const char *path) {
+  FILE *file = std::fopen(path, "w");
+  if (!file)
+    return false;
+
+  const double usPerTick = 1e6 / SDL_GetPerformanceFrequency();
+  bool first = true;
+
+  std::fputs("{\"traceEvents\":[\n", file);
+
+  std::lock_guard<std::mutex> lock(registryMutex);
+  for (const auto &ring : rings) {
+    uint64_t head = ring->getHead();
+    uint64_t begin =
+        head > ProfileRing::CAPACITY ? head - ProfileRing::CAPACITY : 0;
+
+    for (uint64_t i = begin; i < head; i++) {
+      const ProfileEvent &e = ring->at(i);
+      std::fprintf(file,
+                   "%s{\"name\":\"%s\",\"ph\":\"X\",\"ts\":%.3f,"
+                   "\"dur\":%.3f,\"pid\":1,\"tid\":%u,"
+                   "\"args\":{\"depth\":%u}}",
+                   first ? "" : ",\n", e.name, e.start * usPerTick,
+                   (e.end - e.start) * usPerTick, ring->getThreadId(),
+                   e.depth);
+      first = false;
+    }
+  }
+
+  std::fputs("\n]}\n", file);
+  std::fclose(file);
+  return true;
+}
@@ -0,0 +1,121 @@
+#ifndef PROFILER_H
+#define PROFILER_H
+
+#include <SDL2/SDL.h>
+#include <array>
+#include <atomic>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <vector>
+
+// Scoped frame profiler. Markers are compiled in only with -DSTELLAR_PROFILE
+// (make PROFILE=1); otherwise PROFILE_SCOPE/PROFILE_FRAME expand to nothing.
+//
+//   PROFILE_SCOPE("collide.enemies");   // until the end of the block
+//   PROFILE_FRAME();                    // once per frame, after present
+//
+// Names must be string literals: only the pointer is recorded.
+
+struct ProfileEvent {
+  const char *name;
+  uint64_t start;
+  uint64_t end;
+  uint32_t depth;
+};
+
+// Single-producer ring owned by one thread. The owner publishes each event
+// with a release store of the head; readers snapshot with an acquire load.
+class ProfileRing {
+public:
+  static constexpr uint32_t CAPACITY = 1 << 15;
+
+  explicit ProfileRing(uint32_t threadId);
+
+  void push(const ProfileEvent &event) {
+    uint64_t h = head.load(std::memory_order_relaxed);
+    events[h & (CAPACITY - 1)] = event;
+    head.store(h + 1, std::memory_order_release);
+  }
+
+  uint64_t getHead() const { return head.load(std::memory_order_acquire); }
+  const ProfileEvent &at(uint64_t index) const {
+    return events[index & (CAPACITY - 1)];
+  }
+  uint32_t getThreadId() const { return threadId; }
+
+  uint32_t depth;
+
+private:
+  std::vector<ProfileEvent> events;
+  std::atomic<uint64_t> head;
+  uint32_t threadId;
+};
+
+class Profiler {
+public:
+  static Profiler &get();
+
+  // Ring for the calling thread, registered on first use
+  static ProfileRing &threadRing();
+
+  // Closes the current frame and records its duration for the graph
+  void endFrame();
+
+  void toggleGraph() { graphVisible = !graphVisible; }
+  bool isGraphVisible() const { return graphVisible; }
+  void renderFrameGraph(SDL_Renderer *renderer, int x, int y);
+
+  // Writes every buffered event as Chrome trace_event JSON
+  // (load in chrome://tracing or ui.perfetto.dev)
+  bool dumpChromeTrace(const char *path);
+
+private:
+  Profiler();
+  ProfileRing &registerThread();
+
+  static constexpr int GRAPH_FRAMES = 240;
+
+  std::mutex registryMutex; // Taken once per thread, never per event
+  std::vector<std::unique_ptr<ProfileRing>> rings;
+
+  std::array<float, GRAPH_FRAMES> frameTimes;
+  int frameCursor;
+  uint64_t lastFrameMark;
+  bool graphVisible;
+};
+
+class ProfileScope {
+public:
+  explicit ProfileScope(const char *n)
+      : ring(Profiler::threadRing()), name(n),
+        start(SDL_GetPerformanceCounter()) {
+    ring.depth++;
+  }
+
+  ~ProfileScope() {
+    ring.depth--;
+    ring.push({name, start, SDL_GetPerformanceCounter(), ring.depth});
+  }
+
+  ProfileScope(const ProfileScope &) = delete;
+  ProfileScope &operator=(const ProfileScope &) = delete;
+
+private:
+  ProfileRing &ring;
+  const char *name;
+  uint64_t start;
+};
+
+#ifdef STELLAR_PROFILE
+#define PROFILE_CONCAT_INNER(a, b) a##b
+#define PROFILE_CONCAT(a, b) PROFILE_CONCAT_INNER(a, b)
+#define PROFILE_SCOPE(name)                                                    \
+  ProfileScope PROFILE_CONCAT(profileScope, __LINE__)(name)
+#define PROFILE_FRAME() Profiler::get().endFrame()
+#else
+#define PROFILE_SCOPE(name) ((void)0)
+#define PROFILE_FRAME() ((void)0)
+#endif
+
+#endif // PROFILER_H
@@ -0,0 +1,204 @@
+#include "ProjectileSystem.h"
+#include "Draw.h"
+#include <algorithm>
+#include <cmath>
+#include <limits>
+
+ProjectileSystem::ProjectileSystem(float width, float height, SDL_Color c)
+    : now(0.0f), minX(-20.0f), minY(-20.0f), maxX(width + 100.0f),
+      maxY(height + 100.0f), color(c) {}
+
+void ProjectileSystem::setBounds(const WorldRect &bounds) {
+  minX = bounds.x;
+  minY = bounds.y;
+  maxX = bounds.right();
+  maxY = bounds.bottom();
+}
+
+void ProjectileSystem::emitStraight(float x, float y, float vx, float vy) {
+  emit(ProjectilePattern::Straight, x, y, vx, vy, 0.0f);
+}
+
+void ProjectileSystem::emitSpread(float x, float y, float vx, float vy,
+                                  int count, float lateralSpeed,
+                                  float lateralSpacing) {
+  // Shots are centered on the origin: count 3 gives offsets -1, 0, +1
+  float center = (count - 1) * 0.5f;
+  for (int i = 0; i < count; i++) {
+    float offset = i - center;
+    emit(ProjectilePattern::Spread, x + offset * lateralSpacing, y,
+         vx + offset * lateralSpeed, vy, 0.0f);
+  }
+}
+
+void ProjectileSystem::emitSpiral(float x, float y, int arms, float speed,
+                                  float spin, float phase) {
+  for (int i = 0; i < arms; i++) {
+    float angle = phase + i * (2.0f * 3.14159f / arms);
+    emit(ProjectilePattern::Spiral, x, y, std::cos(angle) * speed,
+         std::sin(angle) * speed, spin);
+  }
+}
+
+void ProjectileSystem::emitAimed(float x, float y, float targetX,
+                                 float targetY, float speed) {
+  Vector2 dir = Vector2(targetX - x, targetY - y).normalized();
+  if (dir.magnitudeSquared() == 0) {
+    dir = Vector2(0, 1); // Target on top of the emitter: fire straight down
+  }
+  emit(ProjectilePattern::Aimed, x, y, dir.x * speed, dir.y * speed, 0.0f);
+}
+
+void ProjectileSystem::emit(ProjectilePattern pattern, float x, float y,
+                            float vx, float vy, float spin) {
+  Projectile p;
+  p.spawnTime = now;
+  p.expireTime = now + solveExpiry(x, y, vx, vy, spin);
+  p.originX = x;
+  p.originY = y;
+  p.vx = vx;
+  p.vy = vy;
+  p.spin = spin;
+  p.pattern = pattern;
+  projectiles.push_back(p);
+}
+
+float ProjectileSystem::solveExpiry(float x, float y, float vx, float vy,
+                                    float spin) const {
+  const float inf = std::numeric_limits<float>::infinity();
+
+  if (spin != 0.0f) {
+    // Radius grows at |v|; gone once it passes the farthest bounds corner
+    float speed = std::sqrt(vx * vx + vy * vy);
+    if (speed <= 0)
+      return LIFETIME;
+    float dx = std::max(x - minX, maxX - x);
+    float dy = std::max(y - minY, maxY - y);
+    return std::min(LIFETIME, std::sqrt(dx * dx + dy * dy) / speed);
+  }
+
+  // Straight line: first time either axis leaves its slab
+  float tx = vx > 0 ? (maxX - x) / vx : vx < 0 ? (minX - x) / vx : inf;
+  float ty = vy > 0 ? (maxY - y) / vy : vy < 0 ? (minY - y) / vy : inf;
+  return std::min(LIFETIME, std::min(tx, ty));
+}
+
+Vector2 ProjectileSystem::positionAt(const Projectile &p) const {
+  float t = now - p.spawnTime;
+
+  if (p.spin == 0.0f) {
+    return Vector2(p.originX + p.vx * t, p.originY + p.vy * t);
+  }
+
+  float angle = p.spin * t;
+  float c = std::cos(angle);
+  float s = std::sin(angle);
+  return Vector2(p.originX + (p.vx * c - p.vy * s) * t,
+                 p.originY + (p.vx * s + p.vy * c) * t);
+}
+
+void ProjectileSystem::update(float deltaTime) {
+  now += deltaTime;
+
+  // Stable compaction, starting at the first expired record so quiet ticks
+  // only pay for the scan
+  size_t write = 0;
+  while (write < projectiles.size() && projectiles[write].expireTime > now) {
+    write++;
+  }
+  for (size_t read = write; read < projectiles.size(); read++) {
+    projectiles[write] = projectiles[read];
+    write += projectiles[read].expireTime > now;
+  }
+  projectiles.resize(write);
+}
+
+int ProjectileSystem::collide(const SDL_Rect &box) {
+  const float halfW = WIDTH / 2;
+  const float halfH = HEIGHT / 2;
+  const float left = box.x - halfW;
+  const float right = box.x + box.w + halfW;
+  const float top = box.y - halfH;
+  const float bottom = box.y + box.h + halfH;
+
+  // Spiral shots sit on a circle of radius |v| * t around their origin, so
+  // the trig is only paid when that circle can reach the expanded box
+  const float centerX = (left + right) * 0.5f;
+  const float centerY = (top + bottom) * 0.5f;
+  const float reach = std::sqrt((right - left) * (right - left) +
+                                (bottom - top) * (bottom - top)) *
+                      0.5f;
+
+  int hits = 0;
+  for (auto &p : projectiles) {
+    float t = now - p.spawnTime;
+    float x;
+    float y;
+
+    if (p.spin == 0.0f) {
+      x = p.originX + p.vx * t;
+      y = p.originY + p.vy * t;
+    } else {
+      float dx = centerX - p.originX;
+      float dy = centerY - p.originY;
+      float radius = std::sqrt(p.vx * p.vx + p.vy * p.vy) * t;
+      float dist = std::sqrt(dx * dx + dy * dy);
+      if (std::fabs(dist - radius) > reach)
+        continue;
+
+      Vector2 pos = positionAt(p);
+      x = pos.x;
+      y = pos.y;
+    }
+
+    bool hit = (x > left) & (x < right) & (y > top) & (y < bottom) &
+               (p.expireTime > now);
+    if (hit) {
+      p.expireTime = now; // Removed on the next update
+      hits++;
+    }
+  }
+  return hits;
+}
+
+void ProjectileSystem::render(SDL_Renderer *renderer,
+                              const WorldRect &visible) {
+  glowRects.clear();
+  coreRects.clear();
+  centerRects.clear();
+
+  for (const auto &p : projectiles) {
+    if (p.expireTime <= now)
+      continue;
+
+    Vector2 pos = positionAt(p);
+    if (!visible.contains(pos))
+      continue;
+
+    int x = static_cast<int>(pos.x);
+    int y = static_cast<int>(pos.y);
+    glowRects.push_back({x - 5, y - 8, 10, 16});
+    coreRects.push_back({x - 3, y - 6, 6, 12});
+    centerRects.push_back({x - 1, y - 4, 2, 8});
+  }
+
+  if (glowRects.empty())
+    return;
+
+  // One batched call per layer instead of three calls per bullet
+  int count = static_cast<int>(glowRects.size());
+
+  Draw::setColor(renderer, color.r, color.g, color.b, 100);
+  Draw::fillRects(renderer, glowRects.data(), count);
+
+  Draw::setColor(renderer, color.r, color.g, color.b, 255);
+  Draw::fillRects(renderer, coreRects.data(), count);
+
+  Draw::setColor(renderer, 255, 255, 255, 200);
+  Draw::fillRects(renderer, centerRects.data(), count);
+}
+
+void ProjectileSystem::clear() {
+  projectiles.clear();
+  now = 0.0f;
+}
@@ -0,0 +1,82 @@
+#ifndef PROJECTILE_SYSTEM_H
+#define PROJECTILE_SYSTEM_H
+
+#include "Camera.h"
+#include "Vector2.h"
+#include <SDL2/SDL.h>
+#include <cstdint>
+#include <vector>
+
+enum class ProjectilePattern : uint8_t {
+  Straight, // Single shot along its velocity
+  Spread,   // Fan of parallel-offset shots (Bomber cluster bombs)
+  Spiral,   // Rotating velocity, traces an outward spiral
+  Aimed     // Straight shot toward a target at emission time
+};
+
+// Compact bullet record. Nothing is integrated per tick: position is a pure
+// function of (origin, velocity, spin, now - spawnTime), and expireTime is
+// solved at emission from the lifetime and the bounds current at the time.
+struct Projectile {
+  float spawnTime;
+  float expireTime;
+  float originX, originY;
+  float vx, vy;
+  float spin; // Angular velocity in rad/s, non-zero only for Spiral
+  ProjectilePattern pattern;
+};
+
+class ProjectileSystem {
+public:
+  ProjectileSystem(float width, float height, SDL_Color color);
+
+  // Region projectiles live in (the camera's sleep region in a scrolling
+  // world); only affects projectiles emitted afterwards
+  void setBounds(const WorldRect &bounds);
+
+  // Emitters
+  void emitStraight(float x, float y, float vx, float vy);
+  void emitSpread(float x, float y, float vx, float vy, int count,
+                  float lateralSpeed, float lateralSpacing);
+  void emitSpiral(float x, float y, int arms, float speed, float spin,
+                  float phase);
+  void emitAimed(float x, float y, float targetX, float targetY, float speed);
+
+  // Advance the clock and drop projectiles whose expiry has passed
+  void update(float deltaTime);
+
+  // Kill every projectile overlapping the box; returns how many hit
+  int collide(const SDL_Rect &box);
+
+  // Draws the projectiles inside visible
+  void render(SDL_Renderer *renderer, const WorldRect &visible);
+  void clear();
+
+  Vector2 positionAt(const Projectile &p) const;
+  size_t size() const { return projectiles.size(); }
+  const std::vector<Projectile> &all() const { return projectiles; }
+  float getTime() const { return now; }
+
+  static constexpr float LIFETIME = 3.0f;
+  static constexpr float WIDTH = 6.0f;
+  static constexpr float HEIGHT = 12.0f;
+
+private:
+  void emit(ProjectilePattern pattern, float x, float y, float vx, float vy,
+            float spin);
+  float solveExpiry(float x, float y, float vx, float vy, float spin) const;
+
+  std::vector<Projectile> projectiles;
+  float now;
+
+  // Bounds used to solve off-screen expiry
+  float minX, minY, maxX, maxY;
+  SDL_Color color;
+
+  // Reused each frame so rendering never allocates in steady state
+  std::vector<SDL_Rect> glowRects;
+  std::vector<SDL_Rect> coreRects;
+  std::vector<SDL_Rect> centerRects;
+};
+
+#endif // PROJECTILE_SYSTEM_H
@@ -0,0 +1,174 @@
+#include "Scenario.h"
+#include "Camera.h"
+#include "Game.h"
+#include "Player.h"
+#include "ProjectileSystem.h"
+#include <algorithm>
+#include <cmath>
+
+namespace {
+
+// DormantWorld: one enemy per SPACING x SPACING on average, so the world
+// grows with the count and the awake population stays the same
+constexpr float DORMANT_SPACING = 256.0f;
+constexpr float SWEEP_SPEED = 1200.0f; // Player speed, pixels per second
+
+int defaultCount(ScenarioKind kind) {
+  switch (kind) {
+  case ScenarioKind::Enemies:
+    return 200;
+  case ScenarioKind::BomberStorm:
+    return 120;
+  case ScenarioKind::ExplosionFlood:
+    return 10; // Explosions per frame
+  case ScenarioKind::BulletCurtain:
+    return 8; // Emitters
+  case ScenarioKind::DormantWorld:
+    return 100000;
+  }
+  return 0;
+}
+
+} // namespace
+
+Scenario::Scenario(const ScenarioConfig &config)
+    : config(config),
+      count(config.count > 0 ? config.count : defaultCount(config.kind)),
+      elapsed(0.0f), phase(0.0f) {}
+
+bool Scenario::parseKind(const std::string &name, ScenarioKind &kind) {
+  if (name == "enemies") {
+    kind = ScenarioKind::Enemies;
+  } else if (name == "bomber-storm") {
+    kind = ScenarioKind::BomberStorm;
+  } else if (name == "explosion-flood") {
+    kind = ScenarioKind::ExplosionFlood;
+  } else if (name == "bullet-curtain") {
+    kind = ScenarioKind::BulletCurtain;
+  } else if (name == "dormant-world") {
+    kind = ScenarioKind::DormantWorld;
+  } else {
+    return false;
+  }
+  return true;
+}
+
+bool Scenario::parseEnemyType(const std::string &name, EnemyType &type) {
+  if (name == "drifter") {
+    type = EnemyType::Drifter;
+  } else if (name == "hunter") {
+    type = EnemyType::Hunter;
+  } else if (name == "bomber") {
+    type = EnemyType::Bomber;
+  } else {
+    return false;
+  }
+  return true;
+}
+
+const char *Scenario::kindName(ScenarioKind kind) {
+  switch (kind) {
+  case ScenarioKind::Enemies:
+    return "enemies";
+  case ScenarioKind::BomberStorm:
+    return "bomber-storm";
+  case ScenarioKind::ExplosionFlood:
+    return "explosion-flood";
+  case ScenarioKind::BulletCurtain:
+    return "bullet-curtain";
+  case ScenarioKind::DormantWorld:
+    return "dormant-world";
+  }
+  return "unknown";
+}
+
+void Scenario::start(Game &game) {
+  elapsed = 0.0f;
+  phase = 0.0f;
+  if (config.kind == ScenarioKind::DormantWorld) {
+    populateWorld(game);
+  }
+  update(0.0f, game);
+}
+
+void Scenario::update(float deltaTime, Game &game) {
+  elapsed += deltaTime;
+
+  switch (config.kind) {
+  case ScenarioKind::Enemies:
+    topUpEnemies(game, config.enemyType);
+    break;
+  case ScenarioKind::BomberStorm:
+    topUpEnemies(game, EnemyType::Bomber);
+    break;
+  case ScenarioKind::ExplosionFlood:
+    floodExplosions(game);
+    break;
+  case ScenarioKind::BulletCurtain:
+    phase += deltaTime * 2.0f;
+    fireCurtain(game);
+    break;
+  case ScenarioKind::DormantWorld:
+    sweepPlayer(game);
+    break;
+  }
+}
+
+void Scenario::topUpEnemies(Game &game, EnemyType type) {
+  // Replacements enter from a band above the view so the wave keeps
+  // streaming in instead of arriving as one clump
+  const WorldRect &view = game.getCamera().getView();
+  for (size_t alive = game.getEnemyCount(); alive < static_cast<size_t>(count);
+       alive++) {
+    float x = game.randomFloat(view.x + 50, view.right() - 50.0f);
+    float y = view.y + game.randomFloat(-300.0f, -40.0f);
+    game.spawnEnemy(x, y, type);
+  }
+}
+
+void Scenario::floodExplosions(Game &game) {
+  const WorldRect &view = game.getCamera().getView();
+  for (int i = 0; i < count; i++) {
+    float x = game.randomFloat(view.x, view.right());
+    float y = game.randomFloat(view.y, view.bottom());
+    game.createExplosion(x, y, 20, {255, 150, 50, 255});
+  }
+}
+
+void Scenario::fireCurtain(Game &game) {
+  // Evenly spaced emitters along the top edge, alternating spin direction
+  const WorldRect &view = game.getCamera().getView();
+  float spacing = view.w / (count + 1);
+  for (int i = 0; i < count; i++) {
+    float spin = (i % 2 == 0) ? 1.5f : -1.5f;
+    game.getEnemyProjectiles().emitSpiral(view.x + spacing * (i + 1),
+                                          view.y + 60.0f, 6, 150.0f, spin,
+                                          phase + i);
+  }
+}
+
+void Scenario::populateWorld(Game &game) {
+  float side = DORMANT_SPACING * std::sqrt(static_cast<float>(count));
+  game.setWorldSize(side, side);
+
+  const WorldRect &world = game.getCamera().getWorld();
+  for (int i = 0; i < count; i++) {
+    float x = game.randomFloat(world.x, world.right());
+    float y = game.randomFloat(world.y, world.bottom());
+    game.addDormantEnemy(x, y, static_cast<EnemyType>(game.randomInt(0, 2)));
+  }
+}
+
+void Scenario::sweepPlayer(Game &game) {
+  // A circle through most of the world at a constant speed, so chunks
+  // keep waking ahead of the player and falling asleep behind it
+  Player *player = game.getPlayer();
+  if (!player)
+    return;
+
+  const WorldRect &world = game.getCamera().getWorld();
+  float radius = std::min(world.w, world.h) * 0.35f;
+  float angle = elapsed * SWEEP_SPEED / std::max(radius, 1.0f);
+  player->setPosition(world.x + world.w * 0.5f + radius * std::cos(angle),
+                      world.y + world.h * 0.5f + radius * std::sin(angle));
+}
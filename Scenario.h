@@ -0,0 +1,56 @@
+#ifndef SCENARIO_H
+#define SCENARIO_H
+
+#include "Enemy.h"
+#include <string>
+
+class Game;
+
+enum class ScenarioKind {
+  Enemies,        // Keeps `count` enemies of one type on screen
+  BomberStorm,    // Keeps a large Bomber wave (spread fire) on screen
+  ExplosionFlood, // `count` createExplosion calls every frame
+  BulletCurtain,  // `count` spiral emitters firing every frame
+  DormantWorld    // `count` sleeping enemies in a world the player sweeps
+};
+
+struct ScenarioConfig {
+  ScenarioKind kind = ScenarioKind::Enemies;
+  unsigned seed = 1;
+  float duration = 10.0f; // Simulated seconds
+  int count = 0;          // 0 picks the scenario's default
+  EnemyType enemyType = EnemyType::Drifter;
+};
+
+// Scripted stress load for reproducible performance runs. The game runs it
+// with a fixed timestep and seed, so two runs do the same work frame for
+// frame; only the timings differ.
+class Scenario {
+public:
+  explicit Scenario(const ScenarioConfig &config);
+
+  static bool parseKind(const std::string &name, ScenarioKind &kind);
+  static bool parseEnemyType(const std::string &name, EnemyType &type);
+  static const char *kindName(ScenarioKind kind);
+
+  void start(Game &game);
+  void update(float deltaTime, Game &game);
+
+  bool isFinished() const { return elapsed >= config.duration; }
+  const ScenarioConfig &getConfig() const { return config; }
+  int getCount() const { return count; }
+
+private:
+  void topUpEnemies(Game &game, EnemyType type);
+  void floodExplosions(Game &game);
+  void fireCurtain(Game &game);
+  void populateWorld(Game &game);
+  void sweepPlayer(Game &game);
+
+  ScenarioConfig config;
+  int count;
+  float elapsed;
+  float phase; // Curtain rotation
+};
+
+#endif // SCENARIO_H
@@ -0,0 +1,409 @@
+#include "ScoreStore.h"
+#include "Log.h"
+#include <algorithm>
+#include <array>
+#include <cinttypes>
+#include <cstddef>
+#include <cstdio>
+#include <cstring>
+#include <ctime>
+#include <filesystem>
+
+#ifndef _WIN32
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <unistd.h>
+#endif
+
+namespace {
+
+constexpr uint32_t RECORD_MARKER = 0x4E555253; // "SRUN"
+constexpr size_t RECORD_BYTES = 8 + sizeof(RunRecord) + 4;
+
+constexpr char INDEX_MAGIC[8] = {'S', 'T', 'L', 'R', 'T', 'O', 'P', 'N'};
+constexpr uint32_t INDEX_VERSION = 1;
+
+struct IndexFile {
+  char magic[8];
+  uint32_t version;
+  uint32_t count;
+  uint64_t logSize;  // Log bytes this snapshot covers
+  uint64_t runCount; // Runs ever recorded (survives compaction)
+  RunRecord top[ScoreStore::TOP_COUNT];
+  uint32_t crc; // Of every byte before this field
+};
+
+static_assert(sizeof(RunRecord) == 32, "RunRecord must not contain padding");
+
+std::array<uint32_t, 256> makeCrcTable() {
+  std::array<uint32_t, 256> table;
+  for (uint32_t i = 0; i < 256; i++) {
+    uint32_t c = i;
+    for (int k = 0; k < 8; k++) {
+      c = (c & 1) ? 0xEDB88320u ^ (c >> 1) : c >> 1;
+    }
+    table[i] = c;
+  }
+  return table;
+}
+
+uint32_t crc32(const void *data, size_t size) {
+  static const std::array<uint32_t, 256> table = makeCrcTable();
+
+  const uint8_t *bytes = static_cast<const uint8_t *>(data);
+  uint32_t crc = 0xFFFFFFFFu;
+  for (size_t i = 0; i < size; i++) {
+    crc = table[(crc ^ bytes[i]) & 0xFF] ^ (crc >> 8);
+  }
+  return crc ^ 0xFFFFFFFFu;
+}
+
+void encodeRecord(const RunRecord &run, uint8_t *out) {
+  uint32_t length = sizeof(RunRecord);
+  uint32_t crc = crc32(&run, sizeof(RunRecord));
+  std::memcpy(out, &RECORD_MARKER, 4);
+  std::memcpy(out + 4, &length, 4);
+  std::memcpy(out + 8, &run, sizeof(RunRecord));
+  std::memcpy(out + 8 + sizeof(RunRecord), &crc, 4);
+}
+
+// Decodes a record at data[offset]; false if torn or corrupt
+bool decodeRecord(const uint8_t *data, size_t size, size_t offset,
+                  RunRecord &run) {
+  if (size - offset < RECORD_BYTES)
+    return false;
+
+  uint32_t marker, length, crc;
+  std::memcpy(&marker, data + offset, 4);
+  std::memcpy(&length, data + offset + 4, 4);
+  if (marker != RECORD_MARKER || length != sizeof(RunRecord))
+    return false;
+
+  std::memcpy(&run, data + offset + 8, sizeof(RunRecord));
+  std::memcpy(&crc, data + offset + 8 + sizeof(RunRecord), 4);
+  return crc == crc32(&run, sizeof(RunRecord));
+}
+
+// Higher score first; ties go to the earlier run
+bool ranksAbove(const RunRecord &a, const RunRecord &b) {
+  if (a.score != b.score)
+    return a.score > b.score;
+  return a.timestamp < b.timestamp;
+}
+
+uint64_t fileSize(const std::string &path) {
+  std::error_code error;
+  uint64_t size = std::filesystem::file_size(path, error);
+  return error ? 0 : size;
+}
+
+// Writes path atomically: temp file, flush to disk, rename over the target
+bool writeFileAtomic(const std::string &path, const void *data, size_t size) {
+  std::string temp = path + ".tmp";
+  FILE *file = std::fopen(temp.c_str(), "wb");
+  if (!file)
+    return false;
+
+  bool ok = size == 0 || std::fwrite(data, 1, size, file) == size;
+  ok = std::fflush(file) == 0 && ok;
+#ifndef _WIN32
+  ok = fsync(fileno(file)) == 0 && ok;
+#endif
+  ok = std::fclose(file) == 0 && ok;
+
+  std::error_code error;
+  if (ok)
+    std::filesystem::rename(temp, path, error);
+  return ok && !error;
+}
+
+} // namespace
+
+ScoreStore::ScoreStore() : runCount(0), logSize(0), stopping(false) {}
+
+ScoreStore::~ScoreStore() {
+  {
+    std::lock_guard<std::mutex> lock(mutex);
+    stopping = true;
+  }
+  wake.notify_one();
+  if (writer.joinable())
+    writer.join();
+}
+
+bool ScoreStore::open(const std::string &path) {
+  logPath = path;
+  indexPath = path + ".idx";
+
+  if (!loadIndex()) {
+    rebuildFromLog();
+  }
+
+  writer = std::thread(&ScoreStore::writerLoop, this);
+  return true;
+}
+
+bool ScoreStore::loadIndex() {
+  IndexFile index;
+  FILE *file = std::fopen(indexPath.c_str(), "rb");
+  if (!file)
+    return false;
+  size_t read = std::fread(&index, 1, sizeof(index), file);
+  std::fclose(file);
+
+  if (read != sizeof(index) ||
+      std::memcmp(index.magic, INDEX_MAGIC, sizeof(INDEX_MAGIC)) != 0 ||
+      index.version != INDEX_VERSION || index.count > TOP_COUNT ||
+      index.crc != crc32(&index, offsetof(IndexFile, crc)))
+    return false;
+
+  // A log that grew (or was cut) since the snapshot needs a rescan
+  if (index.logSize != fileSize(logPath))
+    return false;
+
+  top.assign(index.top, index.top + index.count);
+  runCount = index.runCount;
+  logSize = index.logSize;
+  return true;
+}
+
+void ScoreStore::rebuildFromLog() {
+  uint64_t validBytes = 0;
+  std::vector<RunRecord> runs = readLog(logPath, &validBytes);
+
+  // Drop a torn tail left by a crash mid-append
+  uint64_t size = fileSize(logPath);
+  if (validBytes < size) {
+    LOG_WARN("scores",
+             "Score log %s: discarding %" PRIu64 " bytes of incomplete records",
+             logPath.c_str(), size - validBytes);
+    std::error_code error;
+    std::filesystem::resize_file(logPath, validBytes, error);
+  }
+
+  top.clear();
+  for (const RunRecord &run : runs) {
+    insertTop(run);
+  }
+  runCount = runs.size();
+  logSize = validBytes;
+
+  if (!runs.empty())
+    writeIndex();
+}
+
+std::vector<RunRecord> ScoreStore::readLog(const std::string &path,
+                                           uint64_t *validBytes) {
+  std::vector<RunRecord> runs;
+  if (validBytes)
+    *validBytes = 0;
+
+  size_t size = static_cast<size_t>(fileSize(path));
+  if (size == 0)
+    return runs;
+
+#ifndef _WIN32
+  int fd = ::open(path.c_str(), O_RDONLY);
+  if (fd < 0)
+    return runs;
+  void *memory = mmap(nullptr, size, PROT_READ, MAP_PRIVATE, fd, 0);
+  ::close(fd);
+  if (memory == MAP_FAILED)
+    return runs;
+  const uint8_t *data = static_cast<const uint8_t *>(memory);
+#else
+  std::vector<uint8_t> buffer(size);
+  FILE *file = std::fopen(path.c_str(), "rb");
+  if (!file)
+    return runs;
+  size = std::fread(buffer.data(), 1, size, file);
+  std::fclose(file);
+  const uint8_t *data = buffer.data();
+#endif
+
+  // Skip over damaged bytes one at a time until a valid record lines up
+  // again; the valid length ends at the last good record
+  size_t offset = 0;
+  while (offset < size) {
+    RunRecord run;
+    if (decodeRecord(data, size, offset, run)) {
+      runs.push_back(run);
+      offset += RECORD_BYTES;
+      if (validBytes)
+        *validBytes = offset;
+    } else {
+      offset++;
+    }
+  }
+
+#ifndef _WIN32
+  munmap(memory, size);
+#endif
+  return runs;
+}
+
+int ScoreStore::submit(const RunRecord &run) {
+  int rank = 0;
+  {
+    std::lock_guard<std::mutex> lock(mutex);
+    queue.push_back(run);
+    runCount++;
+
+    insertTop(run);
+    for (size_t i = 0; i < top.size(); i++) {
+      if (std::memcmp(&top[i], &run, sizeof(RunRecord)) == 0) {
+        rank = static_cast<int>(i) + 1;
+        break;
+      }
+    }
+  }
+  wake.notify_one();
+  return rank;
+}
+
+std::vector<RunRecord> ScoreStore::getTopScores() const {
+  std::lock_guard<std::mutex> lock(mutex);
+  return top;
+}
+
+uint64_t ScoreStore::getRunCount() const {
+  std::lock_guard<std::mutex> lock(mutex);
+  return runCount;
+}
+
+void ScoreStore::insertTop(const RunRecord &run) {
+  auto position = std::upper_bound(top.begin(), top.end(), run, ranksAbove);
+  top.insert(position, run);
+  if (top.size() > TOP_COUNT)
+    top.pop_back();
+}
+
+void ScoreStore::writerLoop() {
+  std::unique_lock<std::mutex> lock(mutex);
+  while (true) {
+    wake.wait(lock, [this] { return stopping || !queue.empty(); });
+    if (queue.empty() && stopping)
+      return;
+
+    RunRecord run = queue.front();
+    queue.pop_front();
+
+    // Disk I/O happens without the lock held
+    lock.unlock();
+    if (!append(run)) {
+      // The run never reached the log, so it mustn't reach the index
+      // either: rank again from the log plus the runs still queued
+      std::vector<RunRecord> logged = readLog(logPath);
+      lock.lock();
+      top.clear();
+      for (const RunRecord &kept : logged)
+        insertTop(kept);
+      for (const RunRecord &queued : queue)
+        insertTop(queued);
+      runCount = logged.size() + queue.size();
+      continue;
+    }
+    if (logSize / RECORD_BYTES > COMPACT_THRESHOLD)
+      compact();
+    writeIndex();
+    lock.lock();
+  }
+}
+
+bool ScoreStore::append(const RunRecord &run) {
+  uint8_t record[RECORD_BYTES];
+  encodeRecord(run, record);
+
+  FILE *file = std::fopen(logPath.c_str(), "ab");
+  if (!file) {
+    LOG_ERROR("scores", "Could not open score log %s", logPath.c_str());
+    return false;
+  }
+
+  bool ok = std::fwrite(record, 1, RECORD_BYTES, file) == RECORD_BYTES;
+  ok = std::fflush(file) == 0 && ok;
+#ifndef _WIN32
+  ok = fsync(fileno(file)) == 0 && ok;
+#endif
+  ok = std::fclose(file) == 0 && ok;
+
+  if (!ok) {
+    // Cut off whatever part of the record made it out
+    LOG_ERROR("scores", "Could not write score log %s", logPath.c_str());
+    std::error_code error;
+    std::filesystem::resize_file(logPath, logSize, error);
+    return false;
+  }
+
+  std::lock_guard<std::mutex> lock(mutex);
+  logSize += RECORD_BYTES;
+  return true;
+}
+
+void ScoreStore::compact() {
+  std::vector<RunRecord> runs = readLog(logPath);
+
+  // Keep the most recent runs plus every run in the top list
+  std::vector<size_t> order(runs.size());
+  for (size_t i = 0; i < order.size(); i++)
+    order[i] = i;
+  size_t topCount = std::min<size_t>(TOP_COUNT, runs.size());
+  std::partial_sort(order.begin(), order.begin() + topCount, order.end(),
+                    [&runs](size_t a, size_t b) {
+                      return ranksAbove(runs[a], runs[b]);
+                    });
+
+  std::vector<bool> keep(runs.size(), false);
+  for (size_t i = 0; i < topCount; i++)
+    keep[order[i]] = true;
+  size_t recentStart = runs.size() > KEEP_RUNS ? runs.size() - KEEP_RUNS : 0;
+  for (size_t i = recentStart; i < runs.size(); i++)
+    keep[i] = true;
+
+  std::vector<uint8_t> bytes;
+  for (size_t i = 0; i < runs.size(); i++) {
+    if (!keep[i])
+      continue;
+    size_t at = bytes.size();
+    bytes.resize(at + RECORD_BYTES);
+    encodeRecord(runs[i], bytes.data() + at);
+  }
+
+  if (!writeFileAtomic(logPath, bytes.data(), bytes.size())) {
+    LOG_ERROR("scores", "Could not compact score log %s", logPath.c_str());
+    return;
+  }
+
+  std::lock_guard<std::mutex> lock(mutex);
+  logSize = bytes.size();
+}
+
+void ScoreStore::writeIndex() {
+  IndexFile index;
+  std::memset(static_cast<void *>(&index), 0, sizeof(index));
+  std::memcpy(index.magic, INDEX_MAGIC, sizeof(INDEX_MAGIC));
+  index.version = INDEX_VERSION;
+
+  {
+    // The snapshot must only list runs already in the log
+    std::lock_guard<std::mutex> lock(mutex);
+    std::vector<RunRecord> persisted = top;
+    for (const RunRecord &pending : queue) {
+      persisted.erase(std::remove_if(persisted.begin(), persisted.end(),
+                                     [&pending](const RunRecord &r) {
+                                       return std::memcmp(&r, &pending,
+                                                          sizeof(r)) == 0;
+                                     }),
+                      persisted.end());
+    }
+    index.count = static_cast<uint32_t>(persisted.size());
+    std::copy(persisted.begin(), persisted.end(), index.top);
+    index.logSize = logSize;
+    index.runCount = runCount - queue.size();
+  }
+  index.crc = crc32(&index, offsetof(IndexFile, crc));
+
+  if (!writeFileAtomic(indexPath, &index, sizeof(index))) {
+    LOG_ERROR("scores", "Could not write score index %s", indexPath.c_str());
+  }
+}
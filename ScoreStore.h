@@ -0,0 +1,83 @@
+#ifndef SCORE_STORE_H
+#define SCORE_STORE_H
+
+#include <condition_variable>
+#include <cstdint>
+#include <deque>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+// One finished run, stored verbatim in the log (no padding bytes, so the
+// checksum covers only defined data)
+struct RunRecord {
+  int64_t timestamp = 0; // Unix seconds
+  int32_t score = 0;
+  int32_t maxCombo = 0;
+  float survivalSeconds = 0.0f;
+  int32_t kills[3] = {0, 0, 0}; // Per EnemyType
+};
+
+// Persistent high scores and run history.
+//
+// <path>      append-only log: each record is marker, length, RunRecord and
+//             a CRC32 of the payload. A torn or corrupt tail is truncated
+//             away on load.
+// <path>.idx  fixed-size top-N snapshot plus the log size it describes.
+//             Loading it is one read; the log is only scanned (via mmap)
+//             when the index is missing or stale.
+//
+// submit() queues a run for the writer thread, so the game thread never
+// touches the disk after open(). The log is compacted to the most recent
+// runs (keeping every top-N entry) once it grows past COMPACT_THRESHOLD.
+class ScoreStore {
+public:
+  static constexpr int TOP_COUNT = 10;
+  static constexpr int KEEP_RUNS = 1024;
+  static constexpr int COMPACT_THRESHOLD = 4096;
+
+  ScoreStore();
+  ~ScoreStore(); // Drains pending writes
+
+  ScoreStore(const ScoreStore &) = delete;
+  ScoreStore &operator=(const ScoreStore &) = delete;
+
+  // Loads the index (or rebuilds it from the log) and starts the writer
+  bool open(const std::string &path);
+
+  // Queues a run; returns its rank in the top list (1-based) or 0
+  int submit(const RunRecord &run);
+
+  std::vector<RunRecord> getTopScores() const;
+  uint64_t getRunCount() const;
+
+  // Every valid record in the log, oldest first (reads through mmap)
+  static std::vector<RunRecord> readLog(const std::string &path,
+                                        uint64_t *validBytes = nullptr);
+
+private:
+  void writerLoop();
+  bool append(const RunRecord &run); // False if the run isn't in the log
+  void compact();
+  void writeIndex();
+  bool loadIndex();
+  void rebuildFromLog();
+  void insertTop(const RunRecord &run);
+
+  std::string logPath;
+  std::string indexPath;
+
+  // Guarded by mutex: queue, top list, counters
+  mutable std::mutex mutex;
+  std::condition_variable wake;
+  std::deque<RunRecord> queue;
+  std::vector<RunRecord> top;
+  uint64_t runCount;
+  uint64_t logSize;
+  bool stopping;
+
+  std::thread writer;
+};
+
+#endif // SCORE_STORE_H
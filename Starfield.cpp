@@ -1,8 +1,70 @@
 #include "Starfield.h"
+#include "Draw.h"
+#include <algorithm>
+#include <cmath>
 #include <random>
 
-Starfield::Starfield(int width, int height)
-    : screenWidth(width), screenHeight(height) {
+namespace {
+
+// One parallax depth of the procedural field
+struct StarLayer {
+  float cellSize;     // Pixels per cell side
+  float starsPerCell; // At density 1
+  float speed;        // Fall speed in pixels per second
+  int minBrightness;
+  int maxBrightness;
+  int minSize;
+  int maxSize;
+};
+
+// Far to near: small dim slow stars in small cells, big bright fast ones
+// in large cells (about 190 stars on an 800x600 screen at density 1)
+constexpr StarLayer LAYERS[Starfield::LAYER_COUNT] = {
+    {64.0f, 1.0f, 25.0f, 30, 90, 1, 1},
+    {96.0f, 1.0f, 70.0f, 70, 170, 1, 2},
+    {160.0f, 1.0f, 140.0f, 150, 255, 2, 3},
+};
+
+// Integer avalanche (lowbias32): every input bit flips about half the
+// output bits, so neighbouring cells look unrelated
+uint32_t mix(uint32_t h) {
+  h ^= h >> 16;
+  h *= 0x7feb352du;
+  h ^= h >> 15;
+  h *= 0x846ca68bu;
+  h ^= h >> 16;
+  return h;
+}
+
+uint32_t cellHash(uint32_t seed, int layer, int64_t cx, int64_t cy) {
+  uint32_t h = mix(seed + 0x9e3779b9u * static_cast<uint32_t>(layer + 1));
+  h = mix(h ^ static_cast<uint32_t>(cx));
+  h = mix(h ^ static_cast<uint32_t>(cy));
+  return h;
+}
+
+float unit(uint32_t bits16) { return bits16 * (1.0f / 65536.0f); }
+
+} // namespace
+
+Starfield::Starfield(int width, int height, const StarfieldConfig &cfg)
+    : config(cfg), screenWidth(width), screenHeight(height), elapsed(0),
+      scrollX(0), scrollY(0) {
+  if (config.mode == StarfieldMode::Procedural) {
+    // Nothing to store, but size every batch for the most stars its layer
+    // can show, so rendering never grows one mid-game
+    for (int layer = 0; layer < LAYER_COUNT; layer++) {
+      const StarLayer &spec = LAYERS[layer];
+      size_t columns = static_cast<size_t>(width / spec.cellSize) + 2;
+      size_t rows = static_cast<size_t>(height / spec.cellSize) + 2;
+      size_t perCell =
+          static_cast<size_t>(std::ceil(spec.starsPerCell * config.density));
+      for (auto &batch : batches[layer]) {
+        batch.reserve(columns * rows * perCell);
+      }
+    }
+    return;
+  }
 
   stars.resize(NUM_STARS);
 
@@ -32,6 +94,11 @@ void Starfield::spawnStar(Star &star, bool randomY) {
 }
 
 void Starfield::update(float deltaTime) {
+  if (config.mode == StarfieldMode::Procedural) {
+    elapsed += deltaTime; // Positions follow from the clock
+    return;
+  }
+
   for (auto &star : stars) {
     star.y += star.speed * deltaTime;
 
@@ -42,7 +109,110 @@ void Starfield::update(float deltaTime) {
   }
 }
 
+void Starfield::scroll(float dx, float dy) {
+  if (config.mode == StarfieldMode::Procedural) {
+    scrollX += dx;
+    scrollY += dy;
+    return;
+  }
+
+  const float w = static_cast<float>(screenWidth);
+  const float h = static_cast<float>(screenHeight + 15);
+
+  for (auto &star : stars) {
+    float depth = star.speed / 150.0f;
+    star.x -= dx * depth;
+    star.y -= dy * depth;
+
+    // Wrap around; the vertical band matches the respawn range of update()
+    star.x = std::fmod(star.x, w);
+    if (star.x < 0)
+      star.x += w;
+    star.y = std::fmod(star.y + 5, h);
+    if (star.y < 0)
+      star.y += h;
+    star.y -= 5;
+  }
+}
+
 void Starfield::render(SDL_Renderer *renderer) {
+  if (config.mode == StarfieldMode::Procedural) {
+    renderProcedural(renderer);
+  } else {
+    renderClassic(renderer);
+  }
+}
+
+void Starfield::renderProcedural(SDL_Renderer *renderer) {
+  const uint32_t levelRange = BRIGHTNESS_LEVELS;
+
+  for (int layer = 0; layer < LAYER_COUNT; layer++) {
+    const StarLayer &spec = LAYERS[layer];
+    double depth = spec.speed / 150.0;
+    double cell = spec.cellSize;
+
+    // Top-left of the screen in layer space: the camera scrolls it by
+    // depth, time moves the layer down
+    double originX = scrollX * depth;
+    double originY = scrollY * depth - elapsed * spec.speed;
+
+    int64_t firstCol = static_cast<int64_t>(std::floor(originX / cell));
+    int64_t lastCol =
+        static_cast<int64_t>(std::floor((originX + screenWidth) / cell));
+    int64_t firstRow = static_cast<int64_t>(std::floor(originY / cell));
+    int64_t lastRow =
+        static_cast<int64_t>(std::floor((originY + screenHeight) / cell));
+
+    // Fractional densities give some cells one star more than others
+    float perCell = spec.starsPerCell * config.density;
+    int baseCount = static_cast<int>(perCell);
+    uint32_t extraChance =
+        static_cast<uint32_t>((perCell - baseCount) * 65536.0f);
+
+    for (int64_t row = firstRow; row <= lastRow; row++) {
+      // Cell corner relative to the screen
+      double top = row * cell - originY;
+      for (int64_t col = firstCol; col <= lastCol; col++) {
+        double left = col * cell - originX;
+        uint32_t h = cellHash(config.seed, layer, col, row);
+        int count = baseCount + ((h & 0xffff) < extraChance);
+
+        for (int i = 0; i < count; i++) {
+          uint32_t position = mix(h + 0x9e3779b9u * (i + 1));
+          uint32_t look = mix(position);
+
+          int sizes = spec.maxSize - spec.minSize + 1;
+          int size = spec.minSize + static_cast<int>(look % sizes);
+          int level = static_cast<int>((look >> 8) % levelRange);
+          SDL_Rect rect = {
+              static_cast<int>(left + unit(position & 0xffff) * cell),
+              static_cast<int>(top + unit(position >> 16) * cell), size, size};
+          batches[layer][level].push_back(rect);
+        }
+      }
+    }
+  }
+
+  for (int layer = 0; layer < LAYER_COUNT; layer++) {
+    const StarLayer &spec = LAYERS[layer];
+    for (int level = 0; level < BRIGHTNESS_LEVELS; level++) {
+      std::vector<SDL_Rect> &batch = batches[layer][level];
+      if (batch.empty())
+        continue;
+
+      // Slight blue tint, as in classic mode
+      int brightness = spec.minBrightness +
+                       (spec.maxBrightness - spec.minBrightness) * level /
+                           (BRIGHTNESS_LEVELS - 1);
+      int blue = std::min(255, static_cast<int>(brightness * 1.1f));
+      Draw::setColor(renderer, brightness, brightness, blue, 255);
+      Draw::fillRects(renderer, batch.data(), static_cast<int>(batch.size()));
+      batch.clear();
+    }
+  }
+}
+
+void Starfield::renderClassic(SDL_Renderer *renderer) {
   for (const auto &star : stars) {
     // Tint based on brightness (slight blue tint for distant stars)
     int r = star.brightness;
@@ -51,17 +221,17 @@ void Starfield::render(SDL_Renderer *renderer) {
     if (b > 255)
       b = 255;
 
-    SDL_SetRenderDrawColor(renderer, r, g, b, 255);
+    Draw::setColor(renderer, r, g, b, 255);
 
     if (star.size == 1) {
       // Single pixel for small stars
-      SDL_RenderDrawPoint(renderer, static_cast<int>(star.x),
-                          static_cast<int>(star.y));
+      Draw::drawPoint(renderer, static_cast<int>(star.x),
+                      static_cast<int>(star.y));
     } else {
       // Rectangle for larger stars
       SDL_Rect rect = {static_cast<int>(star.x), static_cast<int>(star.y),
                        star.size, star.size};
-      SDL_RenderFillRect(renderer, &rect);
+      Draw::fillRect(renderer, &rect);
     }
   }
 }
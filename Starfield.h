@@ -2,6 +2,7 @@
 #define STARFIELD_H
 
 #include <SDL2/SDL.h>
+#include <cstdint>
 #include <vector>
 
 struct Star {
@@ -11,20 +12,65 @@ struct Star {
   int size;
 };
 
+enum class StarfieldMode {
+  Procedural, // Stars hashed from (seed, layer, cell), nothing stored
+  Classic     // NUM_STARS stored stars respawned from a random generator
+};
+
+struct StarfieldConfig {
+  StarfieldMode mode = StarfieldMode::Procedural;
+  uint32_t seed = 1;
+  float density = 1.0f; // Procedural star count multiplier (any value > 0)
+};
+
+// Scrolling background.
+//
+// In procedural mode each parallax layer is a grid of cells, and a cell's
+// stars are a pure function of (seed, layer, cell x, cell y). A frame
+// derives each layer's scroll offset from the elapsed time and camera
+// position and evaluates only the cells overlapping the screen. There is
+// no per-star storage and no per-star update, so memory is constant at
+// any density, cost follows the visible star count, and the same seed
+// always gives the same sky. Stars are batched per layer and brightness
+// level, a dozen draw calls however dense the field.
 class Starfield {
 public:
-  Starfield(int width, int height);
+  static constexpr int LAYER_COUNT = 3;
+  static constexpr int BRIGHTNESS_LEVELS = 4;
+
+  Starfield(int width, int height,
+            const StarfieldConfig &config = StarfieldConfig());
 
   void update(float deltaTime);
+
+  // Camera moved by (dx, dy): nearer (faster) stars shift further
+  void scroll(float dx, float dy);
+
   void render(SDL_Renderer *renderer);
 
+  const StarfieldConfig &getConfig() const { return config; }
+
 private:
   void spawnStar(Star &star, bool randomY = true);
+  void renderClassic(SDL_Renderer *renderer);
+  void renderProcedural(SDL_Renderer *renderer);
 
-  std::vector<Star> stars;
+  StarfieldConfig config;
   int screenWidth;
   int screenHeight;
+
+  // Classic mode
+  std::vector<Star> stars;
   static const int NUM_STARS = 150;
+
+  // Procedural mode: all the state there is. Doubles so long sessions
+  // don't lose sub-pixel precision.
+  double elapsed;
+  double scrollX;
+  double scrollY;
+
+  // Reused each frame, one batch per layer and brightness level
+  std::vector<SDL_Rect> batches[LAYER_COUNT][BRIGHTNESS_LEVELS];
 };
 
 #endif // STARFIELD_H
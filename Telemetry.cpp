@@ -0,0 +1,108 @@
+#include "Telemetry.h"
+#include "Log.h"
+#include <cstring>
+#include <new>
+
+#ifndef _WIN32
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <unistd.h>
+#endif
+
+Telemetry::Telemetry() : layout(nullptr), mapped(false) {
+  // Private layout until open() maps a shared one
+  layout = new TelemetryLayout;
+  layout->header.processId = 0;
+  initLayout();
+}
+
+Telemetry::~Telemetry() { close(); }
+
+bool Telemetry::open(const char *path) {
+  // Handles already given out point into the private layout
+  if (layout->header.counterCount.load(std::memory_order_relaxed) > 0) {
+    LOG_ERROR("telemetry",
+              "Telemetry must be opened before registering counters");
+    return false;
+  }
+
+#ifdef _WIN32
+  (void)path;
+  LOG_ERROR("telemetry", "Telemetry files are not supported on this platform");
+  return false;
+#else
+  int fd = ::open(path, O_RDWR | O_CREAT | O_TRUNC, 0644);
+  if (fd < 0) {
+    LOG_ERROR("telemetry", "Could not open stats file %s", path);
+    return false;
+  }
+
+  if (ftruncate(fd, sizeof(TelemetryLayout)) != 0) {
+    LOG_ERROR("telemetry", "Could not size stats file %s", path);
+    ::close(fd);
+    return false;
+  }
+
+  void *memory = mmap(nullptr, sizeof(TelemetryLayout), PROT_READ | PROT_WRITE,
+                      MAP_SHARED, fd, 0);
+  ::close(fd); // The mapping keeps the file alive
+  if (memory == MAP_FAILED) {
+    LOG_ERROR("telemetry", "Could not map stats file %s", path);
+    return false;
+  }
+
+  delete layout;
+  layout = new (memory) TelemetryLayout;
+  mapped = true;
+  layout->header.processId = static_cast<uint32_t>(getpid());
+  initLayout();
+  return true;
+#endif
+}
+
+void Telemetry::initLayout() {
+  std::memcpy(layout->header.magic, TelemetryHeader::MAGIC,
+              sizeof(layout->header.magic));
+  layout->header.version.store(0, std::memory_order_relaxed);
+  layout->header.slotSize = sizeof(TelemetrySlot);
+  layout->header.counterCount.store(0, std::memory_order_relaxed);
+  layout->header.frame.store(0, std::memory_order_relaxed);
+
+  // A reader polling the file sees a valid layout only once this is set
+  layout->header.version.store(TelemetryHeader::VERSION,
+                               std::memory_order_release);
+}
+
+TelemetryCounter Telemetry::registerCounter(const char *name,
+                                            TelemetryUnit unit) {
+  uint32_t index = layout->header.counterCount.load(std::memory_order_relaxed);
+  if (index >= TelemetryHeader::MAX_COUNTERS)
+    return TelemetryCounter();
+
+  TelemetrySlot &slot = layout->slots[index];
+  std::memset(slot.name, 0, TelemetrySlot::NAME_LENGTH);
+  std::strncpy(slot.name, name, TelemetrySlot::NAME_LENGTH - 1);
+  slot.unit = unit;
+  slot.value.store(0, std::memory_order_relaxed);
+
+  // Readers see the slot only once its name is in place
+  layout->header.counterCount.store(index + 1, std::memory_order_release);
+  return TelemetryCounter(&slot.value);
+}
+
+void Telemetry::publish(uint64_t frame) {
+  layout->header.frame.store(frame, std::memory_order_release);
+}
+
+void Telemetry::close() {
+#ifndef _WIN32
+  if (mapped) {
+    munmap(layout, sizeof(TelemetryLayout));
+    layout = nullptr;
+    mapped = false;
+    return;
+  }
+#endif
+  delete layout;
+  layout = nullptr;
+}
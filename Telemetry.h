@@ -0,0 +1,98 @@
+#ifndef TELEMETRY_H
+#define TELEMETRY_H
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+
+// Live counters shared with other processes through a memory-mapped file.
+//
+// The file has a fixed layout (TelemetryHeader followed by MAX_COUNTERS
+// slots), so a reader only needs this header to interpret it. The game
+// registers counters at startup and stores their values with relaxed
+// atomics once per frame, then bumps the header's frame number with a
+// release store. The hot path is a plain store: no formatting, no syscalls.
+//
+// Values are integers; the unit tells a reader how to print them.
+
+enum class TelemetryUnit : uint32_t {
+  Count,
+  Microseconds,
+  Thousandths // Fixed point, value / 1000
+};
+
+struct TelemetrySlot {
+  static constexpr size_t NAME_LENGTH = 48;
+
+  char name[NAME_LENGTH];
+  TelemetryUnit unit;
+  uint32_t reserved;
+  std::atomic<int64_t> value;
+};
+
+struct TelemetryHeader {
+  static constexpr char MAGIC[8] = {'S', 'T', 'L', 'R', 'S', 'T', 'A', 'T'};
+  static constexpr uint32_t VERSION = 1;
+  static constexpr uint32_t MAX_COUNTERS = 64;
+
+  char magic[8];
+  std::atomic<uint32_t> version;      // Stored last; 0 while initializing
+  uint32_t slotSize;                  // sizeof(TelemetrySlot), as a check
+  std::atomic<uint32_t> counterCount; // Slots in use
+  uint32_t processId;
+  std::atomic<uint64_t> frame; // Published after each frame's values
+};
+
+struct TelemetryLayout {
+  TelemetryHeader header;
+  TelemetrySlot slots[TelemetryHeader::MAX_COUNTERS];
+};
+
+static_assert(std::atomic<int64_t>::is_always_lock_free,
+              "telemetry values must be lock-free to be shared");
+
+// Handle to one registered value
+class TelemetryCounter {
+public:
+  TelemetryCounter() : value(nullptr) {}
+  explicit TelemetryCounter(std::atomic<int64_t> *v) : value(v) {}
+
+  void set(int64_t v) {
+    if (value)
+      value->store(v, std::memory_order_relaxed);
+  }
+
+private:
+  std::atomic<int64_t> *value;
+};
+
+class Telemetry {
+public:
+  Telemetry();
+  ~Telemetry();
+
+  Telemetry(const Telemetry &) = delete;
+  Telemetry &operator=(const Telemetry &) = delete;
+
+  // Maps the stats file at path (created or truncated); call before
+  // registering counters. Without a file the counters live in private
+  // memory and stores are still valid.
+  bool open(const char *path);
+  bool isShared() const { return mapped; }
+
+  // Returns an inert counter once all slots are taken
+  TelemetryCounter registerCounter(const char *name,
+                                   TelemetryUnit unit = TelemetryUnit::Count);
+
+  // Marks the values stored since the last call as one frame
+  void publish(uint64_t frame);
+
+private:
+  void initLayout();
+  void close();
+
+  TelemetryLayout *layout;
+  bool mapped;
+};
+
+#endif // TELEMETRY_H
@@ -0,0 +1,178 @@
+#include "TimingWheel.h"
+#include <cmath>
+
+TimingWheel::TimingWheel(float rate)
+    : tickRate(rate), accumulator(0.0), currentTick(0), pendingCount(0),
+      freeList(NONE) {
+  heads.fill(NONE);
+  tails.fill(NONE);
+}
+
+TimerHandle TimingWheel::schedule(float delaySeconds, Callback callback) {
+  long ticks = std::lround(delaySeconds * tickRate);
+  return scheduleTicks(ticks > 0 ? static_cast<uint64_t>(ticks) : 0,
+                       std::move(callback));
+}
+
+TimerHandle TimingWheel::scheduleTicks(uint64_t delayTicks, Callback callback) {
+  // Firing in the current tick would re-enter the slot being processed
+  if (delayTicks == 0)
+    delayTicks = 1;
+
+  uint32_t index;
+  if (freeList != NONE) {
+    index = freeList;
+    freeList = nodes[index].next;
+  } else {
+    index = static_cast<uint32_t>(nodes.size());
+    nodes.emplace_back();
+  }
+
+  Node &node = nodes[index];
+  node.callback = std::move(callback);
+  node.expires = currentTick + delayTicks;
+  node.live = true;
+  insert(index);
+  pendingCount++;
+
+  return TimerHandle{index, node.generation};
+}
+
+bool TimingWheel::cancel(TimerHandle &handle) {
+  bool wasPending = isPending(handle);
+  if (wasPending) {
+    unlink(handle.index);
+    release(handle.index);
+  }
+  handle = TimerHandle{};
+  return wasPending;
+}
+
+bool TimingWheel::isPending(TimerHandle handle) const {
+  return handle.index < nodes.size() &&
+         nodes[handle.index].generation == handle.generation &&
+         nodes[handle.index].live;
+}
+
+void TimingWheel::advance(float deltaTime) {
+  accumulator += static_cast<double>(deltaTime) * tickRate;
+  while (accumulator >= 1.0) {
+    accumulator -= 1.0;
+    tick();
+  }
+}
+
+void TimingWheel::clear() {
+  // Bump every generation rather than dropping the pool, so handles issued
+  // before the clear can never alias timers scheduled after it
+  freeList = NONE;
+  for (uint32_t index = static_cast<uint32_t>(nodes.size()); index-- > 0;) {
+    Node &node = nodes[index];
+    if (node.live) {
+      node.callback = nullptr;
+      node.live = false;
+      node.generation++;
+    }
+    node.prev = NONE;
+    node.next = freeList;
+    freeList = index;
+  }
+
+  heads.fill(NONE);
+  tails.fill(NONE);
+  pendingCount = 0;
+}
+
+void TimingWheel::tick() {
+  currentTick++;
+
+  // Pull timers down from coarser levels when a finer wheel wraps
+  for (int level = 1; level < LEVELS; level++) {
+    if ((currentTick & ((uint64_t(1) << (SLOT_BITS * level)) - 1)) != 0)
+      break;
+    cascade(level);
+  }
+
+  // Fire everything in the current level-0 slot, one node at a time so
+  // callbacks can safely cancel or schedule other timers
+  size_t slot = currentTick & SLOT_MASK;
+  while (heads[slot] != NONE) {
+    uint32_t index = heads[slot];
+    unlink(index);
+    Callback callback = std::move(nodes[index].callback);
+    release(index);
+    callback();
+  }
+}
+
+void TimingWheel::cascade(int level) {
+  size_t slot =
+      level * SLOTS + ((currentTick >> (SLOT_BITS * level)) & SLOT_MASK);
+
+  uint32_t index = heads[slot];
+  heads[slot] = NONE;
+  tails[slot] = NONE;
+
+  while (index != NONE) {
+    uint32_t next = nodes[index].next;
+    insert(index);
+    index = next;
+  }
+}
+
+void TimingWheel::insert(uint32_t index) {
+  Node &node = nodes[index];
+  uint64_t delta = node.expires - currentTick;
+
+  int level = 0;
+  while (level < LEVELS - 1 &&
+         delta >= (uint64_t(1) << (SLOT_BITS * (level + 1)))) {
+    level++;
+  }
+
+  // Timers beyond the wheel's range park in the last slot and re-cascade
+  uint64_t maxDelta = (uint64_t(1) << (SLOT_BITS * LEVELS)) - 1;
+  uint64_t expires = delta > maxDelta ? currentTick + maxDelta : node.expires;
+
+  size_t slot = level * SLOTS + ((expires >> (SLOT_BITS * level)) & SLOT_MASK);
+  node.slot = static_cast<uint16_t>(slot);
+  node.next = NONE;
+  node.prev = tails[slot];
+
+  // Append so timers due on the same tick fire in scheduling order
+  if (tails[slot] != NONE) {
+    nodes[tails[slot]].next = index;
+  } else {
+    heads[slot] = index;
+  }
+  tails[slot] = index;
+}
+
+void TimingWheel::unlink(uint32_t index) {
+  Node &node = nodes[index];
+
+  if (node.prev != NONE) {
+    nodes[node.prev].next = node.next;
+  } else {
+    heads[node.slot] = node.next;
+  }
+
+  if (node.next != NONE) {
+    nodes[node.next].prev = node.prev;
+  } else {
+    tails[node.slot] = node.prev;
+  }
+
+  node.next = NONE;
+  node.prev = NONE;
+}
+
+void TimingWheel::release(uint32_t index) {
+  Node &node = nodes[index];
+  node.callback = nullptr;
+  node.live = false;
+  node.generation++;
+  node.next = freeList;
+  freeList = index;
+  pendingCount--;
+}
@@ -0,0 +1,77 @@
+#ifndef TIMING_WHEEL_H
+#define TIMING_WHEEL_H
+
+#include <array>
+#include <cstdint>
+#include <functional>
+#include <vector>
+
+// Handle to a scheduled timer. Stale handles (fired, cancelled or cleared)
+// are detected through the generation counter, so cancelling one is a no-op.
+struct TimerHandle {
+  static constexpr uint32_t INVALID = 0xFFFFFFFFu;
+
+  uint32_t index = INVALID;
+  uint32_t generation = 0;
+
+  bool isValid() const { return index != INVALID; }
+};
+
+// Hierarchical timing wheel (4 levels x 64 slots). Scheduling and cancelling
+// are O(1); advancing costs one slot visit per tick plus the timers that
+// actually expire, independent of how many are pending.
+class TimingWheel {
+public:
+  using Callback = std::function<void()>;
+
+  explicit TimingWheel(float tickRate = 1000.0f);
+
+  // Callbacks run inside advance(); they may schedule or cancel timers.
+  // Delays are rounded to whole ticks, with a minimum of one tick.
+  TimerHandle schedule(float delaySeconds, Callback callback);
+  TimerHandle scheduleTicks(uint64_t delayTicks, Callback callback);
+  bool cancel(TimerHandle &handle);
+  bool isPending(TimerHandle handle) const;
+
+  void advance(float deltaTime);
+  void clear();
+
+  uint64_t now() const { return currentTick; }
+  float getTickRate() const { return tickRate; }
+  size_t pending() const { return pendingCount; }
+
+private:
+  static constexpr int LEVELS = 4;
+  static constexpr int SLOT_BITS = 6;
+  static constexpr int SLOTS = 1 << SLOT_BITS;
+  static constexpr uint64_t SLOT_MASK = SLOTS - 1;
+  static constexpr uint32_t NONE = TimerHandle::INVALID;
+
+  struct Node {
+    Callback callback;
+    uint64_t expires = 0;
+    uint32_t next = NONE;
+    uint32_t prev = NONE;
+    uint32_t generation = 0;
+    uint16_t slot = 0; // Flattened level * SLOTS + slot
+    bool live = false;
+  };
+
+  void tick();
+  void insert(uint32_t index);
+  void unlink(uint32_t index);
+  void release(uint32_t index);
+  void cascade(int level);
+
+  float tickRate;
+  double accumulator;
+  uint64_t currentTick;
+  size_t pendingCount;
+
+  std::vector<Node> nodes;
+  uint32_t freeList;
+  std::array<uint32_t, LEVELS * SLOTS> heads;
+  std::array<uint32_t, LEVELS * SLOTS> tails;
+};
+
+#endif // TIMING_WHEEL_H
@@ -0,0 +1,384 @@
+#include "VecEnv.h"
+#include "Bullet.h"
+#include "Camera.h"
+#include "Enemy.h"
+#include "EnemyBatches.h"
+#include "Game.h"
+#include "Player.h"
+#include "ProjectileSystem.h"
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+
+namespace {
+
+// Feature scales: the player's speed, a fast enemy shot, the top difficulty
+constexpr float SHIP_SPEED = 300.0f;
+constexpr float SHOT_SPEED = 500.0f;
+constexpr float MAX_DIFFICULTY = 5.0f;
+constexpr float MAX_COMBO = 10.0f;
+
+// Keeps the nearest `keep` entries (by .first or .distance) at the front,
+// sorted; ties keep the order the selection leaves them in, which only
+// depends on the input order
+template <typename T, typename Key>
+void selectNearest(std::vector<T> &items, size_t keep, Key key) {
+  auto closer = [&key](const T &a, const T &b) { return key(a) < key(b); };
+  if (items.size() > keep) {
+    std::nth_element(items.begin(), items.begin() + keep, items.end(),
+                     closer);
+    items.resize(keep);
+  }
+  std::sort(items.begin(), items.end(), closer);
+}
+
+} // namespace
+
+VecEnv::VecEnv(const VecEnvConfig &cfg)
+    : config(cfg), frames(0), started(false), generation(0), pending(0),
+      stopping(false), jobThunk(nullptr), jobData(nullptr) {
+  config.envCount = std::max(1, config.envCount);
+  config.maxEnemies = std::max(0, config.maxEnemies);
+  config.maxProjectiles = std::max(0, config.maxProjectiles);
+  config.frameSkip = std::max(1, config.frameSkip);
+  config.threads = std::clamp(config.threads, 1, config.envCount);
+  if (config.rasterWidth <= 0 || config.rasterHeight <= 0) {
+    config.rasterWidth = 0;
+    config.rasterHeight = 0;
+  }
+
+  envs.resize(config.envCount);
+  for (int i = 0; i < config.envCount; i++) {
+    Env &env = envs[i];
+    env.game = std::make_unique<Game>();
+    if (config.worldWidth > 0 && config.worldHeight > 0) {
+      env.game->setWorldSize(config.worldWidth, config.worldHeight);
+    }
+    env.seed = config.seed + i;
+    env.steps = 0;
+    env.episodes = 0;
+    std::memset(env.keys, 0, sizeof(env.keys));
+    env.nearEnemies.reserve(64);
+    env.nearProjectiles.reserve(256);
+  }
+
+  for (int i = 1; i < config.threads; i++) {
+    workers.emplace_back(&VecEnv::workerLoop, this, i);
+  }
+}
+
+VecEnv::~VecEnv() {
+  {
+    std::lock_guard<std::mutex> lock(mutex);
+    stopping = true;
+  }
+  wake.notify_all();
+  for (std::thread &worker : workers) {
+    worker.join();
+  }
+}
+
+size_t VecEnv::observationSize() const {
+  return PLAYER_FEATURES + size_t(config.maxEnemies) * ENEMY_FEATURES +
+         size_t(config.maxProjectiles) * PROJECTILE_FEATURES;
+}
+
+size_t VecEnv::frameSize() const {
+  return size_t(config.rasterWidth) * config.rasterHeight;
+}
+
+uint64_t VecEnv::getEpisodes() const {
+  uint64_t total = 0;
+  for (const Env &env : envs) {
+    total += env.episodes;
+  }
+  return total;
+}
+
+void VecEnv::reset(const VecEnvBuffers &out) {
+  started = true;
+  parallelFor([this, &out](size_t begin, size_t end) {
+    for (size_t i = begin; i < end; i++) {
+      resetEnv(envs[i]);
+      observe(envs[i], out.observations + i * observationSize(),
+              out.frames ? out.frames + i * frameSize() : nullptr);
+      if (out.rewards) {
+        out.rewards[i] = 0.0f;
+      }
+      if (out.dones) {
+        out.dones[i] = 0;
+      }
+    }
+  });
+}
+
+void VecEnv::step(const uint8_t *actions, const VecEnvBuffers &out) {
+  if (!started) {
+    reset(out);
+  }
+
+  parallelFor([this, actions, &out](size_t begin, size_t end) {
+    for (size_t i = begin; i < end; i++) {
+      stepEnv(i, actions, out);
+    }
+  });
+  frames += uint64_t(config.envCount) * config.frameSkip;
+}
+
+void VecEnv::resetEnv(Env &env) {
+  env.game->startHeadless(env.seed);
+  env.seed += config.envCount;
+  env.steps = 0;
+}
+
+void VecEnv::stepEnv(size_t index, const uint8_t *actions,
+                     const VecEnvBuffers &out) {
+  Env &env = envs[index];
+  Game &game = *env.game;
+
+  uint8_t action = actions[index];
+  env.keys[SDL_SCANCODE_W] = (action & ACTION_UP) != 0;
+  env.keys[SDL_SCANCODE_S] = (action & ACTION_DOWN) != 0;
+  env.keys[SDL_SCANCODE_A] = (action & ACTION_LEFT) != 0;
+  env.keys[SDL_SCANCODE_D] = (action & ACTION_RIGHT) != 0;
+  env.keys[SDL_SCANCODE_SPACE] = (action & ACTION_SHOOT) != 0;
+
+  int scoreBefore = game.getScore();
+  int healthBefore = std::max(0, game.getPlayer()->getHealth());
+  for (int i = 0; i < config.frameSkip; i++) {
+    game.step(env.keys, FRAME_DT);
+    if (game.getState() != GameState::Playing)
+      break;
+  }
+  int healthLost = healthBefore - std::max(0, game.getPlayer()->getHealth());
+  env.steps++;
+
+  bool done = game.getState() != GameState::Playing ||
+              (config.maxSteps > 0 && env.steps >= config.maxSteps);
+  if (out.rewards) {
+    out.rewards[index] = static_cast<float>(game.getScore() - scoreBefore) -
+                         config.hitPenalty * healthLost;
+  }
+  if (out.dones) {
+    out.dones[index] = done;
+  }
+
+  if (done) {
+    env.episodes++;
+    resetEnv(env);
+  }
+  observe(env, out.observations + index * observationSize(),
+          out.frames ? out.frames + index * frameSize() : nullptr);
+}
+
+void VecEnv::observe(Env &env, float *observation, uint8_t *frame) {
+  Game &game = *env.game;
+  const Player &player = *game.getPlayer();
+  const WorldRect &world = game.getCamera().getWorld();
+  const float px = player.getX();
+  const float py = player.getY();
+  const float invWidth = 1.0f / game.getWidth();
+  const float invHeight = 1.0f / game.getHeight();
+
+  float *o = observation;
+  o[0] = (px - world.x) / world.w;
+  o[1] = (py - world.y) / world.h;
+  o[2] = std::max(0, player.getHealth()) /
+         static_cast<float>(player.getMaxHealth());
+  o[3] = player.isShotReady() ? 1.0f : 0.0f;
+  o[4] = player.getVelocity().x / SHIP_SPEED;
+  o[5] = player.getVelocity().y / SHIP_SPEED;
+  o[6] = game.getDifficulty() / MAX_DIFFICULTY;
+  o[7] = game.getCombo() / MAX_COMBO;
+  o += PLAYER_FEATURES;
+
+  // Nearest enemies
+  env.nearEnemies.clear();
+  for (const auto &bucket : game.getEnemies().all()) {
+    for (const Enemy &enemy : bucket) {
+      if (!enemy.isActive())
+        continue;
+      float dx = enemy.getX() - px;
+      float dy = enemy.getY() - py;
+      env.nearEnemies.emplace_back(dx * dx + dy * dy, &enemy);
+    }
+  }
+  selectNearest(env.nearEnemies, config.maxEnemies,
+                [](const std::pair<float, const Enemy *> &e) {
+                  return e.first;
+                });
+
+  for (const auto &entry : env.nearEnemies) {
+    const Enemy &enemy = *entry.second;
+    int type = static_cast<int>(enemy.getType());
+    o[0] = 1.0f;
+    o[1] = (enemy.getX() - px) * invWidth;
+    o[2] = (enemy.getY() - py) * invHeight;
+    o[3] = enemy.getVelocity().x / SHIP_SPEED;
+    o[4] = enemy.getVelocity().y / SHIP_SPEED;
+    o[5] = enemy.getHealth() /
+           static_cast<float>(enemyStats(enemy.getType()).health);
+    o[6] = type == 0;
+    o[7] = type == 1;
+    o[8] = type == 2;
+    o += ENEMY_FEATURES;
+  }
+  size_t emptyEnemies = config.maxEnemies - env.nearEnemies.size();
+  std::fill(o, o + emptyEnemies * ENEMY_FEATURES, 0.0f);
+  o += emptyEnemies * ENEMY_FEATURES;
+
+  // Nearest enemy projectiles, positions solved from their records
+  const ProjectileSystem &projectiles = game.getEnemyProjectiles();
+  const float now = projectiles.getTime();
+  env.nearProjectiles.clear();
+  for (const Projectile &p : projectiles.all()) {
+    if (p.expireTime <= now)
+      continue;
+
+    Vector2 pos = projectiles.positionAt(p);
+    float vx = p.vx;
+    float vy = p.vy;
+    if (p.spin != 0.0f) {
+      // d/dt of R(spin * t) v t: the rotated velocity plus its sweep
+      float t = now - p.spawnTime;
+      float c = std::cos(p.spin * t);
+      float s = std::sin(p.spin * t);
+      float ux = p.vx * c - p.vy * s;
+      float uy = p.vx * s + p.vy * c;
+      vx = ux - p.spin * t * uy;
+      vy = uy + p.spin * t * ux;
+    }
+    float dx = pos.x - px;
+    float dy = pos.y - py;
+    env.nearProjectiles.push_back({dx * dx + dy * dy, pos.x, pos.y, vx, vy});
+  }
+  selectNearest(env.nearProjectiles, config.maxProjectiles,
+                [](const NearProjectile &p) { return p.distance; });
+
+  for (const NearProjectile &p : env.nearProjectiles) {
+    o[0] = 1.0f;
+    o[1] = (p.x - px) * invWidth;
+    o[2] = (p.y - py) * invHeight;
+    o[3] = p.vx / SHOT_SPEED;
+    o[4] = p.vy / SHOT_SPEED;
+    o += PROJECTILE_FEATURES;
+  }
+  size_t emptyProjectiles =
+      config.maxProjectiles - env.nearProjectiles.size();
+  std::fill(o, o + emptyProjectiles * PROJECTILE_FEATURES, 0.0f);
+
+  if (frame) {
+    rasterize(game, frame);
+  }
+}
+
+void VecEnv::rasterize(const Game &game, uint8_t *frame) const {
+  const int width = config.rasterWidth;
+  const int height = config.rasterHeight;
+  std::memset(frame, 0, frameSize());
+
+  const WorldRect &view = game.getCamera().getView();
+  const float scaleX = width / view.w;
+  const float scaleY = height / view.h;
+
+  // World-space box to frame pixels; anything visible covers at least one
+  auto fill = [&](float left, float top, float right, float bottom,
+                  uint8_t value) {
+    int x0 = static_cast<int>(std::floor((left - view.x) * scaleX));
+    int y0 = static_cast<int>(std::floor((top - view.y) * scaleY));
+    int x1 = static_cast<int>(std::ceil((right - view.x) * scaleX));
+    int y1 = static_cast<int>(std::ceil((bottom - view.y) * scaleY));
+    x0 = std::max(x0, 0);
+    y0 = std::max(y0, 0);
+    x1 = std::min(x1, width);
+    y1 = std::min(y1, height);
+    if (x1 <= x0)
+      return;
+    for (int y = y0; y < y1; y++) {
+      std::memset(frame + size_t(y) * width + x0, value, x1 - x0);
+    }
+  };
+  auto fillRect = [&fill](const SDL_Rect &r, uint8_t value) {
+    fill(static_cast<float>(r.x), static_cast<float>(r.y),
+         static_cast<float>(r.x + r.w), static_cast<float>(r.y + r.h), value);
+  };
+
+  const ProjectileSystem &projectiles = game.getEnemyProjectiles();
+  for (const Projectile &p : projectiles.all()) {
+    if (p.expireTime <= projectiles.getTime())
+      continue;
+    Vector2 pos = projectiles.positionAt(p);
+    const float halfW = ProjectileSystem::WIDTH / 2;
+    const float halfH = ProjectileSystem::HEIGHT / 2;
+    fill(pos.x - halfW, pos.y - halfH, pos.x + halfW, pos.y + halfH, 64);
+  }
+
+  for (const auto &bucket : game.getEnemies().all()) {
+    for (const Enemy &enemy : bucket) {
+      if (enemy.isActive()) {
+        int type = static_cast<int>(enemy.getType());
+        fillRect(enemy.getBoundingBox(), static_cast<uint8_t>(96 + 32 * type));
+      }
+    }
+  }
+
+  for (const auto &bullet : game.getPlayerBullets()) {
+    if (bullet->isActive()) {
+      fillRect(bullet->getBoundingBox(), 192);
+    }
+  }
+
+  fillRect(game.getPlayer()->getBoundingBox(), 255);
+}
+
+template <typename Job> void VecEnv::parallelFor(const Job &job) {
+  if (workers.empty()) {
+    job(size_t(0), envs.size());
+    return;
+  }
+
+  {
+    std::lock_guard<std::mutex> lock(mutex);
+    jobData = &job;
+    jobThunk = [](const void *data, size_t begin, size_t end) {
+      (*static_cast<const Job *>(data))(begin, end);
+    };
+    pending = static_cast<int>(workers.size());
+    generation++;
+  }
+  wake.notify_all();
+
+  runRange(0);
+
+  std::unique_lock<std::mutex> lock(mutex);
+  finished.wait(lock, [this]() { return pending == 0; });
+}
+
+void VecEnv::runRange(int worker) {
+  // Contiguous ranges, so each thread keeps to its own envs' memory
+  size_t count = envs.size();
+  size_t begin = count * worker / config.threads;
+  size_t end = count * (worker + 1) / config.threads;
+  jobThunk(jobData, begin, end);
+}
+
+void VecEnv::workerLoop(int worker) {
+  uint64_t seen = 0;
+  for (;;) {
+    {
+      std::unique_lock<std::mutex> lock(mutex);
+      wake.wait(lock,
+                [this, seen]() { return stopping || generation != seen; });
+      if (stopping)
+        return;
+      seen = generation;
+    }
+
+    runRange(worker);
+
+    std::lock_guard<std::mutex> lock(mutex);
+    if (--pending == 0) {
+      finished.notify_one();
+    }
+  }
+}
@@ -0,0 +1,148 @@
+#ifndef VEC_ENV_H
+#define VEC_ENV_H
+
+#include <SDL2/SDL.h>
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+class Enemy;
+class Game;
+
+// Action bitmask over the keys Player reads (WASD/arrows and Space)
+enum EnvAction : uint8_t {
+  ACTION_UP = 1 << 0,
+  ACTION_DOWN = 1 << 1,
+  ACTION_LEFT = 1 << 2,
+  ACTION_RIGHT = 1 << 3,
+  ACTION_SHOOT = 1 << 4
+};
+
+struct VecEnvConfig {
+  int envCount = 1;
+  unsigned seed = 1;        // Episode k of env i: seed + i + k * envCount
+  int maxEnemies = 16;      // Nearest enemies observed
+  int maxProjectiles = 32;  // Nearest enemy projectiles observed
+  int rasterWidth = 0;      // Low-res frame of the view; 0 = none
+  int rasterHeight = 0;
+  int threads = 1;          // Including the caller
+  int frameSkip = 1;        // Frames per step, action held
+  int maxSteps = 0;         // Episode cut-off (done); 0 = none
+  float hitPenalty = 50.0f; // Reward lost per point of health lost
+  float worldWidth = 0;     // 0 = the game's default world
+  float worldHeight = 0;
+};
+
+// Caller-owned output buffers, written in place by reset() and step().
+// Row i belongs to env i: observations holds envCount * observationSize()
+// floats, frames envCount * frameSize() bytes (may be null when there is
+// no raster), rewards and dones envCount entries each.
+struct VecEnvBuffers {
+  float *observations = nullptr;
+  uint8_t *frames = nullptr;
+  float *rewards = nullptr;
+  uint8_t *dones = nullptr;
+};
+
+// Runs envCount headless Games in one process and steps them together.
+//
+// No SDL video, renderer or audio is touched, so it runs on machines
+// without a display. Each observation row is a flat feature tensor,
+// positions relative to the player and scaled by the screen size:
+//
+//   player       PLAYER_FEATURES: x and y in the world (0..1), health
+//                fraction, shot ready, velocity x and y (-1..1),
+//                difficulty (0..1), combo / 10
+//   enemies      maxEnemies x ENEMY_FEATURES, nearest first: present,
+//                dx, dy, vx, vy, health fraction, one-hot type (3)
+//   projectiles  maxProjectiles x PROJECTILE_FEATURES, nearest first:
+//                present, dx, dy, vx, vy
+//
+// Empty slots are all zero. The optional raster is a grayscale frame of
+// the camera view: player 255, player bullets 192, enemies 96/128/160 by
+// type, projectiles 64, background 0.
+//
+// The reward is the score gained minus hitPenalty per health lost. When an
+// env finishes (the player died or maxSteps passed) its done flag is set
+// and it resets at once: the observation written is the first of the next
+// episode. With threads > 1 a persistent pool steps contiguous ranges of
+// envs; results do not depend on the thread count.
+class VecEnv {
+public:
+  static constexpr int PLAYER_FEATURES = 8;
+  static constexpr int ENEMY_FEATURES = 9;
+  static constexpr int PROJECTILE_FEATURES = 5;
+  static constexpr float FRAME_DT = 1.0f / 60; // Fixed, like scenarios
+
+  explicit VecEnv(const VecEnvConfig &config);
+  ~VecEnv();
+
+  VecEnv(const VecEnv &) = delete;
+  VecEnv &operator=(const VecEnv &) = delete;
+
+  int getEnvCount() const { return config.envCount; }
+  const VecEnvConfig &getConfig() const { return config; }
+  size_t observationSize() const; // Floats per env
+  size_t frameSize() const;       // Bytes per env (0 without a raster)
+
+  // Starts a fresh episode in every env and writes the observations
+  // (rewards and dones are zeroed)
+  void reset(const VecEnvBuffers &out);
+
+  // Applies actions[i] (EnvAction bits) to env i for frameSkip frames.
+  // The first call resets if reset() hasn't been called.
+  void step(const uint8_t *actions, const VecEnvBuffers &out);
+
+  uint64_t getEpisodes() const; // Finished so far, all envs
+  uint64_t getFrames() const { return frames; }
+
+private:
+  struct NearProjectile {
+    float distance;
+    float x, y, vx, vy;
+  };
+
+  struct Env {
+    std::unique_ptr<Game> game;
+    unsigned seed;
+    int steps;
+    uint64_t episodes;
+    Uint8 keys[SDL_NUM_SCANCODES];
+
+    // Scratch for the nearest-entity selection, reused every step
+    std::vector<std::pair<float, const Enemy *>> nearEnemies;
+    std::vector<NearProjectile> nearProjectiles;
+  };
+
+  void resetEnv(Env &env);
+  void stepEnv(size_t index, const uint8_t *actions, const VecEnvBuffers &out);
+  void observe(Env &env, float *observation, uint8_t *frame);
+  void rasterize(const Game &game, uint8_t *frame) const;
+
+  // Runs job(begin, end) over all envs, split across the pool
+  template <typename Job> void parallelFor(const Job &job);
+  void workerLoop(int worker);
+  void runRange(int worker);
+
+  VecEnvConfig config;
+  std::vector<Env> envs;
+  uint64_t frames;
+  bool started;
+
+  // Pool: the caller is worker 0
+  std::vector<std::thread> workers;
+  std::mutex mutex;
+  std::condition_variable wake;
+  std::condition_variable finished;
+  uint64_t generation; // Bumped per job
+  int pending;         // Workers still running the job
+  bool stopping;
+  void (*jobThunk)(const void *job, size_t begin, size_t end);
+  const void *jobData;
+};
+
+#endif // VEC_ENV_H
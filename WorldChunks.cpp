@@ -0,0 +1,39 @@
+#include "WorldChunks.h"
+#include <algorithm>
+#include <cmath>
+
+WorldChunks::WorldChunks() : columns(1), rows(1), count(0) {
+  chunks.resize(1);
+}
+
+void WorldChunks::resize(float worldWidth, float worldHeight) {
+  columns = std::max(1, static_cast<int>(std::ceil(worldWidth / CHUNK_SIZE)));
+  rows = std::max(1, static_cast<int>(std::ceil(worldHeight / CHUNK_SIZE)));
+
+  chunks.clear();
+  chunks.resize(static_cast<size_t>(columns) * rows);
+  count = 0;
+}
+
+void WorldChunks::clear() {
+  // Chunks keep their capacity for the next run
+  for (auto &chunk : chunks) {
+    chunk.clear();
+  }
+  count = 0;
+}
+
+void WorldChunks::add(const DormantEnemy &enemy) {
+  // Enemies just outside the world edge sleep in the nearest chunk
+  chunks[row(enemy.y) * columns + column(enemy.x)].push_back(enemy);
+  count++;
+}
+
+int WorldChunks::column(float x) const {
+  return std::clamp(static_cast<int>(std::floor(x / CHUNK_SIZE)), 0,
+                    columns - 1);
+}
+
+int WorldChunks::row(float y) const {
+  return std::clamp(static_cast<int>(std::floor(y / CHUNK_SIZE)), 0, rows - 1);
+}
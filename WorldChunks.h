@@ -0,0 +1,82 @@
+#ifndef WORLD_CHUNKS_H
+#define WORLD_CHUNKS_H
+
+#include "Camera.h"
+#include <cstdint>
+#include <vector>
+
+// An enemy asleep outside the active region: just enough to bring it back
+// as it was (16 bytes, no handle, no timers)
+struct DormantEnemy {
+  float x, y;
+  float animTimer;
+  int16_t health;
+  uint8_t type; // EnemyType
+};
+
+// Dormant enemies bucketed into a grid of CHUNK_SIZE square chunks over the
+// world.
+//
+// Sleeping enemies cost nothing per frame: they aren't updated, drawn,
+// collided or steered, and own no timers. Each frame wake() visits only
+// the chunks the active region overlaps, so its cost depends on the local
+// density, not on how many enemies the whole world holds.
+class WorldChunks {
+public:
+  static constexpr int CHUNK_SIZE = 512;
+
+  WorldChunks();
+
+  // Drops every dormant enemy
+  void resize(float worldWidth, float worldHeight);
+  void clear();
+
+  void add(const DormantEnemy &enemy);
+
+  // Removes every dormant enemy inside region, in chunk order, and hands
+  // it to wakeEnemy; returns how many woke
+  template <typename WakeFunction>
+  int wake(const WorldRect &region, WakeFunction wakeEnemy) {
+    int minCol = column(region.x);
+    int maxCol = column(region.right());
+    int minRow = row(region.y);
+    int maxRow = row(region.bottom());
+
+    int woken = 0;
+    for (int r = minRow; r <= maxRow; r++) {
+      for (int c = minCol; c <= maxCol; c++) {
+        std::vector<DormantEnemy> &chunk = chunks[r * columns + c];
+
+        size_t write = 0;
+        for (size_t read = 0; read < chunk.size(); read++) {
+          const DormantEnemy &enemy = chunk[read];
+          if (region.contains(Vector2(enemy.x, enemy.y))) {
+            wakeEnemy(enemy);
+            woken++;
+            continue;
+          }
+          chunk[write++] = enemy;
+        }
+        chunk.resize(write);
+      }
+    }
+
+    count -= woken;
+    return woken;
+  }
+
+  size_t size() const { return count; }
+  int getColumns() const { return columns; }
+  int getRows() const { return rows; }
+
+private:
+  int column(float x) const;
+  int row(float y) const;
+
+  std::vector<std::vector<DormantEnemy>> chunks;
+  int columns;
+  int rows;
+  size_t count;
+};
+
+#endif // WORLD_CHUNKS_H
@@ -0,0 +1,75 @@
+// Audio callback cost: one 512-frame buffer with a full set of voices, per
+// mixing path (an unsupported path falls back, see AudioMixer::setPath).
+
+#include "AudioMixer.h"
+#include "Bench.h"
+#include <vector>
+
+namespace {
+
+constexpr int FRAMES = 512;
+
+// Starts count voices without hitting any per-sound limit
+void startVoices(AudioMixer &mixer, size_t count) {
+  const Sound order[] = {Sound::Explosion, Sound::EnemyShot, Sound::Hit,
+                         Sound::PlayerShot, Sound::PlayerHit};
+  const int limits[] = {12, 8, 6, 4, 2};
+
+  mixer.stopAll();
+  size_t started = 0;
+  for (int i = 0; i < 5 && started < count; i++) {
+    for (int j = 0; j < limits[i] && started < count; j++, started++) {
+      mixer.play(order[i], 1.0f, -1.0f + 0.1f * static_cast<float>(started));
+    }
+  }
+}
+
+void runMix(BenchState &state, AudioMixer::Path path) {
+  AudioMixer mixer;
+  mixer.setPath(path);
+  mixer.prepare(48000);
+  std::vector<float> out(FRAMES * AudioMixer::CHANNELS);
+  state.setItems(state.size() * FRAMES); // Voice-frames
+
+  state.run([&] { startVoices(mixer, state.size()); },
+            [&] {
+              mixer.mix(out.data(), FRAMES);
+              doNotOptimize(out[0]);
+            });
+}
+
+BENCHMARK("audio/mixScalar", {8, 24}, [](BenchState &state) {
+  runMix(state, AudioMixer::Path::Scalar);
+});
+
+BENCHMARK("audio/mixSSE2", {8, 24}, [](BenchState &state) {
+  runMix(state, AudioMixer::Path::SSE2);
+});
+
+BENCHMARK("audio/mixAVX2", {8, 24}, [](BenchState &state) {
+  runMix(state, AudioMixer::Path::AVX2);
+});
+
+// An explosion flood: size Explosion commands per buffer on top of a full
+// mixer, so most of them steal or are rejected
+BENCHMARK("audio/steal", {16, 64}, [](BenchState &state) {
+  AudioMixer mixer;
+  mixer.prepare(48000);
+  std::vector<float> out(FRAMES * AudioMixer::CHANNELS);
+  state.setItems(state.size());
+
+  state.run(
+      [&] {
+        startVoices(mixer, AudioMixer::MAX_VOICES);
+        mixer.mix(out.data(), FRAMES);
+        for (size_t i = 0; i < state.size(); i++) {
+          mixer.play(Sound::Explosion, 1.0f, 0.0f, 3);
+        }
+      },
+      [&] {
+        mixer.mix(out.data(), FRAMES);
+        doNotOptimize(out[0]);
+      });
+});
+
+} // namespace
@@ -0,0 +1,198 @@
+// Benchmark runner: stellar_bench [options]
+//
+//   --filter TEXT   only run benchmarks whose name contains TEXT
+//   --size N        override every benchmark's problem sizes with N
+//   --warmup N      untimed repetitions before measuring (default 3)
+//   --reps N        timed repetitions (default 25)
+//   --json PATH     also write results as JSON (for comparing runs)
+//   --list          print benchmark names and exit
+
+#include "Bench.h"
+#include "Percentile.h"
+#include <SDL2/SDL.h>
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <iostream>
+
+namespace {
+
+struct BenchResult {
+  std::string name;
+  size_t size;
+  size_t items;
+  int reps;
+  double medianNs;
+  double p99Ns;
+  double minNs;
+  double meanNs;
+};
+
+BenchResult summarize(const std::string &name, size_t size,
+                      const BenchState &state) {
+  std::vector<double> sorted = state.getSamples();
+  std::sort(sorted.begin(), sorted.end());
+
+  double total = 0;
+  for (double s : sorted) {
+    total += s;
+  }
+
+  BenchResult result;
+  result.name = name;
+  result.size = size;
+  result.items = state.getItems();
+  result.reps = static_cast<int>(sorted.size());
+  result.medianNs = percentile(sorted, 0.5);
+  result.p99Ns = percentile(sorted, 0.99);
+  result.minNs = sorted.empty() ? 0 : sorted.front();
+  result.meanNs = sorted.empty() ? 0 : total / sorted.size();
+  return result;
+}
+
+void printResult(const BenchResult &r) {
+  char line[256];
+  std::snprintf(line, sizeof(line),
+                "%-34s %8zu %12.1f %12.1f %12.1f", r.name.c_str(), r.size,
+                r.medianNs / 1000.0, r.p99Ns / 1000.0, r.minNs / 1000.0);
+  std::cout << line;
+  if (r.items > 0) {
+    std::snprintf(line, sizeof(line), " %10.2f", r.medianNs / r.items);
+    std::cout << line;
+  }
+  std::cout << std::endl;
+}
+
+bool writeJson(const char *path, const std::vector<BenchResult> &results,
+               int warmup, int reps) {
+  FILE *file = std::fopen(path, "w");
+  if (!file)
+    return false;
+
+  std::fprintf(file, "{\n  \"warmup\": %d,\n  \"reps\": %d,\n", warmup, reps);
+  std::fprintf(file, "  \"benchmarks\": [\n");
+  for (size_t i = 0; i < results.size(); i++) {
+    const BenchResult &r = results[i];
+    std::fprintf(file,
+                 "    {\"name\": \"%s\", \"size\": %zu, \"items\": %zu, "
+                 "\"reps\": %d, \"median_ns\": %.1f, \"p99_ns\": %.1f, "
+                 "\"min_ns\": %.1f, \"mean_ns\": %.1f}%s\n",
+                 r.name.c_str(), r.size, r.items, r.reps, r.medianNs, r.p99Ns,
+                 r.minNs, r.meanNs, i + 1 < results.size() ? "," : "");
+  }
+  std::fprintf(file, "  ]\n}\n");
+  std::fclose(file);
+  return true;
+}
+
+} // namespace
+
+BenchState::BenchState(size_t size, int warmup, int reps)
+    : problemSize(size), warmupReps(warmup), timedReps(reps), itemsPerRep(0) {}
+
+void BenchState::run(const std::function<void()> &work) {
+  run([] {}, work);
+}
+
+void BenchState::run(const std::function<void()> &setup,
+                     const std::function<void()> &work) {
+  using Clock = std::chrono::steady_clock;
+
+  for (int i = 0; i < warmupReps; i++) {
+    setup();
+    work();
+  }
+
+  samples.clear();
+  samples.reserve(timedReps);
+  for (int i = 0; i < timedReps; i++) {
+    setup();
+    auto start = Clock::now();
+    work();
+    std::chrono::duration<double, std::nano> elapsed = Clock::now() - start;
+    samples.push_back(elapsed.count());
+  }
+}
+
+std::vector<BenchDefinition> &benchRegistry() {
+  static std::vector<BenchDefinition> registry;
+  return registry;
+}
+
+int main(int argc, char *argv[]) {
+  const char *filter = nullptr;
+  const char *jsonPath = nullptr;
+  size_t sizeOverride = 0;
+  int warmup = 3;
+  int reps = 25;
+  bool listOnly = false;
+
+  for (int i = 1; i < argc; i++) {
+    bool hasValue = i + 1 < argc;
+    if (!std::strcmp(argv[i], "--filter") && hasValue) {
+      filter = argv[++i];
+    } else if (!std::strcmp(argv[i], "--size") && hasValue) {
+      sizeOverride = std::strtoul(argv[++i], nullptr, 10);
+    } else if (!std::strcmp(argv[i], "--warmup") && hasValue) {
+      warmup = std::atoi(argv[++i]);
+    } else if (!std::strcmp(argv[i], "--reps") && hasValue) {
+      reps = std::max(1, std::atoi(argv[++i]));
+    } else if (!std::strcmp(argv[i], "--json") && hasValue) {
+      jsonPath = argv[++i];
+    } else if (!std::strcmp(argv[i], "--list")) {
+      listOnly = true;
+    } else {
+      std::cerr << "Unknown option: " << argv[i] << std::endl;
+      return 1;
+    }
+  }
+
+  // Render benchmarks draw through SDL's software renderer; no display needed
+  SDL_SetHint(SDL_HINT_VIDEODRIVER, "dummy");
+
+  auto &registry = benchRegistry();
+  std::sort(registry.begin(), registry.end(),
+            [](const BenchDefinition &a, const BenchDefinition &b) {
+              return a.name < b.name;
+            });
+
+  if (listOnly) {
+    for (const auto &bench : registry) {
+      std::cout << bench.name << std::endl;
+    }
+    return 0;
+  }
+
+  std::cout << "warmup " << warmup << ", reps " << reps << std::endl;
+  std::cout << "benchmark                              size   median(us)"
+               "      p99(us)      min(us)    ns/item"
+            << std::endl;
+
+  std::vector<BenchResult> results;
+  for (const auto &bench : registry) {
+    if (filter && bench.name.find(filter) == std::string::npos)
+      continue;
+
+    std::vector<size_t> sizes = bench.sizes;
+    if (sizeOverride > 0)
+      sizes = {sizeOverride};
+
+    for (size_t size : sizes) {
+      BenchState state(size, warmup, reps);
+      bench.function(state);
+      results.push_back(summarize(bench.name, size, state));
+      printResult(results.back());
+    }
+  }
+
+  if (jsonPath) {
+    if (!writeJson(jsonPath, results, warmup, reps)) {
+      std::cerr << "Could not write " << jsonPath << std::endl;
+      return 1;
+    }
+    std::cout << "Wrote " << jsonPath << std::endl;
+  }
+  return 0;
+}
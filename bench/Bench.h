@@ -0,0 +1,74 @@
+#ifndef BENCH_H
+#define BENCH_H
+
+#include <cstddef>
+#include <functional>
+#include <string>
+#include <vector>
+
+// Minimal dependency-free benchmark harness.
+//
+//   BENCHMARK("particle/update", {1000, 10000}, [](BenchState &state) {
+//     ParticleWorld world(state.size());          // fixture, not timed
+//     state.setItems(state.size());
+//     state.run([&] { world.update(); });           // warmup + timed reps
+//   });
+//
+// Each timed repetition calls the work function once; the runner reports
+// the median and p99 of the repetition times (and per-item cost when the
+// benchmark declares its item count).
+
+class BenchState {
+public:
+  BenchState(size_t size, int warmup, int reps);
+
+  size_t size() const { return problemSize; }
+  void setItems(size_t items) { itemsPerRep = items; }
+
+  // Times work() reps times after warmup untimed calls
+  void run(const std::function<void()> &work);
+
+  // Like run(), but setup() runs untimed before every call of work()
+  void run(const std::function<void()> &setup,
+           const std::function<void()> &work);
+
+  const std::vector<double> &getSamples() const { return samples; }
+  size_t getItems() const { return itemsPerRep; }
+
+private:
+  size_t problemSize;
+  int warmupReps;
+  int timedReps;
+  size_t itemsPerRep;
+  std::vector<double> samples; // Nanoseconds per repetition
+};
+
+using BenchFunction = std::function<void(BenchState &)>;
+
+struct BenchDefinition {
+  std::string name;
+  std::vector<size_t> sizes;
+  BenchFunction function;
+};
+
+std::vector<BenchDefinition> &benchRegistry();
+
+struct BenchRegistrar {
+  BenchRegistrar(const char *name, std::vector<size_t> sizes,
+                 BenchFunction function) {
+    benchRegistry().push_back({name, std::move(sizes), std::move(function)});
+  }
+};
+
+// Prevents the optimizer from discarding a computed value
+template <typename T> inline void doNotOptimize(const T &value) {
+  asm volatile("" : : "r,m"(value) : "memory");
+}
+
+#define BENCH_CONCAT_INNER(a, b) a##b
+#define BENCH_CONCAT(a, b) BENCH_CONCAT_INNER(a, b)
+// BENCHMARK(name, {sizes...}, function)
+#define BENCHMARK(...)                                                         \
+  static BenchRegistrar BENCH_CONCAT(benchRegistrar, __LINE__)(__VA_ARGS__)
+
+#endif // BENCH_H
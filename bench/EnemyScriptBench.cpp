@@ -0,0 +1,111 @@
+// Enemy behaviour update cost: the type-specialized switch path against
+// the same drifter movement written as a coroutine script, plus scripts
+// parked on a delay and script spawn/teardown through the frame pool.
+// Items are enemy ticks (or scripts spawned).
+
+#include "Bench.h"
+#include "Enemy.h"
+#include "EnemyScript.h"
+#include "Fixtures.h"
+#include "Game.h"
+#include <cmath>
+#include <vector>
+
+namespace {
+
+// updateDrifter() as a script: one resume per tick
+EnemyScript drifterScript(ScriptPool &) {
+  ScriptContext &ctx = co_await EnemyScript::context();
+  constexpr const EnemyStats &stats = enemyStats<EnemyType::Drifter>();
+  for (;;) {
+    ctx.self->setVelocity(std::sin(ctx.self->getAnimTimer() *
+                                   stats.wobbleFrequency) *
+                              stats.wobbleAmplitude,
+                          stats.descentSpeed);
+    co_await EnemyScript::nextTick();
+  }
+}
+
+// Waits out a long delay: the owner skips the resume every tick
+EnemyScript waitingScript(ScriptPool &) {
+  co_await EnemyScript::delay(1e9f);
+}
+
+struct EnemyFixture {
+  EnemyFixture() { game.startHeadless(1); }
+
+  void spawn(size_t count) {
+    enemies.clear();
+    enemies.reserve(count);
+    for (size_t i = 0; i < count; i++) {
+      enemies.emplace_back(static_cast<float>(i % BENCH_SCREEN_W),
+                           static_cast<float>(i % BENCH_SCREEN_H),
+                           EnemyType::Drifter);
+    }
+  }
+
+  void tick() {
+    for (auto &enemy : enemies) {
+      enemy.update<EnemyType::Drifter>(BENCH_DT, game);
+    }
+    doNotOptimize(enemies.back().getX());
+  }
+
+  Game game;
+  ScriptPool pool;
+  std::vector<Enemy> enemies;
+};
+
+BENCHMARK("enemy/update-switch", {1000, 10000}, [](BenchState &state) {
+  EnemyFixture fixture;
+  state.setItems(state.size());
+  state.run([&] { fixture.spawn(state.size()); }, [&] { fixture.tick(); });
+});
+
+BENCHMARK("enemy/update-script", {1000, 10000}, [](BenchState &state) {
+  EnemyFixture fixture;
+  state.setItems(state.size());
+  state.run(
+      [&] {
+        fixture.spawn(state.size());
+        for (auto &enemy : fixture.enemies) {
+          enemy.setScript(drifterScript(fixture.pool));
+        }
+      },
+      [&] { fixture.tick(); });
+});
+
+BENCHMARK("enemy/update-script-waiting", {1000, 10000},
+          [](BenchState &state) {
+            EnemyFixture fixture;
+            state.setItems(state.size());
+            state.run(
+                [&] {
+                  fixture.spawn(state.size());
+                  for (auto &enemy : fixture.enemies) {
+                    enemy.setScript(waitingScript(fixture.pool));
+                    enemy.setVelocity(0, 80.0f);
+                  }
+                  fixture.tick(); // Run up to the delay
+                },
+                [&] { fixture.tick(); });
+          });
+
+BENCHMARK("enemy/script-spawn", {1000, 10000}, [](BenchState &state) {
+  ScriptPool pool;
+  std::vector<EnemyScript> scripts(state.size());
+  state.setItems(state.size());
+
+  // The first rep grows the pool; later ones only recycle its blocks
+  state.run([&] {
+    for (auto &script : scripts) {
+      script = bomberScript(pool);
+    }
+    for (auto &script : scripts) {
+      script.reset();
+    }
+    doNotOptimize(pool.getReservedBytes());
+  });
+});
+
+} // namespace
@@ -0,0 +1,49 @@
+// Entity collision checks and the per-frame remove_if compaction.
+
+#include "Bench.h"
+#include "Fixtures.h"
+#include <algorithm>
+
+namespace {
+
+BENCHMARK("entity/collidesWith", {100, 1000, 5000}, [](BenchState &state) {
+  SyntheticWorld world(state.size());
+  state.setItems(world.playerBullets.size() * world.enemies.size());
+
+  state.run([&] {
+    int hits = 0;
+    for (const auto &bullet : world.playerBullets) {
+      for (const auto &enemy : world.enemies) {
+        hits += bullet->collidesWith(enemy);
+      }
+    }
+    doNotOptimize(hits);
+  });
+});
+
+BENCHMARK("entity/removeInactive", {1000, 10000, 100000},
+          [](BenchState &state) {
+            std::vector<std::unique_ptr<Bullet>> bullets;
+            state.setItems(state.size());
+
+            // Rebuild untimed each rep: a quarter of the bullets are dead
+            auto setup = [&] {
+              std::mt19937 rng(7);
+              bullets.clear();
+              for (size_t i = 0; i < state.size(); i++) {
+                bullets.push_back(
+                    std::make_unique<Bullet>(0, 0, 0, -500.0f, true));
+                bullets.back()->setActive(rng() % 4 != 0);
+              }
+            };
+
+            state.run(setup, [&] {
+              bullets.erase(
+                  std::remove_if(bullets.begin(), bullets.end(),
+                                 [](const auto &b) { return !b->isActive(); }),
+                  bullets.end());
+              doNotOptimize(bullets.size());
+            });
+          });
+
+} // namespace
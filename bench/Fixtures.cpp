@@ -0,0 +1,60 @@
+#include "Fixtures.h"
+#include <cmath>
+
+SoftwareCanvas::SoftwareCanvas(int width, int height)
+    : surface(nullptr), renderer(nullptr) {
+  surface = SDL_CreateRGBSurfaceWithFormat(0, width, height, 32,
+                                           SDL_PIXELFORMAT_ARGB8888);
+  if (surface) {
+    renderer = SDL_CreateSoftwareRenderer(surface);
+  }
+  if (renderer) {
+    SDL_SetRenderDrawBlendMode(renderer, SDL_BLENDMODE_BLEND);
+  }
+}
+
+SoftwareCanvas::~SoftwareCanvas() {
+  if (renderer)
+    SDL_DestroyRenderer(renderer);
+  if (surface)
+    SDL_FreeSurface(surface);
+}
+
+void makeParticles(ParticleSystem &particles, size_t count,
+                   std::mt19937 &rng) {
+  std::uniform_real_distribution<float> xs(0, BENCH_SCREEN_W);
+  std::uniform_real_distribution<float> ys(0, BENCH_SCREEN_H);
+  std::uniform_real_distribution<float> angle(0, 2.0f * 3.14159f);
+  std::uniform_real_distribution<float> speed(50, 200);
+  std::uniform_real_distribution<float> life(0.3f, 0.8f);
+  std::uniform_real_distribution<float> size(2, 6);
+
+  for (size_t i = 0; i < count; i++) {
+    float a = angle(rng);
+    float s = speed(rng);
+    particles.add(xs(rng), ys(rng), std::cos(a) * s, std::sin(a) * s,
+                  life(rng), size(rng), SDL_Color{255, 150, 50, 255});
+  }
+}
+
+SyntheticWorld::SyntheticWorld(size_t size, unsigned seed)
+    : particles(BENCH_BURST_SEED) {
+  std::mt19937 rng(seed);
+  std::uniform_real_distribution<float> xs(0, BENCH_SCREEN_W);
+  std::uniform_real_distribution<float> ys(0, BENCH_SCREEN_H);
+  std::uniform_int_distribution<int> type(0, ENEMY_TYPE_COUNT - 1);
+
+  playerBullets.reserve(size);
+  for (size_t i = 0; i < size; i++) {
+    playerBullets.push_back(
+        std::make_unique<Bullet>(xs(rng), ys(rng), 0, -500.0f, true));
+  }
+
+  size_t enemyCount = size / 8 > 0 ? size / 8 : 1;
+  enemies.reserve(enemyCount);
+  for (size_t i = 0; i < enemyCount; i++) {
+    enemies.emplace_back(xs(rng), ys(rng), static_cast<EnemyType>(type(rng)));
+  }
+
+  makeParticles(particles, size, rng);
+}
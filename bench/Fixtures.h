@@ -0,0 +1,49 @@
+#ifndef BENCH_FIXTURES_H
+#define BENCH_FIXTURES_H
+
+#include "Bullet.h"
+#include "Enemy.h"
+#include "ParticleSystem.h"
+#include <SDL2/SDL.h>
+#include <memory>
+#include <random>
+#include <vector>
+
+// Offscreen SDL software renderer, so render benchmarks run without a
+// window or GPU (e.g. headless Linux CI)
+class SoftwareCanvas {
+public:
+  SoftwareCanvas(int width = 800, int height = 600);
+  ~SoftwareCanvas();
+
+  SoftwareCanvas(const SoftwareCanvas &) = delete;
+  SoftwareCanvas &operator=(const SoftwareCanvas &) = delete;
+
+  SDL_Renderer *getRenderer() const { return renderer; }
+
+private:
+  SDL_Surface *surface;
+  SDL_Renderer *renderer;
+};
+
+// Deterministic synthetic playfield with `size` player bullets and
+// particles, and size / 8 enemies of mixed types
+struct SyntheticWorld {
+  explicit SyntheticWorld(size_t size, unsigned seed = 1);
+
+  std::vector<std::unique_ptr<Bullet>> playerBullets;
+  std::vector<Enemy> enemies;
+  ParticleSystem particles;
+};
+
+// Adds count particles scattered over the screen, drawn from the explosion
+// ranges
+void makeParticles(ParticleSystem &particles, size_t count,
+                   std::mt19937 &rng);
+
+constexpr int BENCH_SCREEN_W = 800;
+constexpr int BENCH_SCREEN_H = 600;
+constexpr float BENCH_DT = 1.0f / 60.0f;
+constexpr unsigned BENCH_BURST_SEED = 1;
+
+#endif // BENCH_FIXTURES_H
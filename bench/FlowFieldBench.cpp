@@ -0,0 +1,99 @@
+// Hunter swarm steering cost: shared flow field vs per-agent steering.
+//
+// The flow field path rebuilds the grid at its configured rate and samples
+// one cell per Hunter; the naive path seeks the player and separates from
+// every other Hunter, which is O(n^2). One repetition is one tick.
+
+#include "Bench.h"
+#include "Fixtures.h"
+#include "FlowField.h"
+#include <random>
+#include <vector>
+
+namespace {
+
+const float SCREEN_W = static_cast<float>(BENCH_SCREEN_W);
+const float SCREEN_H = static_cast<float>(BENCH_SCREEN_H);
+const float SEPARATION_RADIUS = 40.0f;
+
+struct Agent {
+  Vector2 position;
+  Vector2 velocity;
+};
+
+std::vector<Agent> makeSwarm(size_t count) {
+  std::mt19937 rng(42);
+  std::uniform_real_distribution<float> xs(0, SCREEN_W);
+  std::uniform_real_distribution<float> ys(0, SCREEN_H);
+
+  std::vector<Agent> swarm(count);
+  for (auto &agent : swarm) {
+    agent.position = Vector2(xs(rng), ys(rng));
+  }
+  return swarm;
+}
+
+void wrap(Agent &agent) {
+  if (agent.position.y > SCREEN_H)
+    agent.position.y -= SCREEN_H;
+  if (agent.position.x < 0)
+    agent.position.x += SCREEN_W;
+  if (agent.position.x > SCREEN_W)
+    agent.position.x -= SCREEN_W;
+}
+
+BENCHMARK("flowfield/field", {100, 1000, 10000}, [](BenchState &state) {
+  std::vector<Agent> swarm = makeSwarm(state.size());
+  FlowField field(SCREEN_W, SCREEN_H, FlowFieldConfig());
+  Vector2 player(SCREEN_W / 2, SCREEN_H - 80);
+  state.setItems(state.size());
+
+  state.run([&] {
+    if (field.tick(BENCH_DT)) {
+      field.clearDensity();
+      for (const auto &agent : swarm) {
+        field.deposit(agent.position);
+      }
+      field.rebuild(player);
+    }
+
+    for (auto &agent : swarm) {
+      Vector2 steer = field.sample(agent.position);
+      agent.velocity = Vector2(steer.x * 150.0f, 60.0f + steer.y * 60.0f);
+      agent.position += agent.velocity * BENCH_DT;
+      wrap(agent);
+    }
+  });
+});
+
+BENCHMARK("flowfield/naive", {100, 1000, 10000}, [](BenchState &state) {
+  std::vector<Agent> swarm = makeSwarm(state.size());
+  Vector2 player(SCREEN_W / 2, SCREEN_H - 80);
+  const float radiusSq = SEPARATION_RADIUS * SEPARATION_RADIUS;
+  state.setItems(state.size());
+
+  state.run([&] {
+    for (auto &agent : swarm) {
+      Vector2 steer = (player - agent.position).normalized();
+
+      for (const auto &other : swarm) {
+        Vector2 away = agent.position - other.position;
+        float distSq = away.magnitudeSquared();
+        if (distSq > 0 && distSq < radiusSq) {
+          steer += away * (0.5f / distSq);
+        }
+      }
+
+      if (steer.magnitudeSquared() > 1.0f)
+        steer = steer.normalized();
+      agent.velocity = Vector2(steer.x * 150.0f, 60.0f + steer.y * 60.0f);
+    }
+
+    for (auto &agent : swarm) {
+      agent.position += agent.velocity * BENCH_DT;
+      wrap(agent);
+    }
+  });
+});
+
+} // namespace
@@ -0,0 +1,44 @@
+// Frame recording encode cost: what one worker spends per frame before
+// the write. Sizes are frame widths at 4:3; items are pixels.
+
+#include "Bench.h"
+#include "FrameRecorder.h"
+#include <vector>
+
+namespace {
+
+std::vector<uint8_t> makeFrame(int width, int height) {
+  std::vector<uint8_t> rgb(size_t(width) * height * 3);
+  for (size_t i = 0; i < rgb.size(); i++) {
+    rgb[i] = static_cast<uint8_t>(i * 31 + (i >> 9));
+  }
+  return rgb;
+}
+
+BENCHMARK("record/png", {400, 800}, [](BenchState &state) {
+  int width = static_cast<int>(state.size());
+  int height = width * 3 / 4;
+  std::vector<uint8_t> rgb = makeFrame(width, height);
+  std::vector<uint8_t> png;
+  state.setItems(size_t(width) * height);
+
+  state.run([&] {
+    encodePng(rgb.data(), width, height, png);
+    doNotOptimize(png.size());
+  });
+});
+
+BENCHMARK("record/yuv420", {400, 800}, [](BenchState &state) {
+  int width = static_cast<int>(state.size());
+  int height = width * 3 / 4;
+  std::vector<uint8_t> rgb = makeFrame(width, height);
+  std::vector<uint8_t> yuv(yuv420Size(width, height));
+  state.setItems(size_t(width) * height);
+
+  state.run([&] {
+    rgbToYuv420(rgb.data(), width, height, yuv.data());
+    doNotOptimize(yuv[0]);
+  });
+});
+
+} // namespace
@@ -0,0 +1,22 @@
+// Game-level operations; size is the number of calls per repetition.
+
+#include "Bench.h"
+#include "Fixtures.h"
+#include "Game.h"
+
+namespace {
+
+BENCHMARK("game/createExplosion", {100, 1000}, [](BenchState &state) {
+  std::unique_ptr<Game> game;
+  state.setItems(state.size());
+
+  // Fresh game per rep so the particle list starts empty every time
+  state.run([&] { game = std::make_unique<Game>(); },
+            [&] {
+              for (size_t i = 0; i < state.size(); i++) {
+                game->createExplosion(400, 300, 20, {255, 150, 50, 255});
+              }
+            });
+});
+
+} // namespace
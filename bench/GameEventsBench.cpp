@@ -0,0 +1,64 @@
+// Event bus throughput: appending collision events across producer lanes
+// and merging them for the consume phase. Items are events.
+
+#include "Bench.h"
+#include "Enemy.h"
+#include "GameEvents.h"
+#include <thread>
+#include <vector>
+
+namespace {
+
+constexpr int LANES = 4;
+
+// Lane k produces the k-th quarter of the events, as a worker would
+void produce(EventLane &lane, size_t begin, size_t end) {
+  for (size_t i = begin; i < end; i++) {
+    float x = static_cast<float>(i % 800);
+    if (i % 4 == 0) {
+      lane.push(EnemyKilled{x, 300.0f, EnemyType::Drifter, 100});
+    } else {
+      lane.push(BulletExpired{x, 300.0f, true});
+    }
+  }
+}
+
+BENCHMARK("events/push-merge", {1000, 100000}, [](BenchState &state) {
+  GameEvents events(LANES);
+  state.setItems(state.size());
+
+  state.run([&] {
+    for (int k = 0; k < LANES; k++) {
+      produce(events.lane(k), state.size() * k / LANES,
+              state.size() * (k + 1) / LANES);
+    }
+    events.merge();
+    doNotOptimize(events.get<EnemyKilled>().size());
+    events.clear();
+  });
+});
+
+BENCHMARK("events/threaded-merge", {100000}, [](BenchState &state) {
+  GameEvents events(LANES);
+  state.setItems(state.size());
+
+  // Lane 0 is the calling thread, like the game thread
+  state.run([&] {
+    std::vector<std::thread> workers;
+    for (int k = 1; k < LANES; k++) {
+      workers.emplace_back([&events, &state, k] {
+        produce(events.lane(k), state.size() * k / LANES,
+                state.size() * (k + 1) / LANES);
+      });
+    }
+    produce(events.lane(0), 0, state.size() / LANES);
+    for (auto &worker : workers) {
+      worker.join();
+    }
+    events.merge();
+    doNotOptimize(events.get<EnemyKilled>().size());
+    events.clear();
+  });
+});
+
+} // namespace
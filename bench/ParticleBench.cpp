@@ -0,0 +1,82 @@
+// Particle update, render and burst spawning cost.
+
+#include "Bench.h"
+#include "Fixtures.h"
+#include <cmath>
+
+namespace {
+
+constexpr int BURSTS = 100;
+
+const WorldRect BENCH_VIEW = {0, 0, BENCH_SCREEN_W, BENCH_SCREEN_H};
+
+BENCHMARK("particle/update", {1000, 10000, 100000}, [](BenchState &state) {
+  ParticleSystem particles(BENCH_BURST_SEED);
+  state.setItems(state.size());
+
+  // Refill untimed each rep: particles expire as they update
+  state.run(
+      [&] {
+        std::mt19937 rng(3);
+        particles.clear();
+        makeParticles(particles, state.size(), rng);
+      },
+      [&] { particles.update(BENCH_DT); });
+});
+
+BENCHMARK("particle/render", {1000, 10000}, [](BenchState &state) {
+  SoftwareCanvas canvas;
+  ParticleSystem particles(BENCH_BURST_SEED);
+  std::mt19937 rng(3);
+  makeParticles(particles, state.size(), rng);
+  state.setItems(state.size());
+
+  state.run([&] { particles.render(canvas.getRenderer(), BENCH_VIEW); });
+});
+
+// The old createExplosion: fresh random angle, speed, lifetime and size,
+// with cos/sin, per particle
+BENCHMARK("particle/burst-random", {10, 50}, [](BenchState &state) {
+  ParticleSystem particles(BENCH_BURST_SEED);
+  std::mt19937 rng(3);
+  std::uniform_real_distribution<float> unit(0.0f, 1.0f);
+  state.setItems(BURSTS * state.size());
+
+  state.run([&] { particles.clear(); },
+            [&] {
+              for (int b = 0; b < BURSTS; b++) {
+                for (size_t i = 0; i < state.size(); i++) {
+                  float angle = unit(rng) * 2.0f * 3.14159f;
+                  float speed = 50 + unit(rng) * 150;
+                  float lifetime = 0.3f + unit(rng) * 0.5f;
+                  float size = 2 + unit(rng) * 4;
+                  particles.add(400, 300, std::cos(angle) * speed,
+                                std::sin(angle) * speed, lifetime, size,
+                                {255, 150, 50, 255});
+                }
+              }
+              doNotOptimize(particles.size());
+            });
+});
+
+// Template copy: one rotation and speed scale per burst
+BENCHMARK("particle/burst-template", {10, 50}, [](BenchState &state) {
+  ParticleSystem particles(BENCH_BURST_SEED);
+  std::mt19937 rng(3);
+  std::uniform_real_distribution<float> unit(0.0f, 1.0f);
+  state.setItems(BURSTS * state.size());
+
+  state.run([&] { particles.clear(); },
+            [&] {
+              for (int b = 0; b < BURSTS; b++) {
+                particles.spawnBurst(
+                    400, 300, static_cast<int>(state.size()),
+                    {255, 150, 50, 255},
+                    static_cast<int>(rng() % BurstLibrary::TEMPLATE_COUNT),
+                    unit(rng) * 2.0f * 3.14159f, 0.9f + unit(rng) * 0.2f);
+              }
+              doNotOptimize(particles.size());
+            });
+});
+
+} // namespace
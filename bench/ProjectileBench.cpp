@@ -0,0 +1,93 @@
+// Projectile engine throughput at bullet-hell scale.
+//
+// Keeps a fixed number of enemy projectiles alive and times one simulation
+// tick (clock advance + expiry sweep + collision against the player box),
+// next to the same workload on per-bullet Bullet entities.
+
+#include "Bench.h"
+#include "Fixtures.h"
+#include "ProjectileSystem.h"
+#include <algorithm>
+
+namespace {
+
+void topUpEngine(ProjectileSystem &engine, size_t target, std::mt19937 &rng) {
+  std::uniform_real_distribution<float> xs(0, BENCH_SCREEN_W);
+  std::uniform_real_distribution<float> ys(0, BENCH_SCREEN_H / 2);
+  std::uniform_real_distribution<float> speed(40, 120);
+  std::uniform_int_distribution<int> pattern(0, 3);
+
+  while (engine.size() < target) {
+    float x = xs(rng);
+    float y = ys(rng);
+    switch (pattern(rng)) {
+    case 0:
+      engine.emitStraight(x, y, 0, speed(rng));
+      break;
+    case 1:
+      engine.emitSpread(x, y, 0, speed(rng), 3, 50.0f, 15.0f);
+      break;
+    case 2:
+      engine.emitSpiral(x, y, 4, speed(rng), 1.5f, x);
+      break;
+    default:
+      engine.emitAimed(x, y, BENCH_SCREEN_W / 2.0f, BENCH_SCREEN_H - 80.0f,
+                       speed(rng));
+      break;
+    }
+  }
+}
+
+void topUpEntities(std::vector<std::unique_ptr<Bullet>> &bullets,
+                   size_t target, std::mt19937 &rng) {
+  std::uniform_real_distribution<float> xs(0, BENCH_SCREEN_W);
+  std::uniform_real_distribution<float> ys(0, BENCH_SCREEN_H / 2);
+  std::uniform_real_distribution<float> speed(40, 120);
+
+  while (bullets.size() < target) {
+    bullets.push_back(
+        std::make_unique<Bullet>(xs(rng), ys(rng), 0, speed(rng), false));
+  }
+}
+
+BENCHMARK("projectiles/engine", {10000, 50000}, [](BenchState &state) {
+  std::mt19937 rng(1234);
+  ProjectileSystem engine(BENCH_SCREEN_W, BENCH_SCREEN_H,
+                          SDL_Color{255, 100, 100, 255});
+  SDL_Rect player = {BENCH_SCREEN_W / 2 - 20, BENCH_SCREEN_H - 105, 40, 50};
+  topUpEngine(engine, state.size(), rng);
+  state.setItems(state.size());
+
+  // Refill untimed so every tick sees the same live count
+  state.run([&] { topUpEngine(engine, state.size(), rng); },
+            [&] {
+              engine.update(BENCH_DT);
+              doNotOptimize(engine.collide(player));
+            });
+});
+
+BENCHMARK("projectiles/bulletEntities", {10000, 50000}, [](BenchState &state) {
+  std::mt19937 rng(1234);
+  std::vector<std::unique_ptr<Bullet>> bullets;
+  Entity player(BENCH_SCREEN_W / 2.0f, BENCH_SCREEN_H - 80.0f, 40, 50);
+  topUpEntities(bullets, state.size(), rng);
+  state.setItems(state.size());
+
+  state.run([&] { topUpEntities(bullets, state.size(), rng); },
+            [&] {
+              for (auto &bullet : bullets) {
+                bullet->update(BENCH_DT);
+                // Off-screen check as Game does it for player bullets
+                if (bullet->collidesWith(player) ||
+                    bullet->getY() > BENCH_SCREEN_H + 100.0f) {
+                  bullet->setActive(false);
+                }
+              }
+              bullets.erase(
+                  std::remove_if(bullets.begin(), bullets.end(),
+                                 [](const auto &b) { return !b->isActive(); }),
+                  bullets.end());
+            });
+});
+
+} // namespace
@@ -0,0 +1,58 @@
+// Starfield cost per frame; size is the number of frames per repetition,
+// except for starfield/procedural where it is the star density.
+
+#include "Bench.h"
+#include "Fixtures.h"
+#include "Starfield.h"
+
+namespace {
+
+StarfieldConfig classicConfig() {
+  StarfieldConfig config;
+  config.mode = StarfieldMode::Classic;
+  return config;
+}
+
+BENCHMARK("starfield/update", {60}, [](BenchState &state) {
+  Starfield starfield(BENCH_SCREEN_W, BENCH_SCREEN_H, classicConfig());
+  state.setItems(state.size());
+
+  state.run([&] {
+    for (size_t i = 0; i < state.size(); i++) {
+      starfield.update(BENCH_DT);
+    }
+  });
+});
+
+BENCHMARK("starfield/render", {60}, [](BenchState &state) {
+  SoftwareCanvas canvas;
+  Starfield starfield(BENCH_SCREEN_W, BENCH_SCREEN_H, classicConfig());
+  state.setItems(state.size());
+
+  state.run([&] {
+    for (size_t i = 0; i < state.size(); i++) {
+      starfield.render(canvas.getRenderer());
+    }
+  });
+});
+
+// 60 frames of update + render per repetition, with the camera drifting
+// sideways; cost should follow the density, memory stays the same
+BENCHMARK("starfield/procedural", {1, 4, 16}, [](BenchState &state) {
+  SoftwareCanvas canvas;
+  StarfieldConfig config;
+  config.density = static_cast<float>(state.size());
+  Starfield starfield(BENCH_SCREEN_W, BENCH_SCREEN_H, config);
+  const size_t frames = 60;
+  state.setItems(frames);
+
+  state.run([&] {
+    for (size_t i = 0; i < frames; i++) {
+      starfield.update(BENCH_DT);
+      starfield.scroll(2.0f, 0.0f);
+      starfield.render(canvas.getRenderer());
+    }
+  });
+});
+
+} // namespace
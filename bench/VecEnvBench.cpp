@@ -0,0 +1,79 @@
+// Vectorized environment stepping; size is the number of envs, items are
+// env steps (one frame each).
+
+#include "Bench.h"
+#include "VecEnv.h"
+#include <algorithm>
+#include <random>
+#include <thread>
+#include <vector>
+
+namespace {
+
+struct EnvFixture {
+  explicit EnvFixture(const VecEnvConfig &config)
+      : env(config), observations(env.getEnvCount() * env.observationSize()),
+        frames(env.getEnvCount() * env.frameSize()),
+        rewards(env.getEnvCount()), dones(env.getEnvCount()),
+        actions(env.getEnvCount()) {
+    buffers.observations = observations.data();
+    buffers.frames = frames.empty() ? nullptr : frames.data();
+    buffers.rewards = rewards.data();
+    buffers.dones = dones.data();
+    env.reset(buffers);
+
+    // Random policy; warm up past the first enemy spawns
+    std::mt19937 rng(7);
+    for (auto &action : actions) {
+      action = static_cast<uint8_t>(rng() & 31);
+    }
+    for (int i = 0; i < 120; i++) {
+      step();
+    }
+  }
+
+  void step() {
+    env.step(actions.data(), buffers);
+    doNotOptimize(rewards[0]);
+  }
+
+  VecEnv env;
+  std::vector<float> observations;
+  std::vector<uint8_t> frames;
+  std::vector<float> rewards;
+  std::vector<uint8_t> dones;
+  std::vector<uint8_t> actions;
+  VecEnvBuffers buffers;
+};
+
+VecEnvConfig benchConfig(size_t envs) {
+  VecEnvConfig config;
+  config.envCount = static_cast<int>(envs);
+  return config;
+}
+
+BENCHMARK("vecenv/step", {1, 16, 64}, [](BenchState &state) {
+  EnvFixture fixture(benchConfig(state.size()));
+  state.setItems(state.size());
+  state.run([&] { fixture.step(); });
+});
+
+BENCHMARK("vecenv/step-raster", {16, 64}, [](BenchState &state) {
+  VecEnvConfig config = benchConfig(state.size());
+  config.rasterWidth = 80;
+  config.rasterHeight = 60;
+  EnvFixture fixture(config);
+  state.setItems(state.size());
+  state.run([&] { fixture.step(); });
+});
+
+BENCHMARK("vecenv/step-threaded", {64, 256}, [](BenchState &state) {
+  VecEnvConfig config = benchConfig(state.size());
+  config.threads =
+      static_cast<int>(std::max(1u, std::thread::hardware_concurrency()));
+  EnvFixture fixture(config);
+  state.setItems(state.size());
+  state.run([&] { fixture.step(); });
+});
+
+} // namespace
@@ -1,31 +1,313 @@
 #include "Game.h"
+#include "AllocTracker.h"
+#include "IdleScheduler.h"
+#include "Log.h"
+#include "Scenario.h"
+#include "Starfield.h"
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
 #include <iostream>
+#include <random>
+
+namespace {
+
+void printUsage(const char *program) {
+  std::cout << "Usage: " << program << " [options]" << std::endl;
+  std::cout << "  --scenario NAME   Run a stress scenario and print frame "
+               "times:"
+            << std::endl;
+  std::cout << "                    enemies, bomber-storm, explosion-flood, "
+               "bullet-curtain,"
+            << std::endl;
+  std::cout << "                    dormant-world" << std::endl;
+  std::cout << "  --type TYPE       Enemy type for 'enemies': drifter, hunter, "
+               "bomber"
+            << std::endl;
+  std::cout << "  --count N         Enemies / explosions per frame / emitters "
+               "/ dormant enemies"
+            << std::endl;
+  std::cout << "  --seed N          Random seed (default 1)" << std::endl;
+  std::cout << "  --duration SECS   Simulated run length (default 10)"
+            << std::endl;
+  std::cout << "  --stats PATH      Export live counters to PATH (read with "
+               "tools/stats_reader)"
+            << std::endl;
+  std::cout << "  --capture PATH    Record every draw call to PATH (replay "
+               "with tools/draw_replay)"
+            << std::endl;
+  std::cout << "  --record PATH     Record frames to a .y4m file or a PNG "
+               "directory"
+            << std::endl;
+  std::cout << "  --record-every N  Record one frame in N (default 1)"
+            << std::endl;
+  std::cout << "  --world WxH       World size in pixels (default 3200x2400)"
+            << std::endl;
+  std::cout << "  --starfield MODE  procedural (default) or classic"
+            << std::endl;
+  std::cout << "  --star-density X  Procedural star count multiplier "
+               "(default 1)"
+            << std::endl;
+  std::cout << "  --star-seed N     Procedural sky seed (default: scenario "
+               "seed or random)"
+            << std::endl;
+  std::cout << "  --no-audio        Don't open an audio device" << std::endl;
+  std::cout << "  --late-input      Sample input just before the vblank"
+            << std::endl;
+  std::cout << "  --no-idle         Run menus and pause at full frame rate"
+            << std::endl;
+  std::cout << "  --idle-fps N      Frame rate outside gameplay (default 10)"
+            << std::endl;
+  std::cout << "  --report          Print CPU use and render scale on exit"
+            << std::endl;
+  std::cout << "  --dynamic-res MIN:MAX" << std::endl;
+  std::cout << "                    World render scale range under load "
+               "(default 0.5:1, off for scenarios)"
+            << std::endl;
+  std::cout << "  --no-dynamic-res  Always render the world at full resolution"
+            << std::endl;
+  std::cout << "  --log SPEC        Log levels, e.g. warn or info,scores=debug"
+            << std::endl;
+  std::cout << "  --assert-zero-alloc SECS" << std::endl;
+  std::cout << "                    Fail on any allocation after SECS of play "
+               "(ALLOC_TRACK=1 builds)"
+            << std::endl;
+}
+
+// Everything the command line sets, with the defaults of a plain run
+struct Options {
+  bool useScenario = false;
+  ScenarioConfig scenario;
+  float allocWarmup = -1.0f; // Negative: no zero-allocation assert
+  const char *statsPath = nullptr;
+  const char *capturePath = nullptr;
+  const char *recordPath = nullptr;
+  int recordEvery = 1;
+  bool audio = true;
+  bool lateInput = false;
+  bool idle = true;
+  int idleFps = IdleScheduler::DEFAULT_IDLE_FPS;
+  bool report = false; // Exit reports outside scenarios
+  float worldWidth = 0; // 0: the game's default world
+  float worldHeight = 0;
+  int dynamicRes = -1; // Unset: on for play, off for scenarios
+  float minScale = 0.5f;
+  float maxScale = 1.0f;
+  StarfieldConfig stars;
+  bool starSeed = false; // stars.seed came from --star-seed
+};
+
+// Options followed by a value
+const char *const VALUE_OPTIONS[] = {
+    "--scenario",      "--type",         "--count",        "--seed",
+    "--duration",      "--log",          "--world",        "--dynamic-res",
+    "--starfield",     "--star-density", "--star-seed",    "--idle-fps",
+    "--stats",         "--capture",      "--record",       "--record-every",
+    "--assert-zero-alloc"};
+
+bool takesValue(const char *arg) {
+  for (const char *option : VALUE_OPTIONS) {
+    if (std::strcmp(arg, option) == 0)
+      return true;
+  }
+  return false;
+}
+
+// Fills options in place; returns false on a malformed command line
+bool parseArgs(int argc, char *argv[], Options &options) {
+  for (int i = 1; i < argc; i++) {
+    const char *arg = argv[i];
+    const char *value = i + 1 < argc ? argv[i + 1] : nullptr;
+
+    if (std::strcmp(arg, "--help") == 0 || std::strcmp(arg, "-h") == 0) {
+      return false;
+    }
+    if (std::strcmp(arg, "--no-audio") == 0) {
+      options.audio = false;
+      continue;
+    }
+    if (std::strcmp(arg, "--late-input") == 0) {
+      options.lateInput = true;
+      continue;
+    }
+    if (std::strcmp(arg, "--no-idle") == 0) {
+      options.idle = false;
+      continue;
+    }
+    if (std::strcmp(arg, "--no-dynamic-res") == 0) {
+      options.dynamicRes = 0;
+      continue;
+    }
+    if (std::strcmp(arg, "--report") == 0) {
+      options.report = true;
+      continue;
+    }
+    if (!takesValue(arg)) {
+      std::cerr << "Unknown option: " << arg << std::endl;
+      return false;
+    }
+    if (!value) {
+      std::cerr << "Missing value for " << arg << std::endl;
+      return false;
+    }
+
+    if (std::strcmp(arg, "--scenario") == 0) {
+      if (!Scenario::parseKind(value, options.scenario.kind)) {
+        std::cerr << "Unknown scenario: " << value << std::endl;
+        return false;
+      }
+      options.useScenario = true;
+    } else if (std::strcmp(arg, "--type") == 0) {
+      if (!Scenario::parseEnemyType(value, options.scenario.enemyType)) {
+        std::cerr << "Unknown enemy type: " << value << std::endl;
+        return false;
+      }
+    } else if (std::strcmp(arg, "--count") == 0) {
+      options.scenario.count = std::atoi(value);
+    } else if (std::strcmp(arg, "--seed") == 0) {
+      options.scenario.seed =
+          static_cast<unsigned>(std::strtoul(value, nullptr, 10));
+    } else if (std::strcmp(arg, "--duration") == 0) {
+      options.scenario.duration = static_cast<float>(std::atof(value));
+    } else if (std::strcmp(arg, "--log") == 0) {
+      if (!Log::configure(value)) {
+        std::cerr << "Bad log spec: " << value << std::endl;
+        return false;
+      }
+    } else if (std::strcmp(arg, "--world") == 0) {
+      if (std::sscanf(value, "%fx%f", &options.worldWidth,
+                      &options.worldHeight) != 2) {
+        std::cerr << "Bad world size: " << value << std::endl;
+        return false;
+      }
+    } else if (std::strcmp(arg, "--dynamic-res") == 0) {
+      if (std::sscanf(value, "%f:%f", &options.minScale,
+                      &options.maxScale) != 2 ||
+          options.minScale <= 0 || options.minScale > options.maxScale ||
+          options.maxScale > 1) {
+        std::cerr << "Bad scale range: " << value << std::endl;
+        return false;
+      }
+      options.dynamicRes = 1;
+    } else if (std::strcmp(arg, "--starfield") == 0) {
+      if (std::strcmp(value, "procedural") == 0) {
+        options.stars.mode = StarfieldMode::Procedural;
+      } else if (std::strcmp(value, "classic") == 0) {
+        options.stars.mode = StarfieldMode::Classic;
+      } else {
+        std::cerr << "Unknown starfield: " << value << std::endl;
+        return false;
+      }
+    } else if (std::strcmp(arg, "--star-density") == 0) {
+      options.stars.density = static_cast<float>(std::atof(value));
+      if (options.stars.density <= 0) {
+        std::cerr << "Bad star density: " << value << std::endl;
+        return false;
+      }
+    } else if (std::strcmp(arg, "--star-seed") == 0) {
+      options.stars.seed =
+          static_cast<uint32_t>(std::strtoul(value, nullptr, 10));
+      options.starSeed = true;
+    } else if (std::strcmp(arg, "--idle-fps") == 0) {
+      options.idleFps = std::atoi(value);
+    } else if (std::strcmp(arg, "--stats") == 0) {
+      options.statsPath = value;
+    } else if (std::strcmp(arg, "--capture") == 0) {
+      options.capturePath = value;
+    } else if (std::strcmp(arg, "--record") == 0) {
+      options.recordPath = value;
+    } else if (std::strcmp(arg, "--record-every") == 0) {
+      options.recordEvery = std::atoi(value);
+      if (options.recordEvery < 1) {
+        std::cerr << "Bad record interval: " << value << std::endl;
+        return false;
+      }
+    } else if (std::strcmp(arg, "--assert-zero-alloc") == 0) {
+      if (!AllocTracker::isEnabled()) {
+        std::cerr << "--assert-zero-alloc needs a build with ALLOC_TRACK=1"
+                  << std::endl;
+        return false;
+      }
+      options.allocWarmup = static_cast<float>(std::atof(value));
+    } else {
+      std::cerr << "Unknown option: " << arg << std::endl;
+      return false;
+    }
+    i++;
+  }
+  return true;
+}
+
+} // namespace
 
 int main(int argc, char *argv[]) {
-  (void)argc;
-  (void)argv;
+  Options options;
+  if (!parseArgs(argc, argv, options)) {
+    printUsage(argv[0]);
+    return 1;
+  }
+
+  // Everything from here on logs through the background writer; it is
+  // flushed at exit and on a crash
+  Log::start();
 
-  std::cout << "=== Stellar Fury ===" << std::endl;
-  std::cout << "A 2D Space Shooter" << std::endl;
-  std::cout << std::endl;
+  LOG_INFO("main", "=== Stellar Fury ===");
+  LOG_INFO("main", "A 2D Space Shooter");
 
   Game game;
+  if (options.statsPath && !game.openStatsFile(options.statsPath)) {
+    return 1;
+  }
+  if (options.capturePath) {
+    game.setDrawCapture(options.capturePath);
+  }
+  if (options.recordPath) {
+    game.setFrameRecording(options.recordPath, options.recordEvery);
+  }
+  if (options.useScenario) {
+    game.setScenario(options.scenario);
+  }
+  if (options.allocWarmup >= 0) {
+    game.setZeroAllocAssert(options.allocWarmup);
+  }
+  game.setAudioEnabled(options.audio);
+  game.setLateInput(options.lateInput);
+  game.setIdle(options.idle, options.idleFps);
+  game.setExitReport(options.report);
+  // Scenarios get the same sky for the same seed
+  if (!options.starSeed) {
+    options.stars.seed =
+        options.useScenario ? options.scenario.seed : std::random_device()();
+  }
+  game.setStarfield(options.stars);
+  // Scenarios measure full-resolution cost unless asked
+  game.setDynamicResolution(options.dynamicRes < 0 ? !options.useScenario
+                                                   : options.dynamicRes == 1,
+                            options.minScale, options.maxScale);
+  if (options.worldWidth > 0 && options.worldHeight > 0) {
+    game.setWorldSize(options.worldWidth, options.worldHeight);
+  }
 
   if (!game.init()) {
-    std::cerr << "Failed to initialize game!" << std::endl;
+    LOG_ERROR("main", "Failed to initialize game!");
     return 1;
   }
 
-  std::cout << "Controls:" << std::endl;
-  std::cout << "  WASD/Arrows - Move" << std::endl;
-  std::cout << "  Space       - Shoot" << std::endl;
-  std::cout << "  ESC         - Pause/Quit" << std::endl;
-  std::cout << "  Enter       - Start/Restart" << std::endl;
-  std::cout << std::endl;
+  if (!options.useScenario) {
+    LOG_INFO("main", "Controls:");
+    LOG_INFO("main", "  WASD/Arrows - Move");
+    LOG_INFO("main", "  Space       - Shoot");
+    LOG_INFO("main", "  ESC         - Pause/Quit");
+    LOG_INFO("main", "  Enter       - Start/Restart");
+  }
 
   game.run();
 
-  std::cout << "Thanks for playing!" << std::endl;
+  if (game.hasFailed()) {
+    return 1;
+  }
+
+  LOG_INFO("main", "Thanks for playing!");
 
   return 0;
 }
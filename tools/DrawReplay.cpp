@@ -0,0 +1,319 @@
+// Replays a draw capture written by `stellar_fury --capture PATH` as fast as
+// the renderer allows, to profile rendering apart from the game.
+//
+//   draw_replay PATH                   replay once with the default renderer
+//   draw_replay PATH --driver NAME     force a backend (software, opengl, ...)
+//   draw_replay PATH --loops N         replay the whole capture N times
+//   draw_replay PATH --show            show the window (hidden by default)
+//
+// Prints per-frame submit/flush/present times and a table per call type.
+// Textures are replaced by gray placeholders of the captured sizes, with
+// the captured blend mode and color/alpha mod. VSync is off, so present
+// measures the backend's work rather than the display.
+
+#include "DrawCapture.h"
+#include "Percentile.h"
+#include <SDL2/SDL.h>
+#include <algorithm>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <map>
+#include <utility>
+#include <vector>
+
+namespace {
+
+struct OpStats {
+  uint64_t calls = 0;
+  uint64_t primitives = 0;
+  uint64_t ticks = 0;
+};
+
+struct FrameTiming {
+  double submitMs;
+  double flushMs;
+  double presentMs;
+};
+
+class Replayer {
+public:
+  Replayer(SDL_Renderer *renderer, const DrawCapture &capture)
+      : renderer(renderer), capture(capture) {}
+
+  ~Replayer() {
+    for (auto &entry : textures) {
+      SDL_DestroyTexture(entry.second);
+    }
+  }
+
+  // Issues one frame's commands from index `at`; returns the index after
+  // its Present, which is left to the caller to time
+  size_t submitFrame(size_t at, OpStats *stats) {
+    while (at < capture.commands.size()) {
+      const DrawCommand &command = capture.commands[at++];
+      if (command.op == DrawOp::Present)
+        break;
+
+      // Set outside the timing: the game doesn't set texture state per draw
+      if (command.op == DrawOp::Copy || command.op == DrawOp::Geometry)
+        bind(command.texture);
+
+      Uint64 start = SDL_GetPerformanceCounter();
+      uint32_t primitives = issue(command);
+      OpStats &op = stats[static_cast<int>(command.op)];
+      op.ticks += SDL_GetPerformanceCounter() - start;
+      op.calls++;
+      op.primitives += primitives;
+    }
+    return at;
+  }
+
+private:
+  void bind(const CaptureTexture &state) {
+    bound = texture(state.width, state.height);
+    if (!bound)
+      return;
+    // As the game does, fall back to plain blending where a custom mode
+    // isn't supported
+    if (SDL_SetTextureBlendMode(bound, state.blendMode) != 0)
+      SDL_SetTextureBlendMode(bound, SDL_BLENDMODE_BLEND);
+    SDL_SetTextureColorMod(bound, state.mod.r, state.mod.g, state.mod.b);
+    SDL_SetTextureAlphaMod(bound, state.mod.a);
+  }
+
+  // Returns the primitives the call drew
+  uint32_t issue(const DrawCommand &command) {
+    // Geometry's range is into the vertices instead
+    const SDL_Rect *rects = command.op == DrawOp::Geometry
+                                ? nullptr
+                                : capture.rects.data() + command.first;
+    switch (command.op) {
+    case DrawOp::SetColor:
+      SDL_SetRenderDrawColor(renderer, command.value & 0xff,
+                             (command.value >> 8) & 0xff,
+                             (command.value >> 16) & 0xff,
+                             (command.value >> 24) & 0xff);
+      return 0;
+    case DrawOp::SetBlendMode:
+      SDL_SetRenderDrawBlendMode(renderer,
+                                 static_cast<SDL_BlendMode>(command.value));
+      return 0;
+    case DrawOp::Clear:
+      SDL_RenderClear(renderer);
+      return 1;
+    case DrawOp::FillRect:
+      SDL_RenderFillRect(renderer, rects);
+      return 1;
+    case DrawOp::FillTarget:
+      SDL_RenderFillRect(renderer, nullptr);
+      return 1;
+    case DrawOp::FillRects:
+      SDL_RenderFillRects(renderer, rects, static_cast<int>(command.count));
+      return command.count;
+    case DrawOp::DrawRect:
+      SDL_RenderDrawRect(renderer, rects);
+      return 1;
+    case DrawOp::DrawTarget:
+      SDL_RenderDrawRect(renderer, nullptr);
+      return 1;
+    case DrawOp::DrawLine:
+      SDL_RenderDrawLine(renderer, rects->x, rects->y, rects->w, rects->h);
+      return 1;
+    case DrawOp::DrawPoint:
+      SDL_RenderDrawPoint(renderer, rects->x, rects->y);
+      return 1;
+    case DrawOp::Copy: {
+      const SDL_Rect *next = rects;
+      const SDL_Rect *source = (command.flags & 1) ? next++ : nullptr;
+      const SDL_Rect *destination = (command.flags & 2) ? next : nullptr;
+      SDL_RenderCopy(renderer, bound, source, destination);
+      return 1;
+    }
+    case DrawOp::Geometry: {
+      const SDL_Vertex *vertices = capture.vertices.data() + command.first;
+      SDL_RenderGeometry(renderer, bound, vertices,
+                         static_cast<int>(command.count), nullptr, 0);
+      return command.count / 3;
+    }
+    default:
+      return 0;
+    }
+  }
+
+  SDL_Texture *texture(int w, int h) {
+    auto key = std::make_pair(w, h);
+    auto found = textures.find(key);
+    if (found != textures.end())
+      return found->second;
+
+    SDL_Texture *t = SDL_CreateTexture(renderer, SDL_PIXELFORMAT_RGBA8888,
+                                       SDL_TEXTUREACCESS_STATIC,
+                                       std::max(w, 1), std::max(h, 1));
+    if (t) {
+      std::vector<Uint32> pixels(size_t(std::max(w, 1)) * std::max(h, 1),
+                                 0x808080ff);
+      SDL_UpdateTexture(t, nullptr, pixels.data(),
+                        std::max(w, 1) * static_cast<int>(sizeof(Uint32)));
+    }
+    textures[key] = t;
+    return t;
+  }
+
+  SDL_Renderer *renderer;
+  const DrawCapture &capture;
+  std::map<std::pair<int, int>, SDL_Texture *> textures;
+  SDL_Texture *bound = nullptr; // Placeholder for the next Copy/Geometry
+};
+
+void printPhase(const char *name, std::vector<double> values) {
+  std::sort(values.begin(), values.end());
+  double sum = 0;
+  for (double v : values) {
+    sum += v;
+  }
+  std::printf("  %-8s %8.3f %8.3f %8.3f %8.3f %8.3f\n", name,
+              values.empty() ? 0 : sum / values.size(),
+              percentile(values, 0.50), percentile(values, 0.95),
+              percentile(values, 0.99), values.empty() ? 0 : values.back());
+}
+
+void printUsage(const char *program) {
+  std::fprintf(stderr,
+               "Usage: %s PATH [--driver NAME] [--loops N] [--show]\n",
+               program);
+}
+
+} // namespace
+
+int main(int argc, char *argv[]) {
+  if (argc < 2) {
+    printUsage(argv[0]);
+    return 1;
+  }
+
+  const char *path = argv[1];
+  const char *driver = nullptr;
+  int loops = 1;
+  bool show = false;
+  for (int i = 2; i < argc; i++) {
+    if (std::strcmp(argv[i], "--show") == 0) {
+      show = true;
+    } else if (std::strcmp(argv[i], "--driver") == 0 && i + 1 < argc) {
+      driver = argv[++i];
+    } else if (std::strcmp(argv[i], "--loops") == 0 && i + 1 < argc) {
+      loops = std::max(1, std::atoi(argv[++i]));
+    } else {
+      printUsage(argv[0]);
+      return 1;
+    }
+  }
+
+  DrawCapture capture;
+  std::string error;
+  if (!loadDrawCapture(path, capture, error)) {
+    std::fprintf(stderr, "%s: %s\n", path, error.c_str());
+    return 1;
+  }
+  if (capture.frames == 0) {
+    std::fprintf(stderr, "%s: no complete frames\n", path);
+    return 1;
+  }
+
+  if (driver) {
+    SDL_SetHint(SDL_HINT_RENDER_DRIVER, driver);
+  }
+  if (SDL_Init(SDL_INIT_VIDEO) < 0) {
+    std::fprintf(stderr, "SDL_Init failed: %s\n", SDL_GetError());
+    return 1;
+  }
+
+  SDL_Window *window = SDL_CreateWindow(
+      "Stellar Fury replay", SDL_WINDOWPOS_CENTERED, SDL_WINDOWPOS_CENTERED,
+      capture.width, capture.height,
+      show ? SDL_WINDOW_SHOWN : SDL_WINDOW_HIDDEN);
+  SDL_Renderer *renderer =
+      window ? SDL_CreateRenderer(window, -1, 0) : nullptr;
+  if (!renderer) {
+    std::fprintf(stderr, "Renderer failed: %s\n", SDL_GetError());
+    SDL_Quit();
+    return 1;
+  }
+
+  SDL_RendererInfo info;
+  SDL_zero(info);
+  SDL_GetRendererInfo(renderer, &info);
+  std::printf("%s: %dx%d, %zu frames, %zu commands, renderer %s\n", path,
+              capture.width, capture.height, capture.frames,
+              capture.commands.size(), info.name ? info.name : "?");
+
+  std::vector<FrameTiming> frames;
+  frames.reserve(capture.frames * loops);
+  OpStats stats[DRAW_OP_COUNT];
+  double frequency = static_cast<double>(SDL_GetPerformanceFrequency());
+  auto ms = [frequency](Uint64 ticks) { return ticks * 1000.0 / frequency; };
+
+  {
+    Replayer replayer(renderer, capture);
+    Uint64 wallStart = SDL_GetPerformanceCounter();
+    for (int loop = 0; loop < loops; loop++) {
+      size_t at = 0;
+      while (at < capture.commands.size()) {
+        // Keep the window responsive when shown
+        SDL_Event event;
+        while (SDL_PollEvent(&event)) {
+        }
+
+        Uint64 start = SDL_GetPerformanceCounter();
+        at = replayer.submitFrame(at, stats);
+        Uint64 submitted = SDL_GetPerformanceCounter();
+        SDL_RenderFlush(renderer);
+        Uint64 flushed = SDL_GetPerformanceCounter();
+        SDL_RenderPresent(renderer);
+        Uint64 presented = SDL_GetPerformanceCounter();
+
+        frames.push_back({ms(submitted - start), ms(flushed - submitted),
+                          ms(presented - flushed)});
+        OpStats &present = stats[static_cast<int>(DrawOp::Present)];
+        present.calls++;
+        present.ticks += presented - flushed;
+      }
+    }
+    double wallMs = ms(SDL_GetPerformanceCounter() - wallStart);
+    std::printf("%zu frames in %.1f ms: %.1f fps\n\n", frames.size(), wallMs,
+                wallMs > 0 ? frames.size() * 1000.0 / wallMs : 0);
+  }
+
+  std::vector<double> submit, flush, present, total;
+  for (const FrameTiming &f : frames) {
+    submit.push_back(f.submitMs);
+    flush.push_back(f.flushMs);
+    present.push_back(f.presentMs);
+    total.push_back(f.submitMs + f.flushMs + f.presentMs);
+  }
+  std::printf("Frame (ms)     mean      p50      p95      p99      max\n");
+  printPhase("submit", submit);
+  printPhase("flush", flush);
+  printPhase("present", present);
+  printPhase("total", total);
+
+  // Batching backends queue draws and run them in the flush, so their
+  // per-call times are the cost of recording a command, not drawing it
+  std::printf("\nCall            calls   primitives    total ms   ns/call\n");
+  for (int i = 0; i < DRAW_OP_COUNT; i++) {
+    const OpStats &op = stats[i];
+    if (op.calls == 0)
+      continue;
+    double totalMs = ms(op.ticks);
+    std::printf("  %-12s %8llu %12llu %11.3f %9.0f\n",
+                drawOpName(static_cast<DrawOp>(i)),
+                static_cast<unsigned long long>(op.calls),
+                static_cast<unsigned long long>(op.primitives), totalMs,
+                totalMs * 1e6 / op.calls);
+  }
+
+  SDL_DestroyRenderer(renderer);
+  SDL_DestroyWindow(window);
+  SDL_Quit();
+  return 0;
+}
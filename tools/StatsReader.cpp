@@ -0,0 +1,140 @@
+// Reads the live stats file written by `stellar_fury --stats PATH`.
+//
+//   stats_reader PATH              print every counter once
+//   stats_reader PATH --watch MS   redraw the table every MS milliseconds
+//   stats_reader PATH --csv MS     stream one CSV row per MS milliseconds
+//
+// Only depends on the file layout in Telemetry.h.
+
+#include "Telemetry.h"
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <fcntl.h>
+#include <iostream>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <thread>
+#include <unistd.h>
+
+namespace {
+
+void printValue(const TelemetrySlot &slot) {
+  int64_t value = slot.value.load(std::memory_order_relaxed);
+  switch (slot.unit) {
+  case TelemetryUnit::Microseconds:
+    std::printf("%.3f ms", value / 1000.0);
+    break;
+  case TelemetryUnit::Thousandths:
+    std::printf("%.3f", value / 1000.0);
+    break;
+  default:
+    std::printf("%lld", static_cast<long long>(value));
+    break;
+  }
+}
+
+void printTable(const TelemetryLayout &layout) {
+  uint32_t count = layout.header.counterCount.load(std::memory_order_acquire);
+  uint64_t frame = layout.header.frame.load(std::memory_order_acquire);
+
+  std::printf("pid %u  frame %llu\n", layout.header.processId,
+              static_cast<unsigned long long>(frame));
+  for (uint32_t i = 0; i < count; i++) {
+    std::printf("  %-28s ", layout.slots[i].name);
+    printValue(layout.slots[i]);
+    std::printf("\n");
+  }
+  std::fflush(stdout);
+}
+
+void printCsvHeader(const TelemetryLayout &layout) {
+  uint32_t count = layout.header.counterCount.load(std::memory_order_acquire);
+  std::printf("frame");
+  for (uint32_t i = 0; i < count; i++) {
+    std::printf(",%s", layout.slots[i].name);
+  }
+  std::printf("\n");
+}
+
+void printCsvRow(const TelemetryLayout &layout) {
+  uint32_t count = layout.header.counterCount.load(std::memory_order_acquire);
+  std::printf("%llu", static_cast<unsigned long long>(
+                          layout.header.frame.load(std::memory_order_acquire)));
+  for (uint32_t i = 0; i < count; i++) {
+    std::printf(",%lld", static_cast<long long>(layout.slots[i].value.load(
+                             std::memory_order_relaxed)));
+  }
+  std::printf("\n");
+  std::fflush(stdout);
+}
+
+} // namespace
+
+int main(int argc, char *argv[]) {
+  if (argc < 2) {
+    std::cerr << "Usage: " << argv[0] << " PATH [--watch MS | --csv MS]"
+              << std::endl;
+    return 1;
+  }
+
+  const char *path = argv[1];
+  bool watch = argc > 3 && std::strcmp(argv[2], "--watch") == 0;
+  bool csv = argc > 3 && std::strcmp(argv[2], "--csv") == 0;
+  int intervalMs = (watch || csv) ? std::atoi(argv[3]) : 0;
+  if (intervalMs <= 0)
+    intervalMs = 500;
+
+  int fd = open(path, O_RDONLY);
+  if (fd < 0) {
+    std::cerr << "Could not open " << path << std::endl;
+    return 1;
+  }
+  // Reading past the end of a short file is SIGBUS, not an error
+  struct stat info;
+  if (fstat(fd, &info) != 0 ||
+      info.st_size < static_cast<off_t>(sizeof(TelemetryLayout))) {
+    close(fd);
+    std::cerr << path << " is not a stats file (or a different version)"
+              << std::endl;
+    return 1;
+  }
+  void *memory =
+      mmap(nullptr, sizeof(TelemetryLayout), PROT_READ, MAP_SHARED, fd, 0);
+  close(fd);
+  if (memory == MAP_FAILED) {
+    std::cerr << "Could not map " << path << std::endl;
+    return 1;
+  }
+
+  const TelemetryLayout &layout =
+      *static_cast<const TelemetryLayout *>(memory);
+  if (std::memcmp(layout.header.magic, TelemetryHeader::MAGIC,
+                  sizeof(layout.header.magic)) != 0 ||
+      layout.header.version.load(std::memory_order_acquire) !=
+          TelemetryHeader::VERSION ||
+      layout.header.slotSize != sizeof(TelemetrySlot)) {
+    std::cerr << path << " is not a stats file (or a different version)"
+              << std::endl;
+    return 1;
+  }
+
+  if (!watch && !csv) {
+    printTable(layout);
+    return 0;
+  }
+
+  if (csv)
+    printCsvHeader(layout);
+
+  while (true) {
+    if (watch) {
+      std::printf("\033[2J\033[H"); // Clear the terminal
+      printTable(layout);
+    } else {
+      printCsvRow(layout);
+    }
+    std::this_thread::sleep_for(std::chrono::milliseconds(intervalMs));
+  }
+}